@@ -0,0 +1,85 @@
+/**
+ * @file bench_cardume.c
+ * @brief Benchmark dos cardumes: peixes x tempo por passo, em série e
+ * dividido entre threads, com a câmera cobrindo uma tela do mapa.
+ * @copyright Copyright (c) 2025
+ */
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "raylib/raylib.h"
+
+#include "cardume.h"
+#include "mundo.h"
+#include "plataforma.h"
+#include "tarefas.h"
+
+#define PASSOS 120
+#define ORCAMENTO_MS ( 1000.0 / 60.0 )
+
+static double medir( Cardume *cardume, PoolTarefas *pool ) {
+    Rectangle visivel = { 1200, 600, 800, 600 };
+    double t0 = PlataformaTempo();
+    for ( int p = 0; p < PASSOS; p++ ) {
+        CardumeAtualizar( cardume, 1.0f / 60.0f, visivel, pool );
+    }
+    return ( PlataformaTempo() - t0 ) * 1000.0 / PASSOS;
+}
+
+static void preparar( Cardume *cardume, int quantidade ) {
+    CardumeCriar( cardume, quantidade, MUNDO_WIDTH, MUNDO_HEIGHT );
+    CardumeEspalhar( cardume, quantidade, 99 );
+    CardumeLimparPoluicao( cardume );
+    srand( 7 );
+    for ( int i = 0; i < 24; i++ ) {
+        Vector2 pos = { (float)( rand() % MUNDO_WIDTH ), (float)( rand() % MUNDO_HEIGHT ) };
+        CardumeAdicionarPoluicao( cardume, pos, 1.0f );
+    }
+}
+
+int main( void ) {
+
+    const int quantidades[] = { 1000, 5000, 20000 };
+    const int numQuantidades = sizeof(quantidades) / sizeof(quantidades[0]);
+    int nucleos = PlataformaNucleos();
+
+    printf( "%8s %8s %14s %10s %10s\n", "peixes", "threads", "ms por passo", "ganho", "60 FPS" );
+
+    for ( int q = 0; q < numQuantidades; q++ ) {
+
+        int n = quantidades[q];
+        Cardume serie;
+        preparar( &serie, n );
+        double msSerie = medir( &serie, NULL );
+        printf( "%8d %8d %14.3f %10s %10s\n", n, 1, msSerie, "-",
+                msSerie < ORCAMENTO_MS ? "ok" : "estoura" );
+
+        for ( int threads = 2; threads <= nucleos; threads *= 2 ) {
+
+            PoolTarefas *pool = PoolTarefasCriar( threads - 1 );
+            Cardume paralelo;
+            preparar( &paralelo, n );
+            double ms = medir( &paralelo, pool );
+
+            // cada peixe só lê o estado do passo anterior: mesmo resultado
+            for ( int i = 0; i < n; i++ ) {
+                if ( paralelo.x[i] != serie.x[i] || paralelo.y[i] != serie.y[i] ) {
+                    printf( "ERRO: peixe %d diverge entre serie e paralelo\n", i );
+                    return 1;
+                }
+            }
+
+            printf( "%8d %8d %14.3f %9.2fx %10s\n", n, threads, ms, msSerie / ms,
+                    ms < ORCAMENTO_MS ? "ok" : "estoura" );
+            CardumeDestruir( &paralelo );
+            PoolTarefasDestruir( pool );
+
+        }
+
+        CardumeDestruir( &serie );
+
+    }
+
+    return 0;
+
+}
@@ -0,0 +1,97 @@
+/**
+ * @file bench_colisao.c
+ * @brief Benchmark do kernel de colisão em lote contra o caminho escalar da
+ * raylib (CheckCollisionRecs em um array de Rectangle).
+ * @copyright Copyright (c) 2025
+ */
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "raylib/raylib.h"
+
+#include "colisao.h"
+#include "mundo.h"
+#include "plataforma.h"
+
+#define TEMPO_MINIMO 0.2 // segundos medidos por caso
+
+static float aleatorio( float maximo ) {
+    return (float)rand() / (float)RAND_MAX * maximo;
+}
+
+int main( void ) {
+
+    const int quantidades[] = { 4, 64, 1024, 16384, 100000 };
+    const int numQuantidades = sizeof(quantidades) / sizeof(quantidades[0]);
+
+    srand( 42 );
+    printf( "kernel: %s\n", ColisaoCaminhoSimd() );
+    printf( "%8s %16s %16s %16s %9s\n", "itens", "raylib (ns/item)", "mascara (ns/item)", "indices (ns/item)", "acertos" );
+
+    for ( int q = 0; q < numQuantidades; q++ ) {
+
+        int n = quantidades[q];
+        Rectangle *recs = (Rectangle*)malloc( sizeof(Rectangle) * n );
+        int *indices = (int*)malloc( sizeof(int) * n );
+        unsigned int *mascara = (unsigned int*)malloc( sizeof(unsigned int) * ( ( n + 31 ) / 32 ) );
+        LoteAABB lote;
+        LoteAABBCriar( &lote, n );
+
+        for ( int i = 0; i < n; i++ ) {
+            recs[i] = (Rectangle){ aleatorio( MUNDO_WIDTH ), aleatorio( MUNDO_HEIGHT ), 30, 35 };
+            LoteAABBDefinir( &lote, i, recs[i] );
+        }
+
+        // retângulo do tamanho de uma tela: pega uma fração dos itens
+        Rectangle consulta = { MUNDO_WIDTH / 3.0f, MUNDO_HEIGHT / 3.0f, 800, 600 };
+        volatile int acertosEscalar = 0;
+        volatile int acertosIndices = 0;
+        long repeticoes;
+        double t0;
+        double tempos[3];
+
+        repeticoes = 0;
+        t0 = PlataformaTempo();
+        do {
+            int acertos = 0;
+            for ( int i = 0; i < n; i++ ) {
+                acertos += CheckCollisionRecs( consulta, recs[i] );
+            }
+            acertosEscalar = acertos;
+            repeticoes++;
+        } while ( PlataformaTempo() - t0 < TEMPO_MINIMO );
+        tempos[0] = ( PlataformaTempo() - t0 ) * 1e9 / ( (double)repeticoes * n );
+
+        repeticoes = 0;
+        t0 = PlataformaTempo();
+        do {
+            ColisaoLoteMascara( consulta, &lote, mascara );
+            repeticoes++;
+        } while ( PlataformaTempo() - t0 < TEMPO_MINIMO );
+        tempos[1] = ( PlataformaTempo() - t0 ) * 1e9 / ( (double)repeticoes * n );
+
+        repeticoes = 0;
+        t0 = PlataformaTempo();
+        do {
+            acertosIndices = ColisaoLoteIndices( consulta, &lote, indices, n );
+            repeticoes++;
+        } while ( PlataformaTempo() - t0 < TEMPO_MINIMO );
+        tempos[2] = ( PlataformaTempo() - t0 ) * 1e9 / ( (double)repeticoes * n );
+
+        if ( acertosEscalar != acertosIndices ) {
+            printf( "ERRO: raylib encontrou %d colisoes e o lote %d\n", acertosEscalar, acertosIndices );
+            return 1;
+        }
+
+        printf( "%8d %16.3f %16.3f %16.3f %9d\n", n, tempos[0], tempos[1], tempos[2], acertosIndices );
+
+        LoteAABBDestruir( &lote );
+        free( mascara );
+        free( indices );
+        free( recs );
+
+    }
+
+    return 0;
+
+}
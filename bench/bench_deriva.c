@@ -0,0 +1,83 @@
+/**
+ * @file bench_deriva.c
+ * @brief Benchmark da deriva do lixo: itens x tempo por passo, em série e
+ * dividido entre threads.
+ * @copyright Copyright (c) 2025
+ */
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "raylib/raylib.h"
+
+#include "correntes.h"
+#include "mundo.h"
+#include "plataforma.h"
+#include "tarefas.h"
+
+#define PASSOS 120
+
+static double medir( Deriva *deriva, const CampoCorrente *campo, PoolTarefas *pool ) {
+    double t0 = PlataformaTempo();
+    for ( int p = 0; p < PASSOS; p++ ) {
+        DerivaIntegrar( deriva, campo, 1.0f, 1.0f / 60.0f, pool );
+    }
+    return ( PlataformaTempo() - t0 ) * 1000.0 / PASSOS;
+}
+
+static void preencher( Deriva *deriva, int quantidade ) {
+    srand( 7 );
+    for ( int i = 0; i < quantidade; i++ ) {
+        Vector2 pos = { (float)( rand() % MUNDO_WIDTH ), (float)( rand() % MUNDO_HEIGHT ) };
+        DerivaDefinir( deriva, i, pos, 4.0f + ( rand() % 4 ) * 10.0f );
+    }
+}
+
+int main( void ) {
+
+    const int quantidades[] = { 1000, 10000, 100000 };
+    const int numQuantidades = sizeof(quantidades) / sizeof(quantidades[0]);
+    int nucleos = PlataformaNucleos();
+
+    CampoCorrente campo;
+    CampoCorrenteGerar( &campo, MUNDO_WIDTH, MUNDO_HEIGHT, 35.0f, 1234 );
+
+    printf( "%8s %8s %14s %10s\n", "itens", "threads", "ms por passo", "ganho" );
+
+    for ( int q = 0; q < numQuantidades; q++ ) {
+
+        int n = quantidades[q];
+        Deriva serie;
+        DerivaCriar( &serie, n, MUNDO_WIDTH, MUNDO_HEIGHT - 75 );
+        preencher( &serie, n );
+        double msSerie = medir( &serie, &campo, NULL );
+        printf( "%8d %8d %14.3f %10s\n", n, 1, msSerie, "-" );
+
+        for ( int threads = 2; threads <= nucleos; threads *= 2 ) {
+
+            PoolTarefas *pool = PoolTarefasCriar( threads - 1 );
+            Deriva paralelo;
+            DerivaCriar( &paralelo, n, MUNDO_WIDTH, MUNDO_HEIGHT - 75 );
+            preencher( &paralelo, n );
+            double ms = medir( &paralelo, &campo, pool );
+
+            // cada item é independente: o resultado tem que ser idêntico
+            for ( int i = 0; i < n; i++ ) {
+                if ( paralelo.x[i] != serie.x[i] || paralelo.y[i] != serie.y[i] ) {
+                    printf( "ERRO: item %d diverge entre serie e paralelo\n", i );
+                    return 1;
+                }
+            }
+
+            printf( "%8d %8d %14.3f %9.2fx\n", n, threads, ms, msSerie / ms );
+            DerivaDestruir( &paralelo );
+            PoolTarefasDestruir( pool );
+
+        }
+
+        DerivaDestruir( &serie );
+
+    }
+
+    return 0;
+
+}
@@ -0,0 +1,100 @@
+/**
+ * @file bench_eventos.c
+ * @brief Benchmark do log de eventos: quanto o jogo paga por quadro para
+ * registrar e quanto a abertura leva para conferir os lotes de um log
+ * grande. Confere também que um lote cortado por uma queda não esconde a
+ * execução seguinte.
+ * @copyright Copyright (c) 2025
+ */
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "eventos.h"
+#include "plataforma.h"
+
+#define ARQUIVO "bench_eventos.bin"
+#define QUADROS 200000 // quadros do log grande
+#define QUADROS_EXECUCAO 1000 // quadros de cada execução da conferência
+
+// um quadro típico: uma coleta de vez em quando e o tempo do quadro
+static void quadros( LogEventos *log, int quantidade, int tipoLixo ) {
+    for ( int i = 0; i < quantidade; i++ ) {
+        LogEventosRegistrar( log, EVENTO_COLETA, i % 4, tipoLixo, 0, 0 );
+        LogEventosFimDoQuadro( log, 16.6f );
+        if ( i % 1000 == 999 ) {
+            PlataformaDormir( 0.001 ); // o anel não enche
+        }
+    }
+}
+
+static long tamanhoArquivo( void ) {
+    FILE *arquivo = fopen( ARQUIVO, "rb" );
+    if ( arquivo == NULL ) {
+        return 0;
+    }
+    fseek( arquivo, 0, SEEK_END );
+    long tamanho = ftell( arquivo );
+    fclose( arquivo );
+    return tamanho;
+}
+
+int main( void ) {
+
+    bool ok = true;
+    LogEventos log;
+
+    // registrar: o laço do jogo nunca espera a thread
+    remove( ARQUIVO );
+    LogEventosAbrir( &log, ARQUIVO );
+    double t0 = PlataformaTempo();
+    quadros( &log, QUADROS, 0 );
+    double registrar = PlataformaTempo() - t0;
+    LogEventosFechar( &log );
+    printf( "registrar: %.3f us por quadro, %lld eventos, %lld perdidos, %.1f bytes por quadro\n",
+            registrar * 1e6 / QUADROS, log.gravados, log.perdidos, (double)log.bytes / QUADROS );
+
+    // abrir: percorre os cabeçalhos dos lotes antes de acrescentar
+    t0 = PlataformaTempo();
+    LogEventosAbrir( &log, ARQUIVO );
+    double abrir = PlataformaTempo() - t0;
+    LogEventosFechar( &log );
+    printf( "abrir: %.3f ms com %ld bytes\n", abrir * 1000.0, tamanhoArquivo() );
+
+    // queda no meio de um lote: a execução seguinte continua legível
+    remove( ARQUIVO );
+    LogEventosAbrir( &log, ARQUIVO );
+    quadros( &log, QUADROS_EXECUCAO, 1 );
+    LogEventosFechar( &log );
+    ok = ok && PlataformaTruncarArquivo( ARQUIVO, (size_t)tamanhoArquivo() - 5 );
+
+    LogEventosAbrir( &log, ARQUIVO );
+    quadros( &log, QUADROS_EXECUCAO, 2 );
+    LogEventosFechar( &log );
+
+    size_t tamanho = 0;
+    size_t pos = 0;
+    const uint8_t *dados = PlataformaMapearArquivo( ARQUIVO, &tamanho );
+    Evento *eventos = (Evento*)malloc( sizeof(Evento) * EVENTOS_LOTE );
+    int aberturas = 0;
+    int coletasSegunda = 0;
+    int n = -1;
+    if ( dados != NULL && LogEventosLerCabecalho( dados, tamanho, &pos ) ) {
+        while ( ( n = LogEventosLerLote( dados, tamanho, &pos, eventos ) ) > 0 ) {
+            for ( int i = 0; i < n; i++ ) {
+                aberturas += eventos[i].tipo == EVENTO_ABERTURA;
+                coletasSegunda += eventos[i].tipo == EVENTO_COLETA && eventos[i].a == 2;
+            }
+        }
+    }
+    PlataformaDesmapearArquivo( dados, tamanho );
+    free( eventos );
+
+    bool quedaOk = n == 0 && aberturas == 2 && coletasSegunda == QUADROS_EXECUCAO;
+    printf( "queda: %d execucoes, %d de %d coletas da segunda%s\n", aberturas, coletasSegunda, QUADROS_EXECUCAO,
+            quedaOk ? "" : "  ERRO" );
+    ok = ok && quedaOk;
+
+    remove( ARQUIVO );
+    return ok ? 0 : 1;
+
+}
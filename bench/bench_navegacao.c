@@ -0,0 +1,148 @@
+/**
+ * @file bench_navegacao.c
+ * @brief Benchmark dos campos de fluxo: custo de recalcular um campo
+ * inteiro, de corrigir depois de mudar uma rocha e de mover agentes
+ * consultando os campos.
+ * @copyright Copyright (c) 2025
+ */
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "raylib/raylib.h"
+
+#include "mundo.h"
+#include "navegacao.h"
+#include "plataforma.h"
+
+#define CAMPOS 4
+#define PASSOS 60
+#define ALTERACOES 200
+
+static bool camposIguais( const CampoFluxo *a, const CampoFluxo *b, int celulas ) {
+    for ( int c = 0; c < celulas; c++ ) {
+        if ( a->distancia[c] != b->distancia[c] ) {
+            return false;
+        }
+    }
+    return true;
+}
+
+static void medirGrade( const char *nome, NavGrade *nav ) {
+
+    int celulas = nav->colunas * nav->linhas;
+    float largura = (float)nav->colunas * nav->celula;
+    float altura = (float)nav->linhas * nav->celula;
+
+    // um objetivo por "lixeira", espalhados no fundo do mapa
+    CampoFluxo campos[CAMPOS];
+    for ( int i = 0; i < CAMPOS; i++ ) {
+        FluxoCriar( &campos[i], nav, (Vector2){ largura * ( i + 1 ) / ( CAMPOS + 1 ), altura - nav->celula * 1.5f } );
+    }
+
+    double t0 = PlataformaTempo();
+    for ( int r = 0; r < 20; r++ ) {
+        FluxoRecalcular( &campos[r % CAMPOS], nav );
+    }
+    double msCompleto = ( PlataformaTempo() - t0 ) * 1000.0 / 20;
+
+    // liga e desliga rochas aleatórias, corrigindo os 4 campos a cada vez
+    srand( 3 );
+    double msIncremental = 0;
+    bool confere = true;
+    CampoFluxo referencia;
+    FluxoCriar( &referencia, nav, (Vector2){ 0, 0 } );
+    for ( int a = 0; a < ALTERACOES; a++ ) {
+
+        int cx = rand() % nav->colunas;
+        int cy = rand() % ( nav->linhas - 3 );
+        bool rocha = !nav->rocha[cy * nav->colunas + cx];
+
+        double inicio = PlataformaTempo();
+        NavDefinirRocha( nav, cx, cy, rocha );
+        for ( int i = 0; i < CAMPOS; i++ ) {
+            FluxoAtualizar( &campos[i], nav );
+        }
+        NavLimparAlteracoes( nav );
+        msIncremental += ( PlataformaTempo() - inicio ) * 1000.0;
+
+        // a correção tem que chegar no mesmo resultado do recálculo completo
+        if ( a % 10 == 0 ) {
+            for ( int i = 0; i < CAMPOS; i++ ) {
+                referencia.destino = campos[i].destino;
+                FluxoRecalcular( &referencia, nav );
+                confere = confere && camposIguais( &referencia, &campos[i], celulas );
+            }
+        }
+
+    }
+    FluxoDestruir( &referencia );
+    msIncremental /= ALTERACOES;
+
+    printf( "%s (%dx%d celulas)\n", nome, nav->colunas, nav->linhas );
+    printf( "  recalculo completo de 1 campo: %8.3f ms\n", msCompleto );
+    printf( "  rocha alterada, %d campos:      %8.3f ms (%s)\n", CAMPOS, msIncremental,
+            confere ? "igual ao completo" : "ERRO: diverge do completo" );
+
+    // agentes: cada um segue o campo da sua lixeira
+    const int quantidades[] = { 1000, 10000, 100000 };
+    printf( "  %10s %14s\n", "agentes", "ms por passo" );
+    for ( int q = 0; q < 3; q++ ) {
+
+        int n = quantidades[q];
+        float *x = (float*)malloc( sizeof(float) * n );
+        float *y = (float*)malloc( sizeof(float) * n );
+        for ( int i = 0; i < n; i++ ) {
+            int c;
+            do {
+                c = rand() % celulas;
+            } while ( nav->bloqueada[c] );
+            x[i] = ( c % nav->colunas + 0.5f ) * nav->celula;
+            y[i] = ( c / nav->colunas + 0.5f ) * nav->celula;
+        }
+
+        t0 = PlataformaTempo();
+        for ( int p = 0; p < PASSOS; p++ ) {
+            for ( int i = 0; i < n; i++ ) {
+                Vector2 d = FluxoDirecao( &campos[i % CAMPOS], nav, (Vector2){ x[i], y[i] } );
+                x[i] += d.x * 190.0f / 60.0f;
+                y[i] += d.y * 190.0f / 60.0f;
+            }
+        }
+        printf( "  %10d %14.3f\n", n, ( PlataformaTempo() - t0 ) * 1000.0 / PASSOS );
+
+        free( x );
+        free( y );
+
+    }
+
+    for ( int i = 0; i < CAMPOS; i++ ) {
+        FluxoDestruir( &campos[i] );
+    }
+
+    if ( !confere ) {
+        exit( 1 );
+    }
+
+}
+
+int main( void ) {
+
+    NavGrade mapa;
+    NavGradeCarregar( &mapa, "resources/mapa/rochas.txt", MUNDO_WIDTH, MUNDO_HEIGHT, 1 );
+    medirGrade( "mapa do jogo", &mapa );
+    NavGradeDestruir( &mapa );
+
+    // mapa 16x maior com 2% de rochas espalhadas
+    NavGrade grande;
+    NavGradeCriar( &grande, 288, 128, NAV_CELULA_PADRAO, 1 );
+    srand( 11 );
+    for ( int i = 0; i < 288 * 128 / 50; i++ ) {
+        NavDefinirRocha( &grande, rand() % 288, rand() % 125, true );
+    }
+    NavLimparAlteracoes( &grande );
+    medirGrade( "mapa grande", &grande );
+    NavGradeDestruir( &grande );
+
+    return 0;
+
+}
@@ -0,0 +1,84 @@
+/**
+ * @file bench_particulas.c
+ * @brief Benchmark do sistema de partículas: quantidade de partículas x
+ * tempo de quadro (atualização SIMD e desenho em lote).
+ *
+ * Abre uma janela escondida e desenha com a GPU disponível. Para medir no
+ * rasterizador por software do Mesa (llvmpipe):
+ *     LIBGL_ALWAYS_SOFTWARE=1 make bench
+ * @copyright Copyright (c) 2025
+ */
+#include <stdio.h>
+
+#include "raylib/raylib.h"
+
+#include "particulas.h"
+#include "plataforma.h"
+
+#define QUADROS_AQUECIMENTO 30
+#define QUADROS_MEDIDOS 300
+#define ORCAMENTO_MS ( 1000.0 / 60.0 )
+
+int main( void ) {
+
+    const int quantidades[] = { 1000, 5000, 10000, 25000, 50000, 100000 };
+    const int numQuantidades = sizeof(quantidades) / sizeof(quantidades[0]);
+
+    SetTraceLogLevel( LOG_WARNING );
+    SetConfigFlags( FLAG_WINDOW_HIDDEN );
+    InitWindow( 800, 600, "Ocean Guardians - bench particulas" );
+    SetTargetFPS( 0 );
+
+    Image imagemBolha = GenImageGradientRadial( 32, 32, 0.3f, WHITE, BLANK );
+    Texture2D texturaBolha = LoadTextureFromImage( imagemBolha );
+    UnloadImage( imagemBolha );
+
+    Rectangle tela = { 0, 0, (float)GetScreenWidth(), (float)GetScreenHeight() };
+    Vector2 centro = { tela.width / 2, tela.height / 2 };
+
+    printf( "%10s %16s %16s %12s\n", "particulas", "atualizar (ms)", "quadro (ms)", "60 FPS" );
+
+    for ( int q = 0; q < numQuantidades; q++ ) {
+
+        // vida longa e pouca velocidade: todas continuam vivas e na tela
+        Emissor emissor;
+        EmissorCriar( &emissor, quantidades[q], texturaBolha, (Vector2){ 0, 0 }, 0.0f, 1000.0f, (Color){ 200, 230, 255, 200 } );
+        EmissorEmitir( &emissor, centro, quantidades[q], (Vector2){ 0, 0 }, 30, 6 );
+
+        double totalAtualizar = 0;
+        double totalQuadro = 0;
+
+        for ( int f = 0; f < QUADROS_AQUECIMENTO + QUADROS_MEDIDOS; f++ ) {
+
+            double t0 = PlataformaTempo();
+            EmissorAtualizar( &emissor, 1.0f / 60.0f );
+            double t1 = PlataformaTempo();
+
+            BeginDrawing();
+            ClearBackground( DARKBLUE );
+            EmissorDesenhar( &emissor, tela );
+            EndDrawing();
+            double t2 = PlataformaTempo();
+
+            if ( f >= QUADROS_AQUECIMENTO ) {
+                totalAtualizar += t1 - t0;
+                totalQuadro += t2 - t0;
+            }
+
+        }
+
+        double msAtualizar = totalAtualizar * 1000.0 / QUADROS_MEDIDOS;
+        double msQuadro = totalQuadro * 1000.0 / QUADROS_MEDIDOS;
+        printf( "%10d %16.3f %16.3f %12s\n", quantidades[q], msAtualizar, msQuadro,
+                msQuadro <= ORCAMENTO_MS ? "ok" : "estourou" );
+
+        EmissorDestruir( &emissor );
+
+    }
+
+    UnloadTexture( texturaBolha );
+    CloseWindow();
+
+    return 0;
+
+}
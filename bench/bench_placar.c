@@ -0,0 +1,138 @@
+/**
+ * @file bench_placar.c
+ * @brief Benchmark do placar: tempo de carga com históricos de vários
+ * tamanhos, quanto o jogo espera ao registrar uma partida e quanto a thread
+ * leva para gravar o arquivo. Confere também que o histórico cheio
+ * descarta os registros antigos sem perder o ranking e os recordes.
+ * @copyright Copyright (c) 2025
+ */
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "placar.h"
+#include "plataforma.h"
+
+#define ARQUIVO "bench_placar.dat"
+#define CARGAS 20 // cargas medidas por tamanho (vale a menor)
+
+static void partida( RegistroPlacar *registros, int numJogadores, uint32_t data ) {
+    int equipe = 0;
+    for ( int j = 0; j < numJogadores; j++ ) {
+        registros[j] = (RegistroPlacar){ rand() % 2000, 0, data, (uint8_t)j, (uint8_t)numJogadores, 0, 0 };
+        equipe += registros[j].pontuacao;
+    }
+    for ( int j = 0; j < numJogadores; j++ ) {
+        registros[j].equipe = equipe;
+        registros[j].vitoria = equipe >= 2000;
+    }
+}
+
+int main( void ) {
+
+    const int quantidades[] = { 0, 1000, 10000, PLACAR_MAX_REGISTROS - 4 };
+    const int numQuantidades = sizeof(quantidades) / sizeof(quantidades[0]);
+    bool ok = true;
+
+    srand( 42 );
+    printf( "%9s %14s %16s %14s\n", "registros", "carga (ms)", "registrar (us)", "gravacao (ms)" );
+
+    for ( int q = 0; q < numQuantidades; q++ ) {
+
+        int n = quantidades[q];
+        Placar placar;
+        RegistroPlacar registros[4];
+
+        // histórico de n registros, gravado pela própria thread
+        remove( ARQUIVO );
+        PlacarAbrir( &placar, ARQUIVO );
+        while ( placar.quantidade < n ) {
+            int jogadores = 1 + rand() % 4;
+            jogadores = jogadores > n - placar.quantidade ? n - placar.quantidade : jogadores;
+            partida( registros, jogadores, 1700000000u + placar.quantidade );
+            PlacarRegistrar( &placar, registros, jogadores );
+        }
+        PlacarFechar( &placar );
+
+        double melhorCarga = 1e9;
+        for ( int k = 0; k < CARGAS; k++ ) {
+            double t0 = PlataformaTempo();
+            PlacarAbrir( &placar, ARQUIVO );
+            double carga = PlataformaTempo() - t0;
+            melhorCarga = carga < melhorCarga ? carga : melhorCarga;
+            ok = ok && placar.quantidade == n;
+            if ( k < CARGAS - 1 ) {
+                PlacarFechar( &placar );
+            }
+        }
+
+        // o que o laço do jogo paga ao fim de uma partida de 4 jogadores
+        partida( registros, 4, 1800000000u );
+        double t0 = PlataformaTempo();
+        PlacarRegistrar( &placar, registros, 4 );
+        double registrar = PlataformaTempo() - t0;
+
+        // até a thread terminar de gravar
+        t0 = PlataformaTempo();
+        PlacarFechar( &placar );
+        double gravacao = PlataformaTempo() - t0;
+
+        PlacarAbrir( &placar, ARQUIVO );
+        bool lidoOk = placar.quantidade == n + 4 && placar.melhorEquipe >= registros[0].equipe;
+        PlacarFechar( &placar );
+        ok = ok && lidoOk;
+
+        printf( "%9d %14.3f %16.1f %14.3f%s\n", n, melhorCarga * 1000.0, registrar * 1e6, gravacao * 1000.0, lidoOk ? "" : "  ERRO" );
+
+    }
+
+    // histórico cheio: os antigos saem, mas o ranking e os recordes do
+    // começo continuam lá depois da carga
+    {
+        Placar placar;
+        RegistroPlacar registros[4];
+        const int ranking[PLACAR_RANKING] = { 5003, 5002, 5001, 5000, 4000 };
+
+        remove( ARQUIVO );
+        PlacarAbrir( &placar, ARQUIVO );
+        for ( int j = 0; j < 4; j++ ) {
+            registros[j] = (RegistroPlacar){ 5000 + j, 20006, 1600000000u, (uint8_t)j, 4, 1, 0 };
+        }
+        PlacarRegistrar( &placar, registros, 4 );
+        registros[0] = (RegistroPlacar){ 4000, 4000, 1600000001u, 0, 1, 1, 0 };
+        PlacarRegistrar( &placar, registros, 1 );
+
+        uint32_t ultima = 0;
+        int registrados = 5;
+        int partidas = 0;
+        double t0 = PlataformaTempo();
+        while ( registrados < 2 * PLACAR_MAX_REGISTROS ) {
+            int jogadores = 1 + rand() % 4;
+            ultima = 1700000000u + (uint32_t)registrados;
+            partida( registros, jogadores, ultima );
+            ok = ok && PlacarRegistrar( &placar, registros, jogadores );
+            registrados += jogadores;
+            partidas++;
+        }
+        double registrar = PlataformaTempo() - t0;
+        PlacarFechar( &placar );
+
+        PlacarAbrir( &placar, ARQUIVO );
+        bool cheioOk = placar.quantidade <= PLACAR_MAX_REGISTROS && placar.quantidade > 0 &&
+                       placar.registros[placar.quantidade - 1].data == ultima &&
+                       placar.tamanhoRanking == PLACAR_RANKING && placar.melhorEquipe == 20006;
+        for ( int k = 0; k < PLACAR_RANKING; k++ ) {
+            cheioOk = cheioOk && placar.ranking[k].pontuacao == ranking[k];
+        }
+        for ( int j = 0; j < PLACAR_MAX_JOGADORES; j++ ) {
+            cheioOk = cheioOk && placar.melhorJogador[j] == 5000 + j;
+        }
+        printf( "cheio: %d registros de %d, %.1f us por partida%s\n", placar.quantidade, registrados,
+                registrar * 1e6 / partidas, cheioOk ? "" : "  ERRO" );
+        PlacarFechar( &placar );
+        ok = ok && cheioOk;
+    }
+
+    remove( ARQUIVO );
+    return ok ? 0 : 1;
+
+}
@@ -0,0 +1,154 @@
+/**
+ * @file bench_snapshot.c
+ * @brief Benchmark do codec de snapshots: bytes e snapshots por segundo
+ * para o snapshot completo e para o delta de um tick (lixo à deriva, alguns
+ * recolhidos e outros novos), com conferência da ida e volta.
+ * @copyright Copyright (c) 2025
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include <math.h>
+
+#include "mundo.h"
+#include "plataforma.h"
+#include "snapshot.h"
+
+#define TEMPO_MINIMO 0.2 // segundos medidos por caso
+
+static float aleatorio( float maximo ) {
+    return (float)rand() / (float)RAND_MAX * maximo;
+}
+
+static void preencher( Snapshot *s, SnapshotLixo *lixos, int n, uint32_t tick ) {
+    s->tick = tick;
+    s->ultimaEntrada = tick;
+    s->estado = 1;
+    s->tempoRestante = 120.0f;
+    s->numJogadores = 2;
+    for ( int j = 0; j < s->numJogadores; j++ ) {
+        s->jogadores[j] = (SnapshotJogador){ 360.0f + j * 140, MUNDO_HEIGHT - 360.0f, 300, 4, 0, false, false };
+    }
+    s->numLixeiras = 4;
+    for ( int i = 0; i < s->numLixeiras; i++ ) {
+        s->lixeiras[i] = (SnapshotLixeira){ 70.0f + i * 185, MUNDO_HEIGHT - 125.0f, 85, 105, i };
+    }
+    s->numLixos = n;
+    s->capacidadeLixos = n;
+    s->lixos = lixos;
+    for ( int i = 0; i < n; i++ ) {
+        lixos[i] = (SnapshotLixo){ aleatorio( MUNDO_WIDTH - 30 ), aleatorio( MUNDO_HEIGHT - 40 ), rand() % 4, true };
+    }
+}
+
+// um tick de jogo: tudo deriva menos de 1 px, 1% é recolhido ou reaparece
+static void avancar( const Snapshot *base, Snapshot *s ) {
+    SnapshotLixo *lixos = s->lixos;
+    *s = *base;
+    s->lixos = lixos;
+    s->tick++;
+    s->tempoRestante -= 1.0f / 60.0f;
+    s->jogadores[0].x += 190.0f / 60.0f;
+    s->jogadores[0].movendo = true;
+    for ( int i = 0; i < s->numLixos; i++ ) {
+        lixos[i] = base->lixos[i];
+        if ( rand() % 100 == 0 ) {
+            lixos[i].ativo = !lixos[i].ativo;
+        } else if ( lixos[i].ativo ) {
+            lixos[i].x += aleatorio( 1.0f ) - 0.5f;
+            lixos[i].y += aleatorio( 0.6f );
+        }
+    }
+}
+
+// o que o codec deve devolver: mesma coisa, posições com erro <= 1/16 px
+static bool confere( const Snapshot *a, const Snapshot *b ) {
+    if ( a->tick != b->tick || a->numLixos != b->numLixos || a->numJogadores != b->numJogadores ) {
+        return false;
+    }
+    for ( int j = 0; j < a->numJogadores; j++ ) {
+        if ( fabsf( a->jogadores[j].x - b->jogadores[j].x ) > 0.07f || a->jogadores[j].movendo != b->jogadores[j].movendo ) {
+            return false;
+        }
+    }
+    for ( int i = 0; i < a->numLixos; i++ ) {
+        if ( a->lixos[i].ativo != b->lixos[i].ativo ) {
+            return false;
+        }
+        if ( a->lixos[i].ativo && ( a->lixos[i].tipo != b->lixos[i].tipo ||
+             fabsf( a->lixos[i].x - b->lixos[i].x ) > 0.07f || fabsf( a->lixos[i].y - b->lixos[i].y ) > 0.07f ) ) {
+            return false;
+        }
+    }
+    return true;
+}
+
+int main( void ) {
+
+    const int quantidades[] = { 1, 1000, 100000 };
+    const int numQuantidades = sizeof(quantidades) / sizeof(quantidades[0]);
+    bool ok = true;
+
+    srand( 42 );
+    printf( "%7s %6s %12s %14s %14s %14s\n", "lixos", "tipo", "bytes", "bits/lixo", "escrita (/s)", "leitura (/s)" );
+
+    for ( int q = 0; q < numQuantidades; q++ ) {
+
+        int n = quantidades[q];
+        int capacidade = 256 + n * 8;
+        uint8_t *buffer = (uint8_t*)malloc( capacidade );
+        SnapshotLixo *lixos = (SnapshotLixo*)malloc( sizeof(SnapshotLixo) * n * 4 );
+        Snapshot base;
+        Snapshot atual;
+        Snapshot lidoBase;
+        Snapshot lido;
+
+        // base (já decodificada, como o cliente a teria) e o tick seguinte
+        preencher( &base, lixos, n, 1 );
+        atual.lixos = lixos + n;
+        lidoBase = base;
+        lidoBase.lixos = lixos + 2 * n;
+        int tamanhoBase = SnapshotEscrever( buffer, capacidade, &base, NULL );
+        if ( tamanhoBase < 0 || !SnapshotLer( buffer, tamanhoBase, NULL, &lidoBase ) ) {
+            printf( "%7d: falha no snapshot base\n", n );
+            return 1;
+        }
+        avancar( &lidoBase, &atual );
+        lido = lidoBase;
+        lido.lixos = lixos + 3 * n;
+
+        for ( int modo = 0; modo < 2; modo++ ) {
+
+            const Snapshot *b = modo == 0 ? NULL : &lidoBase;
+            int tamanho = 0;
+            long repeticoes = 0;
+            double t0 = PlataformaTempo();
+            do {
+                tamanho = SnapshotEscrever( buffer, capacidade, &atual, b );
+                repeticoes++;
+            } while ( PlataformaTempo() - t0 < TEMPO_MINIMO );
+            double escritas = repeticoes / ( PlataformaTempo() - t0 );
+
+            bool lidoOk = true;
+            repeticoes = 0;
+            t0 = PlataformaTempo();
+            do {
+                lidoOk = SnapshotLer( buffer, tamanho, b, &lido ) && lidoOk;
+                repeticoes++;
+            } while ( PlataformaTempo() - t0 < TEMPO_MINIMO );
+            double leituras = repeticoes / ( PlataformaTempo() - t0 );
+
+            lidoOk = lidoOk && tamanho > 0 && confere( &atual, &lido );
+            ok = ok && lidoOk;
+            printf( "%7d %6s %12d %14.2f %14.0f %14.0f%s\n", n, modo == 0 ? "cheio" : "delta", tamanho,
+                    tamanho * 8.0 / n, escritas, leituras, lidoOk ? "" : "  ERRO" );
+
+        }
+
+        free( buffer );
+        free( lixos );
+
+    }
+
+    return ok ? 0 : 1;
+
+}
@@ -0,0 +1,160 @@
+/**
+ * @file arena.c
+ * @brief Arena linear de quadro e arena dupla.
+ * @copyright Copyright (c) 2025
+ */
+#include <stdarg.h>
+#include <stdio.h>
+#include <string.h>
+
+#include "arena.h"
+#include "memoria.h"
+
+struct BlocoArena {
+    BlocoArena *anterior;
+    size_t capacidade;
+    // os dados começam logo depois, alinhados
+};
+
+#define CABECALHO_BLOCO ( ( sizeof(BlocoArena) + ARENA_ALINHAMENTO - 1 ) / ARENA_ALINHAMENTO * ARENA_ALINHAMENTO )
+
+static unsigned char *dadosDoBloco( BlocoArena *bloco ) {
+    return (unsigned char*)bloco + CABECALHO_BLOCO;
+}
+
+static BlocoArena *novoBloco( BlocoArena *anterior, size_t capacidade ) {
+    BlocoArena *bloco = (BlocoArena*)MemoriaAlocar( MEMORIA_ARENA, CABECALHO_BLOCO + capacidade );
+    if ( bloco != NULL ) {
+        bloco->anterior = anterior;
+        bloco->capacidade = capacidade;
+    }
+    return bloco;
+}
+
+static void liberarAnteriores( BlocoArena *bloco ) {
+    BlocoArena *anterior = bloco->anterior;
+    bloco->anterior = NULL;
+    while ( anterior != NULL ) {
+        BlocoArena *proximo = anterior->anterior;
+        MemoriaLiberar( anterior );
+        anterior = proximo;
+    }
+}
+
+void ArenaCriar( Arena *arena, size_t capacidade ) {
+    memset( arena, 0, sizeof(Arena) );
+    arena->bloco = novoBloco( NULL, capacidade );
+}
+
+void ArenaDestruir( Arena *arena ) {
+    if ( arena->bloco != NULL ) {
+        liberarAnteriores( arena->bloco );
+        MemoriaLiberar( arena->bloco );
+    }
+    memset( arena, 0, sizeof(Arena) );
+}
+
+void ArenaReservar( Arena *arena, size_t capacidade ) {
+
+    if ( arena->bloco != NULL && arena->bloco->capacidade >= capacidade ) {
+        return;
+    }
+
+    // o bloco atual pode ter dados do quadro: fica encadeado até o reset
+    BlocoArena *bloco = novoBloco( arena->usadoQuadro > 0 ? arena->bloco : NULL, capacidade );
+    if ( bloco == NULL ) {
+        return;
+    }
+    if ( arena->usadoQuadro == 0 ) {
+        MemoriaLiberar( arena->bloco );
+    }
+    arena->bloco = bloco;
+    arena->usado = 0;
+
+}
+
+void *ArenaAlocar( Arena *arena, size_t tamanho ) {
+
+    size_t alinhado = ( tamanho + ARENA_ALINHAMENTO - 1 ) / ARENA_ALINHAMENTO * ARENA_ALINHAMENTO;
+    if ( arena->bloco == NULL || arena->usado + alinhado > arena->bloco->capacidade ) {
+        // passou da capacidade: outro bloco, pelo menos o dobro
+        size_t capacidade = arena->bloco != NULL ? arena->bloco->capacidade * 2 : alinhado;
+        BlocoArena *bloco = novoBloco( arena->bloco, capacidade > alinhado ? capacidade : alinhado );
+        if ( bloco == NULL ) {
+            return NULL;
+        }
+        arena->bloco = bloco;
+        arena->usado = 0;
+        arena->blocosExtras++;
+    }
+
+    void *p = dadosDoBloco( arena->bloco ) + arena->usado;
+    arena->usado += alinhado;
+    arena->usadoQuadro += alinhado;
+    if ( arena->usadoQuadro > arena->pico ) {
+        arena->pico = arena->usadoQuadro;
+    }
+    return p;
+
+}
+
+char *ArenaFormatar( Arena *arena, const char *formato, ... ) {
+
+    va_list args;
+    va_start( args, formato );
+    int tamanho = vsnprintf( NULL, 0, formato, args );
+    va_end( args );
+    if ( tamanho < 0 ) {
+        return NULL;
+    }
+
+    char *texto = (char*)ArenaAlocar( arena, (size_t)tamanho + 1 );
+    if ( texto != NULL ) {
+        va_start( args, formato );
+        vsnprintf( texto, (size_t)tamanho + 1, formato, args );
+        va_end( args );
+    }
+    return texto;
+
+}
+
+void ArenaResetar( Arena *arena ) {
+
+    if ( arena->bloco != NULL && arena->bloco->anterior != NULL ) {
+        // o quadro precisou de vários blocos: um só, do tamanho do pico
+        size_t pico = arena->pico;
+        liberarAnteriores( arena->bloco );
+        if ( arena->bloco->capacidade < pico ) {
+            MemoriaLiberar( arena->bloco );
+            arena->bloco = novoBloco( NULL, pico );
+        }
+    }
+    arena->usado = 0;
+    arena->usadoQuadro = 0;
+
+}
+
+void ArenaDuplaCriar( ArenaDupla *dupla, size_t capacidade ) {
+    ArenaCriar( &dupla->arenas[0], capacidade );
+    ArenaCriar( &dupla->arenas[1], capacidade );
+    dupla->atual = 0;
+}
+
+void ArenaDuplaDestruir( ArenaDupla *dupla ) {
+    ArenaDestruir( &dupla->arenas[0] );
+    ArenaDestruir( &dupla->arenas[1] );
+}
+
+Arena *ArenaDuplaTrocar( ArenaDupla *dupla ) {
+    dupla->atual ^= 1;
+    ArenaResetar( &dupla->arenas[dupla->atual] );
+    return &dupla->arenas[dupla->atual];
+}
+
+Arena *ArenaDuplaAtual( ArenaDupla *dupla ) {
+    return &dupla->arenas[dupla->atual];
+}
+
+Arena *ArenaDuplaAnterior( ArenaDupla *dupla ) {
+    return &dupla->arenas[dupla->atual ^ 1];
+}
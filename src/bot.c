@@ -0,0 +1,245 @@
+/**
+ * @file bot.c
+ * @brief Planejamento do mergulhador automático: vai até o lixo que dá o
+ * menor caminho de ida e volta às lixeiras, pega, leva até a lixeira do
+ * mesmo tipo e descarta.
+ * @copyright Copyright (c) 2025
+ */
+#include <stdbool.h>
+#include <float.h>
+#include <math.h>
+#include <string.h>
+
+#include "raylib/raylib.h"
+#include "raylib/raymath.h"
+
+#include "bot.h"
+#include "colisao.h"
+#include "navegacao.h"
+
+// distância mínima em cada eixo para o bot mexer naquele eixo; evita que
+// ele fique tremendo em cima do alvo
+#define ZONA_MORTA 4.0f
+
+// sem chegar mais perto do alvo por esse tempo, o bot desiste dele
+#define TEMPO_SEM_PROGRESSO 6.0f
+
+// componente mínima da direção do campo para apertar a tecla daquele eixo
+// (seno de 22,5 graus: as 8 direções do teclado ficam com fatias iguais)
+#define LIMIAR_DIRECAO 0.38f
+
+static Vector2 centroDoItem( const LoteAABB *lote, int i ) {
+    return (Vector2){
+        ( lote->minX[i] + lote->maxX[i] ) * 0.5f,
+        ( lote->minY[i] + lote->maxY[i] ) * 0.5f
+    };
+}
+
+static bool itemAtivo( const LoteAABB *lote, int i ) {
+    return lote->minX[i] <= lote->maxX[i];
+}
+
+static float distancia( Vector2 a, Vector2 b ) {
+    return sqrtf( ( a.x - b.x ) * ( a.x - b.x ) + ( a.y - b.y ) * ( a.y - b.y ) );
+}
+
+static bool encosta( Rectangle rec, const LoteAABB *lote, int i ) {
+    return rec.x < lote->maxX[i] && rec.x + rec.width > lote->minX[i] &&
+           rec.y < lote->maxY[i] && rec.y + rec.height > lote->minY[i];
+}
+
+/**
+ * @brief Lixo com menor custo de ida até ele e volta até o centro das
+ * lixeiras (o tipo só é conhecido depois de pegar).
+ */
+static int escolherLixo( const Bot *bot, const VisaoBot *visao, Vector2 jogador ) {
+
+    Vector2 lixeiras = { 0, 0 };
+    for ( int i = 0; i < visao->lixeiras->quantidade; i++ ) {
+        lixeiras = Vector2Add( lixeiras, centroDoItem( visao->lixeiras, i ) );
+    }
+    if ( visao->lixeiras->quantidade > 0 ) {
+        lixeiras = Vector2Scale( lixeiras, 1.0f / visao->lixeiras->quantidade );
+    }
+
+    int melhor = -1;
+    float menorCusto = FLT_MAX;
+    for ( int i = 0; i < visao->lixos->quantidade; i++ ) {
+        if ( !itemAtivo( visao->lixos, i ) || i == bot->ignorado ) {
+            continue;
+        }
+        Vector2 centro = centroDoItem( visao->lixos, i );
+        float custo = distancia( jogador, centro ) + distancia( centro, lixeiras );
+        if ( custo < menorCusto ) {
+            menorCusto = custo;
+            melhor = i;
+        }
+    }
+
+    return melhor;
+
+}
+
+static void segurar( Bot *bot, AcaoBot acao ) {
+    bot->seguradas |= 1u << acao;
+}
+
+static void apertar( Bot *bot, AcaoBot acao, unsigned int seguradasAntes ) {
+    // como uma pessoa: se a tecla ficou segurada no quadro anterior, solta
+    // agora para poder apertar de novo no próximo
+    if ( !( seguradasAntes & ( 1u << acao ) ) ) {
+        bot->pressionadas |= 1u << acao;
+        segurar( bot, acao );
+    }
+}
+
+static void nadarAte( Bot *bot, Vector2 jogador, Vector2 destino ) {
+    float dx = destino.x - jogador.x;
+    float dy = destino.y - jogador.y;
+    if ( dx < -ZONA_MORTA ) segurar( bot, BOT_ESQUERDA );
+    if ( dx > ZONA_MORTA ) segurar( bot, BOT_DIREITA );
+    if ( dy < -ZONA_MORTA ) segurar( bot, BOT_CIMA );
+    if ( dy > ZONA_MORTA ) segurar( bot, BOT_BAIXO );
+}
+
+/**
+ * @brief Segue o campo de fluxo; na célula do objetivo vai direto ao destino.
+ */
+static void seguirCampo( Bot *bot, const NavGrade *nav, const CampoFluxo *campo, Vector2 jogador, Vector2 destino ) {
+    Vector2 direcao = FluxoDirecao( campo, nav, jogador );
+    if ( direcao.x == 0 && direcao.y == 0 ) {
+        nadarAte( bot, jogador, destino );
+        return;
+    }
+    if ( direcao.x < -LIMIAR_DIRECAO ) segurar( bot, BOT_ESQUERDA );
+    if ( direcao.x > LIMIAR_DIRECAO ) segurar( bot, BOT_DIREITA );
+    if ( direcao.y < -LIMIAR_DIRECAO ) segurar( bot, BOT_CIMA );
+    if ( direcao.y > LIMIAR_DIRECAO ) segurar( bot, BOT_BAIXO );
+}
+
+void BotCriar( Bot *bot, int teclaEsquerda, int teclaDireita, int teclaCima, int teclaBaixo,
+               int teclaPegar, int teclaDescartar ) {
+    bot->teclas[BOT_ESQUERDA] = teclaEsquerda;
+    bot->teclas[BOT_DIREITA] = teclaDireita;
+    bot->teclas[BOT_CIMA] = teclaCima;
+    bot->teclas[BOT_BAIXO] = teclaBaixo;
+    bot->teclas[BOT_PEGAR] = teclaPegar;
+    bot->teclas[BOT_DESCARTAR] = teclaDescartar;
+    bot->seguradas = 0;
+    bot->pressionadas = 0;
+    bot->alvo = -1;
+    bot->ignorado = -1;
+    bot->tempoNoAlvo = 0;
+    bot->melhorDistancia = FLT_MAX;
+    memset( &bot->caminhoAlvo, 0, sizeof(CampoFluxo) );
+}
+
+void BotDestruir( Bot *bot ) {
+    if ( bot->caminhoAlvo.distancia != NULL ) {
+        FluxoDestruir( &bot->caminhoAlvo );
+    }
+}
+
+void BotReservar( Bot *bot, const NavGrade *nav ) {
+    if ( bot->caminhoAlvo.distancia == NULL ) {
+        FluxoCriar( &bot->caminhoAlvo, nav, (Vector2){ 0, 0 } );
+    }
+}
+
+void BotPensar( Bot *bot, const VisaoBot *visao, float delta ) {
+
+    unsigned int seguradasAntes = bot->seguradas;
+    bot->seguradas = 0;
+    bot->pressionadas = 0;
+
+    Vector2 jogador = {
+        visao->jogador.x + visao->jogador.width * 0.5f,
+        visao->jogador.y + visao->jogador.height * 0.5f
+    };
+
+    // com lixo na mão o destino é a lixeira do mesmo tipo
+    if ( visao->tipoNaMao >= 0 && visao->tipoNaMao < visao->lixeiras->quantidade ) {
+        int lixeira = visao->tipoNaMao;
+        bot->alvo = -1;
+        Vector2 destino = centroDoItem( visao->lixeiras, lixeira );
+        // encostado em duas lixeiras, o jogo usa a de menor índice: só
+        // descarta quando a certa é a primeira
+        int primeira = -1;
+        ColisaoLoteIndices( visao->jogador, visao->lixeiras, &primeira, 1 );
+        if ( primeira == lixeira ) {
+            apertar( bot, BOT_DESCARTAR, seguradasAntes );
+        } else if ( visao->nav != NULL ) {
+            seguirCampo( bot, visao->nav, &visao->caminhos[lixeira], jogador, destino );
+        } else {
+            nadarAte( bot, jogador, destino );
+        }
+        return;
+    }
+
+    // o alvo pode ter sido pego ou respawnado em outro lugar
+    if ( bot->alvo >= 0 && !itemAtivo( visao->lixos, bot->alvo ) ) {
+        bot->alvo = -1;
+    }
+    if ( bot->alvo < 0 ) {
+        bot->alvo = escolherLixo( bot, visao, jogador );
+        bot->tempoNoAlvo = 0;
+        bot->melhorDistancia = FLT_MAX;
+        if ( bot->alvo < 0 ) {
+            bot->ignorado = -1;
+            return;
+        }
+    }
+
+    if ( encosta( visao->jogador, visao->lixos, bot->alvo ) ) {
+        apertar( bot, BOT_PEGAR, seguradasAntes );
+        return;
+    }
+
+    Vector2 destino = centroDoItem( visao->lixos, bot->alvo );
+    float d = distancia( jogador, destino );
+
+    // o lixo deriva: o campo só é refeito quando ele troca de célula
+    if ( visao->nav != NULL ) {
+        if ( bot->caminhoAlvo.distancia == NULL ) {
+            FluxoCriar( &bot->caminhoAlvo, visao->nav, destino );
+        } else {
+            FluxoDefinirDestino( &bot->caminhoAlvo, visao->nav, destino );
+        }
+    }
+    if ( d < bot->melhorDistancia - 1.0f ) {
+        bot->melhorDistancia = d;
+        bot->tempoNoAlvo = 0;
+    } else {
+        bot->tempoNoAlvo += delta;
+        if ( bot->tempoNoAlvo > TEMPO_SEM_PROGRESSO ) {
+            bot->ignorado = bot->alvo;
+            bot->alvo = -1;
+            return;
+        }
+    }
+
+    if ( visao->nav != NULL ) {
+        seguirCampo( bot, visao->nav, &bot->caminhoAlvo, jogador, destino );
+    } else {
+        nadarAte( bot, jogador, destino );
+    }
+
+}
+
+bool BotTeclaSegurada( const Bot *bot, int tecla ) {
+    for ( int a = 0; a < BOT_NUM_ACOES; a++ ) {
+        if ( bot->teclas[a] == tecla && ( bot->seguradas & ( 1u << a ) ) ) {
+            return true;
+        }
+    }
+    return false;
+}
+
+bool BotTeclaPressionada( const Bot *bot, int tecla ) {
+    for ( int a = 0; a < BOT_NUM_ACOES; a++ ) {
+        if ( bot->teclas[a] == tecla && ( bot->pressionadas & ( 1u << a ) ) ) {
+            return true;
+        }
+    }
+    return false;
+}
@@ -0,0 +1,429 @@
+/**
+ * @file cardume.c
+ * @brief Grade de vizinhança (counting sort), kernel de boids com SSE2 e
+ * desenho dos peixes.
+ * @copyright Copyright (c) 2025
+ */
+#include <stdbool.h>
+#include <stdlib.h>
+#include <math.h>
+
+#if defined(__SSE2__) || defined(_M_X64)
+#define CARDUME_SSE2
+#include <emmintrin.h>
+#endif
+
+#include "raylib/raylib.h"
+
+#include "cardume.h"
+#include "memoria.h"
+
+#define RAIO_SEPARACAO 16.0f
+#define PESO_SEPARACAO 900.0f
+#define PESO_ALINHAMENTO 1.2f
+#define PESO_COESAO 0.9f
+#define PESO_POLUICAO 60.0f
+#define PESO_BORDA 80.0f
+#define MARGEM_BORDA 120.0f
+#define VELOCIDADE_MINIMA 30.0f
+#define VELOCIDADE_MAXIMA 90.0f
+
+// peixes fora da câmera só recalculam a direção a cada N passos
+#define PASSOS_FORA_DA_TELA 4
+
+#define BLOCO_PARALELO 512
+
+static unsigned int sementeCardume = 1u;
+
+static float aleatorio01( void ) {
+    sementeCardume = sementeCardume * 1664525u + 1013904223u;
+    return ( sementeCardume >> 8 ) / 16777216.0f;
+}
+
+static int celulaDe( const Cardume *cardume, float x, float y ) {
+    int cx = (int)( x / CARDUME_CELULA );
+    int cy = (int)( y / CARDUME_CELULA );
+    if ( cx < 0 ) cx = 0;
+    if ( cy < 0 ) cy = 0;
+    if ( cx >= cardume->colunas ) cx = cardume->colunas - 1;
+    if ( cy >= cardume->linhas ) cy = cardume->linhas - 1;
+    return cy * cardume->colunas + cx;
+}
+
+void CardumeCriar( Cardume *cardume, int capacidade, float largura, float altura ) {
+
+    capacidade = ( capacidade + 3 ) & ~3;
+
+    float *bloco = (float*)MemoriaZerada( MEMORIA_CARDUME, (size_t)capacidade * 8, sizeof(float) );
+    cardume->x = bloco;
+    cardume->y = bloco + capacidade;
+    cardume->vx = bloco + capacidade * 2;
+    cardume->vy = bloco + capacidade * 3;
+    cardume->auxX = bloco + capacidade * 4;
+    cardume->auxY = bloco + capacidade * 5;
+    cardume->auxVx = bloco + capacidade * 6;
+    cardume->auxVy = bloco + capacidade * 7;
+    cardume->celulaDoPeixe = (int*)MemoriaAlocar( MEMORIA_CARDUME, sizeof(int) * capacidade );
+    cardume->bloco = bloco;
+
+    cardume->colunas = (int)ceilf( largura / CARDUME_CELULA );
+    cardume->linhas = (int)ceilf( altura / CARDUME_CELULA );
+    cardume->inicioCelula = (int*)MemoriaZerada( MEMORIA_CARDUME, cardume->colunas * cardume->linhas + 1, sizeof(int) );
+    cardume->poluicao = (float*)MemoriaZerada( MEMORIA_CARDUME, cardume->colunas * cardume->linhas, sizeof(float) );
+
+    cardume->quantidade = 0;
+    cardume->capacidade = capacidade;
+    cardume->largura = largura;
+    cardume->altura = altura;
+    cardume->passo = 0;
+
+}
+
+void CardumeDestruir( Cardume *cardume ) {
+    MemoriaLiberar( cardume->bloco );
+    MemoriaLiberar( cardume->celulaDoPeixe );
+    MemoriaLiberar( cardume->inicioCelula );
+    MemoriaLiberar( cardume->poluicao );
+    cardume->bloco = NULL;
+    cardume->x = NULL;
+    cardume->celulaDoPeixe = NULL;
+    cardume->inicioCelula = NULL;
+    cardume->poluicao = NULL;
+    cardume->quantidade = 0;
+    cardume->capacidade = 0;
+}
+
+void CardumeEspalhar( Cardume *cardume, int quantidade, unsigned int semente ) {
+
+    if ( quantidade > cardume->capacidade ) {
+        quantidade = cardume->capacidade;
+    }
+    sementeCardume = semente | 1u;
+
+    // grupos de ~50 peixes nadando na mesma direção
+    float centroX = 0;
+    float centroY = 0;
+    float direcao = 0;
+    for ( int i = 0; i < quantidade; i++ ) {
+        if ( i % 50 == 0 ) {
+            centroX = MARGEM_BORDA + aleatorio01() * ( cardume->largura - 2 * MARGEM_BORDA );
+            centroY = MARGEM_BORDA + aleatorio01() * ( cardume->altura - 2 * MARGEM_BORDA );
+            direcao = aleatorio01() * 2 * PI;
+        }
+        cardume->x[i] = centroX + ( aleatorio01() - 0.5f ) * 120.0f;
+        cardume->y[i] = centroY + ( aleatorio01() - 0.5f ) * 80.0f;
+        cardume->vx[i] = cosf( direcao ) * VELOCIDADE_MINIMA * 1.5f;
+        cardume->vy[i] = sinf( direcao ) * VELOCIDADE_MINIMA * 1.5f;
+    }
+
+    cardume->quantidade = quantidade;
+
+}
+
+void CardumeLimparPoluicao( Cardume *cardume ) {
+    for ( int c = 0; c < cardume->colunas * cardume->linhas; c++ ) {
+        cardume->poluicao[c] = 0;
+    }
+}
+
+void CardumeAdicionarPoluicao( Cardume *cardume, Vector2 pos, float peso ) {
+
+    // metade do peso vaza para as 8 vizinhas, para os peixes sentirem o
+    // lixo um pouco antes de chegar nele
+    int c = celulaDe( cardume, pos.x, pos.y );
+    int cx = c % cardume->colunas;
+    int cy = c / cardume->colunas;
+    for ( int ny = cy - 1; ny <= cy + 1; ny++ ) {
+        for ( int nx = cx - 1; nx <= cx + 1; nx++ ) {
+            if ( nx >= 0 && ny >= 0 && nx < cardume->colunas && ny < cardume->linhas ) {
+                cardume->poluicao[ny * cardume->colunas + nx] += ( nx == cx && ny == cy ) ? peso : peso * 0.5f;
+            }
+        }
+    }
+
+}
+
+/**
+ * @brief Counting sort dos peixes por célula. O estado ordenado vai para
+ * os buffers auxiliares e os ponteiros são trocados no final.
+ */
+static void ordenarPorCelula( Cardume *cardume ) {
+
+    int celulas = cardume->colunas * cardume->linhas;
+    int *inicio = cardume->inicioCelula;
+
+    for ( int c = 0; c <= celulas; c++ ) {
+        inicio[c] = 0;
+    }
+    for ( int i = 0; i < cardume->quantidade; i++ ) {
+        int c = celulaDe( cardume, cardume->x[i], cardume->y[i] );
+        cardume->celulaDoPeixe[i] = c;
+        inicio[c + 1]++;
+    }
+    for ( int c = 0; c < celulas; c++ ) {
+        inicio[c + 1] += inicio[c];
+    }
+
+    // inicio[c] avança durante a distribuição e depois é restaurado
+    for ( int i = 0; i < cardume->quantidade; i++ ) {
+        int destino = inicio[cardume->celulaDoPeixe[i]]++;
+        cardume->auxX[destino] = cardume->x[i];
+        cardume->auxY[destino] = cardume->y[i];
+        cardume->auxVx[destino] = cardume->vx[i];
+        cardume->auxVy[destino] = cardume->vy[i];
+    }
+    for ( int c = celulas; c > 0; c-- ) {
+        inicio[c] = inicio[c - 1];
+    }
+    inicio[0] = 0;
+
+    float *troca;
+    troca = cardume->x; cardume->x = cardume->auxX; cardume->auxX = troca;
+    troca = cardume->y; cardume->y = cardume->auxY; cardume->auxY = troca;
+    troca = cardume->vx; cardume->vx = cardume->auxVx; cardume->auxVx = troca;
+    troca = cardume->vy; cardume->vy = cardume->auxVy; cardume->auxVy = troca;
+
+}
+
+typedef struct PassoCardume {
+    Cardume *cardume;
+    float delta;
+    Rectangle visivel;
+} PassoCardume;
+
+/**
+ * @brief Soma a contribuição dos peixes [j0, j1) para o peixe em (xi, yi).
+ */
+static void acumularVizinhos( const Cardume *cardume, int j0, int j1, float xi, float yi,
+                              float *somas /* qtd, dx, dy, vx, vy, sepX, sepY */ ) {
+
+    const float raio2 = (float)CARDUME_CELULA * CARDUME_CELULA;
+    const float separacao2 = RAIO_SEPARACAO * RAIO_SEPARACAO;
+    int j = j0;
+
+#ifdef CARDUME_SSE2
+    __m128 vXi = _mm_set1_ps( xi );
+    __m128 vYi = _mm_set1_ps( yi );
+    __m128 vRaio2 = _mm_set1_ps( raio2 );
+    __m128 vSep2 = _mm_set1_ps( separacao2 );
+    __m128 vZero = _mm_setzero_ps();
+    __m128 vUm = _mm_set1_ps( 1.0f );
+    __m128 qtd = vZero, sx = vZero, sy = vZero, svx = vZero, svy = vZero, sepX = vZero, sepY = vZero;
+
+    for ( ; j + 4 <= j1; j += 4 ) {
+        __m128 dx = _mm_sub_ps( _mm_loadu_ps( cardume->x + j ), vXi );
+        __m128 dy = _mm_sub_ps( _mm_loadu_ps( cardume->y + j ), vYi );
+        __m128 d2 = _mm_add_ps( _mm_mul_ps( dx, dx ), _mm_mul_ps( dy, dy ) );
+        __m128 ve = _mm_and_ps( _mm_cmplt_ps( d2, vRaio2 ), _mm_cmpgt_ps( d2, vZero ) );
+        __m128 perto = _mm_and_ps( ve, _mm_cmplt_ps( d2, vSep2 ) );
+
+        qtd = _mm_add_ps( qtd, _mm_and_ps( ve, vUm ) );
+        sx = _mm_add_ps( sx, _mm_and_ps( ve, dx ) );
+        sy = _mm_add_ps( sy, _mm_and_ps( ve, dy ) );
+        svx = _mm_add_ps( svx, _mm_and_ps( ve, _mm_loadu_ps( cardume->vx + j ) ) );
+        svy = _mm_add_ps( svy, _mm_and_ps( ve, _mm_loadu_ps( cardume->vy + j ) ) );
+
+        // afasta na direção oposta, mais forte quanto mais perto
+        __m128 inverso = _mm_div_ps( vUm, _mm_or_ps( _mm_and_ps( perto, d2 ), _mm_andnot_ps( perto, vUm ) ) );
+        sepX = _mm_sub_ps( sepX, _mm_and_ps( perto, _mm_mul_ps( dx, inverso ) ) );
+        sepY = _mm_sub_ps( sepY, _mm_and_ps( perto, _mm_mul_ps( dy, inverso ) ) );
+    }
+
+    float parcial[7][4];
+    _mm_storeu_ps( parcial[0], qtd );
+    _mm_storeu_ps( parcial[1], sx );
+    _mm_storeu_ps( parcial[2], sy );
+    _mm_storeu_ps( parcial[3], svx );
+    _mm_storeu_ps( parcial[4], svy );
+    _mm_storeu_ps( parcial[5], sepX );
+    _mm_storeu_ps( parcial[6], sepY );
+    for ( int s = 0; s < 7; s++ ) {
+        somas[s] += parcial[s][0] + parcial[s][1] + parcial[s][2] + parcial[s][3];
+    }
+#endif
+
+    for ( ; j < j1; j++ ) {
+        float dx = cardume->x[j] - xi;
+        float dy = cardume->y[j] - yi;
+        float d2 = dx * dx + dy * dy;
+        if ( d2 <= 0 || d2 >= raio2 ) {
+            continue;
+        }
+        somas[0] += 1;
+        somas[1] += dx;
+        somas[2] += dy;
+        somas[3] += cardume->vx[j];
+        somas[4] += cardume->vy[j];
+        if ( d2 < separacao2 ) {
+            somas[5] -= dx / d2;
+            somas[6] -= dy / d2;
+        }
+    }
+
+}
+
+static void direcionarIntervalo( void *contexto, int inicio, int fim ) {
+
+    PassoCardume *passo = (PassoCardume*)contexto;
+    Cardume *cardume = passo->cardume;
+    Rectangle v = passo->visivel;
+
+    for ( int i = inicio; i < fim; i++ ) {
+
+        float xi = cardume->x[i];
+        float yi = cardume->y[i];
+        float vxi = cardume->vx[i];
+        float vyi = cardume->vy[i];
+
+        bool naTela = xi >= v.x && yi >= v.y && xi <= v.x + v.width && yi <= v.y + v.height;
+        if ( !naTela && ( i + cardume->passo ) % PASSOS_FORA_DA_TELA != 0 ) {
+            cardume->auxVx[i] = vxi;
+            cardume->auxVy[i] = vyi;
+            continue;
+        }
+
+        int c = cardume->celulaDoPeixe[i];
+        int cx = c % cardume->colunas;
+        int cy = c / cardume->colunas;
+
+        float somas[7] = { 0 };
+        for ( int ny = cy - 1; ny <= cy + 1; ny++ ) {
+            if ( ny < 0 || ny >= cardume->linhas ) {
+                continue;
+            }
+            // as 3 células vizinhas de uma linha são contíguas na ordenação
+            int esquerda = cx > 0 ? cx - 1 : cx;
+            int direita = cx < cardume->colunas - 1 ? cx + 1 : cx;
+            int j0 = cardume->inicioCelula[ny * cardume->colunas + esquerda];
+            int j1 = cardume->inicioCelula[ny * cardume->colunas + direita + 1];
+            acumularVizinhos( cardume, j0, j1, xi, yi, somas );
+        }
+
+        float ax = 0;
+        float ay = 0;
+        if ( somas[0] > 0 ) {
+            float inv = 1.0f / somas[0];
+            ax += somas[1] * inv * PESO_COESAO;
+            ay += somas[2] * inv * PESO_COESAO;
+            ax += ( somas[3] * inv - vxi ) * PESO_ALINHAMENTO;
+            ay += ( somas[4] * inv - vyi ) * PESO_ALINHAMENTO;
+        }
+        ax += somas[5] * PESO_SEPARACAO;
+        ay += somas[6] * PESO_SEPARACAO;
+
+        // foge do lixo: desce o gradiente da poluição entre as células vizinhas
+        float pEsq = cx > 0 ? cardume->poluicao[c - 1] : 0;
+        float pDir = cx < cardume->colunas - 1 ? cardume->poluicao[c + 1] : 0;
+        float pCima = cy > 0 ? cardume->poluicao[c - cardume->colunas] : 0;
+        float pBaixo = cy < cardume->linhas - 1 ? cardume->poluicao[c + cardume->colunas] : 0;
+        ax -= ( pDir - pEsq ) * PESO_POLUICAO;
+        ay -= ( pBaixo - pCima ) * PESO_POLUICAO;
+
+        // volta para dentro do mapa
+        if ( xi < MARGEM_BORDA ) ax += PESO_BORDA;
+        if ( xi > cardume->largura - MARGEM_BORDA ) ax -= PESO_BORDA;
+        if ( yi < MARGEM_BORDA ) ay += PESO_BORDA;
+        if ( yi > cardume->altura - MARGEM_BORDA ) ay -= PESO_BORDA;
+
+        // com as checagens intercaladas, o peixe fora da tela vira mais de uma vez
+        float fator = naTela ? 1.0f : (float)PASSOS_FORA_DA_TELA;
+        vxi += ax * passo->delta * fator;
+        vyi += ay * passo->delta * fator;
+
+        // peixes em água suja nadam mais rápido para sair dela
+        float maxima = VELOCIDADE_MAXIMA * ( 1.0f + 0.5f * fminf( cardume->poluicao[c], 2.0f ) );
+        float velocidade = sqrtf( vxi * vxi + vyi * vyi );
+        if ( velocidade > maxima ) {
+            vxi *= maxima / velocidade;
+            vyi *= maxima / velocidade;
+        } else if ( velocidade < VELOCIDADE_MINIMA && velocidade > 0 ) {
+            vxi *= VELOCIDADE_MINIMA / velocidade;
+            vyi *= VELOCIDADE_MINIMA / velocidade;
+        }
+
+        cardume->auxVx[i] = vxi;
+        cardume->auxVy[i] = vyi;
+
+    }
+
+}
+
+static void moverIntervalo( void *contexto, int inicio, int fim ) {
+
+    PassoCardume *passo = (PassoCardume*)contexto;
+    Cardume *cardume = passo->cardume;
+    int i = inicio;
+
+#ifdef CARDUME_SSE2
+    __m128 vDelta = _mm_set1_ps( passo->delta );
+    __m128 vZero = _mm_setzero_ps();
+    __m128 vLargura = _mm_set1_ps( cardume->largura - 1 );
+    __m128 vAltura = _mm_set1_ps( cardume->altura - 1 );
+    for ( ; i + 4 <= fim; i += 4 ) {
+        __m128 vx = _mm_loadu_ps( cardume->auxVx + i );
+        __m128 vy = _mm_loadu_ps( cardume->auxVy + i );
+        __m128 x = _mm_add_ps( _mm_loadu_ps( cardume->x + i ), _mm_mul_ps( vx, vDelta ) );
+        __m128 y = _mm_add_ps( _mm_loadu_ps( cardume->y + i ), _mm_mul_ps( vy, vDelta ) );
+        _mm_storeu_ps( cardume->x + i, _mm_min_ps( _mm_max_ps( x, vZero ), vLargura ) );
+        _mm_storeu_ps( cardume->y + i, _mm_min_ps( _mm_max_ps( y, vZero ), vAltura ) );
+        _mm_storeu_ps( cardume->vx + i, vx );
+        _mm_storeu_ps( cardume->vy + i, vy );
+    }
+#endif
+
+    for ( ; i < fim; i++ ) {
+        cardume->vx[i] = cardume->auxVx[i];
+        cardume->vy[i] = cardume->auxVy[i];
+        cardume->x[i] = fminf( fmaxf( cardume->x[i] + cardume->vx[i] * passo->delta, 0 ), cardume->largura - 1 );
+        cardume->y[i] = fminf( fmaxf( cardume->y[i] + cardume->vy[i] * passo->delta, 0 ), cardume->altura - 1 );
+    }
+
+}
+
+void CardumeAtualizar( Cardume *cardume, float delta, Rectangle visivel, PoolTarefas *pool ) {
+
+    if ( cardume->quantidade == 0 ) {
+        return;
+    }
+
+    PassoCardume passo = { cardume, delta, visivel };
+
+    ordenarPorCelula( cardume );
+    ParaleloPara( pool, cardume->quantidade, BLOCO_PARALELO, direcionarIntervalo, &passo );
+    ParaleloPara( pool, cardume->quantidade, BLOCO_PARALELO, moverIntervalo, &passo );
+
+    cardume->passo++;
+
+}
+
+void CardumeDesenhar( const Cardume *cardume, Texture2D sprite, Rectangle visivel ) {
+
+    Rectangle source = { 0, 0, (float)sprite.width, (float)sprite.height };
+    Vector2 origin = { sprite.width / 2.0f, sprite.height / 2.0f };
+
+    // os peixes estão ordenados por célula: só as linhas de células
+    // visíveis precisam ser percorridas
+    int cy0 = (int)( visivel.y / CARDUME_CELULA ) - 1;
+    int cy1 = (int)( ( visivel.y + visivel.height ) / CARDUME_CELULA ) + 1;
+    if ( cy0 < 0 ) cy0 = 0;
+    if ( cy1 >= cardume->linhas ) cy1 = cardume->linhas - 1;
+
+    int j0 = cardume->inicioCelula[cy0 * cardume->colunas];
+    int j1 = cardume->inicioCelula[( cy1 + 1 ) * cardume->colunas];
+
+    for ( int i = j0; i < j1; i++ ) {
+
+        float x = cardume->x[i];
+        float y = cardume->y[i];
+        if ( x < visivel.x - sprite.width || x > visivel.x + visivel.width + sprite.width ||
+             y < visivel.y - sprite.height || y > visivel.y + visivel.height + sprite.height ) {
+            continue;
+        }
+
+        float angulo = atan2f( cardume->vy[i], cardume->vx[i] ) * RAD2DEG;
+        Rectangle dest = { x, y, (float)sprite.width, (float)sprite.height };
+        DrawTexturePro( sprite, source, dest, origin, angulo, WHITE );
+
+    }
+
+}
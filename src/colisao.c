@@ -0,0 +1,175 @@
+/**
+ * @file colisao.c
+ * @brief Kernels de colisão AABB em lote (AVX2, SSE2 e escalar).
+ * @copyright Copyright (c) 2025
+ */
+#include <stdlib.h>
+#include <float.h>
+
+#if defined(__AVX2__)
+#define COLISAO_AVX2
+#include <immintrin.h>
+#elif defined(__SSE2__) || defined(_M_X64)
+#define COLISAO_SSE2
+#include <emmintrin.h>
+#endif
+
+#include "raylib/raylib.h"
+
+#include "colisao.h"
+#include "memoria.h"
+
+void LoteAABBCriar( LoteAABB *lote, int capacidade ) {
+
+    capacidade = ( capacidade + 7 ) & ~7;
+    if ( capacidade == 0 ) {
+        capacidade = 8;
+    }
+
+    float *bloco = (float*)MemoriaAlocar( MEMORIA_COLISAO, sizeof(float) * capacidade * 4 );
+    lote->minX = bloco;
+    lote->minY = bloco + capacidade;
+    lote->maxX = bloco + capacidade * 2;
+    lote->maxY = bloco + capacidade * 3;
+    lote->quantidade = 0;
+    lote->capacidade = capacidade;
+
+    for ( int i = 0; i < capacidade; i++ ) {
+        LoteAABBDesativar( lote, i );
+    }
+
+}
+
+void LoteAABBDestruir( LoteAABB *lote ) {
+    MemoriaLiberar( lote->minX );
+    lote->minX = NULL;
+    lote->quantidade = 0;
+    lote->capacidade = 0;
+}
+
+void LoteAABBDefinir( LoteAABB *lote, int indice, Rectangle rec ) {
+    lote->minX[indice] = rec.x;
+    lote->minY[indice] = rec.y;
+    lote->maxX[indice] = rec.x + rec.width;
+    lote->maxY[indice] = rec.y + rec.height;
+    if ( indice >= lote->quantidade ) {
+        lote->quantidade = indice + 1;
+    }
+}
+
+void LoteAABBDesativar( LoteAABB *lote, int indice ) {
+    // caixa "invertida": nenhuma comparação do teste passa
+    lote->minX[indice] = FLT_MAX;
+    lote->minY[indice] = FLT_MAX;
+    lote->maxX[indice] = -FLT_MAX;
+    lote->maxY[indice] = -FLT_MAX;
+}
+
+void ColisaoLoteMascara( Rectangle rec, const LoteAABB *lote, unsigned int *mascara ) {
+
+    float rMinX = rec.x;
+    float rMinY = rec.y;
+    float rMaxX = rec.x + rec.width;
+    float rMaxY = rec.y + rec.height;
+
+    // blocos de 8 itens (a capacidade é múltipla de 8)
+    int blocos = ( lote->quantidade + 7 ) / 8;
+    int palavras = ( lote->quantidade + 31 ) / 32;
+    for ( int p = 0; p < palavras; p++ ) {
+        mascara[p] = 0;
+    }
+
+#if defined(COLISAO_AVX2)
+    __m256 vMinX = _mm256_set1_ps( rMinX );
+    __m256 vMinY = _mm256_set1_ps( rMinY );
+    __m256 vMaxX = _mm256_set1_ps( rMaxX );
+    __m256 vMaxY = _mm256_set1_ps( rMaxY );
+    for ( int b = 0; b < blocos; b++ ) {
+        int i = b * 8;
+        __m256 c = _mm256_and_ps(
+            _mm256_and_ps( _mm256_cmp_ps( vMinX, _mm256_loadu_ps( lote->maxX + i ), _CMP_LT_OQ ),
+                           _mm256_cmp_ps( vMaxX, _mm256_loadu_ps( lote->minX + i ), _CMP_GT_OQ ) ),
+            _mm256_and_ps( _mm256_cmp_ps( vMinY, _mm256_loadu_ps( lote->maxY + i ), _CMP_LT_OQ ),
+                           _mm256_cmp_ps( vMaxY, _mm256_loadu_ps( lote->minY + i ), _CMP_GT_OQ ) ) );
+        mascara[i / 32] |= (unsigned int)_mm256_movemask_ps( c ) << ( i % 32 );
+    }
+#elif defined(COLISAO_SSE2)
+    __m128 vMinX = _mm_set1_ps( rMinX );
+    __m128 vMinY = _mm_set1_ps( rMinY );
+    __m128 vMaxX = _mm_set1_ps( rMaxX );
+    __m128 vMaxY = _mm_set1_ps( rMaxY );
+    for ( int b = 0; b < blocos * 2; b++ ) {
+        int i = b * 4;
+        __m128 c = _mm_and_ps(
+            _mm_and_ps( _mm_cmplt_ps( vMinX, _mm_loadu_ps( lote->maxX + i ) ),
+                        _mm_cmpgt_ps( vMaxX, _mm_loadu_ps( lote->minX + i ) ) ),
+            _mm_and_ps( _mm_cmplt_ps( vMinY, _mm_loadu_ps( lote->maxY + i ) ),
+                        _mm_cmpgt_ps( vMaxY, _mm_loadu_ps( lote->minY + i ) ) ) );
+        mascara[i / 32] |= (unsigned int)_mm_movemask_ps( c ) << ( i % 32 );
+    }
+#else
+    for ( int i = 0; i < blocos * 8; i++ ) {
+        if ( rMinX < lote->maxX[i] && rMaxX > lote->minX[i] &&
+             rMinY < lote->maxY[i] && rMaxY > lote->minY[i] ) {
+            mascara[i / 32] |= 1u << ( i % 32 );
+        }
+    }
+#endif
+
+    // os itens depois de quantidade no último bloco não contam
+    if ( lote->quantidade % 32 != 0 ) {
+        mascara[palavras - 1] &= ( 1u << ( lote->quantidade % 32 ) ) - 1;
+    }
+
+}
+
+int ColisaoLoteIndices( Rectangle rec, const LoteAABB *lote, int *indices, int maxIndices ) {
+
+    unsigned int mascara[64];
+    int n = 0;
+
+    // processa em trechos de 64 palavras para não precisar de memória extra
+    for ( int inicio = 0; inicio < lote->quantidade; inicio += 64 * 32 ) {
+
+        LoteAABB trecho = {
+            lote->minX + inicio, lote->minY + inicio, lote->maxX + inicio, lote->maxY + inicio,
+            lote->quantidade - inicio < 64 * 32 ? lote->quantidade - inicio : 64 * 32,
+            0
+        };
+        ColisaoLoteMascara( rec, &trecho, mascara );
+
+        int palavras = ( trecho.quantidade + 31 ) / 32;
+        for ( int p = 0; p < palavras; p++ ) {
+            unsigned int bits = mascara[p];
+            while ( bits != 0 ) {
+#if defined(__GNUC__)
+                int b = __builtin_ctz( bits );
+#else
+                int b = 0;
+                while ( !( bits & ( 1u << b ) ) ) {
+                    b++;
+                }
+#endif
+                if ( n == maxIndices ) {
+                    return n;
+                }
+                indices[n++] = inicio + p * 32 + b;
+                bits &= bits - 1;
+            }
+        }
+
+    }
+
+    return n;
+
+}
+
+const char *ColisaoCaminhoSimd( void ) {
+#if defined(COLISAO_AVX2)
+    return "AVX2";
+#elif defined(COLISAO_SSE2)
+    return "SSE2";
+#else
+    return "escalar";
+#endif
+}
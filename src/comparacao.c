@@ -0,0 +1,81 @@
+/**
+ * @file comparacao.c
+ * @brief Diferença perceptual (YIQ) entre imagens RGBA8.
+ * @copyright Copyright (c) 2025
+ */
+#include <math.h>
+#include <stdbool.h>
+#include <stddef.h>
+
+#include "comparacao.h"
+
+#define DELTA_MAXIMO 35215.0f // maior delta possível entre duas cores
+
+// cor sobre fundo branco
+static void comporSobreBranco( const uint8_t *p, float *r, float *g, float *b ) {
+    float a = p[3] / 255.0f;
+    *r = 255.0f + ( p[0] - 255.0f ) * a;
+    *g = 255.0f + ( p[1] - 255.0f ) * a;
+    *b = 255.0f + ( p[2] - 255.0f ) * a;
+}
+
+static float brilho( float r, float g, float b ) {
+    return r * 0.29889531f + g * 0.58662247f + b * 0.11448223f;
+}
+
+// quadrado da distância em YIQ, com o brilho pesando mais
+static float deltaPixel( const uint8_t *a, const uint8_t *b ) {
+
+    float r1, g1, b1, r2, g2, b2;
+    comporSobreBranco( a, &r1, &g1, &b1 );
+    comporSobreBranco( b, &r2, &g2, &b2 );
+
+    float y = brilho( r1, g1, b1 ) - brilho( r2, g2, b2 );
+    float i = ( r1 * 0.59597799f - g1 * 0.27417610f - b1 * 0.32180189f ) -
+              ( r2 * 0.59597799f - g2 * 0.27417610f - b2 * 0.32180189f );
+    float q = ( r1 * 0.21147017f - g1 * 0.52261711f + b1 * 0.31114694f ) -
+              ( r2 * 0.21147017f - g2 * 0.52261711f + b2 * 0.31114694f );
+    return 0.5053f * y * y + 0.299f * i * i + 0.1957f * q * q;
+
+}
+
+ResultadoComparacao CompararImagens( const uint8_t *referencia, const uint8_t *imagem, int largura, int altura,
+                                     float limiar, uint8_t *mapa ) {
+
+    ResultadoComparacao resultado = { 0 };
+    float deltaLimite = DELTA_MAXIMO * limiar * limiar;
+    float maior = 0;
+    int total = largura * altura;
+
+    for ( int i = 0; i < total; i++ ) {
+
+        const uint8_t *a = referencia + i * 4;
+        float delta = deltaPixel( a, imagem + i * 4 );
+        bool diferente = delta > deltaLimite;
+        resultado.diferentes += diferente;
+        if ( delta > maior ) {
+            maior = delta;
+        }
+
+        if ( mapa != NULL ) {
+            uint8_t *m = mapa + i * 4;
+            if ( diferente ) {
+                m[0] = 255;
+                m[1] = 0;
+                m[2] = 0;
+            } else {
+                float r, g, b;
+                comporSobreBranco( a, &r, &g, &b );
+                uint8_t cinza = (uint8_t)( 255.0f - ( 255.0f - brilho( r, g, b ) ) * 0.1f );
+                m[0] = m[1] = m[2] = cinza;
+            }
+            m[3] = 255;
+        }
+
+    }
+
+    resultado.fracao = total > 0 ? (float)resultado.diferentes / total : 0;
+    resultado.maiorDelta = sqrtf( maior / DELTA_MAXIMO );
+    return resultado;
+
+}
@@ -0,0 +1,221 @@
+/**
+ * @file correntes.c
+ * @brief Campo de correntes e integração vetorizada da deriva do lixo.
+ * @copyright Copyright (c) 2025
+ */
+#include <stdlib.h>
+#include <math.h>
+
+#if defined(__SSE2__) || defined(_M_X64)
+#define CORRENTES_SSE2
+#include <emmintrin.h>
+#endif
+
+#include "raylib/raylib.h"
+
+#include "correntes.h"
+#include "memoria.h"
+
+// quão rápido o item passa a seguir a água (1/s)
+#define DERIVA_ARRASTO 1.5f
+
+// itens por passo: a corrente do bloco é amostrada antes da integração
+#define DERIVA_BLOCO 256
+
+void CampoCorrenteGerar( CampoCorrente *campo, float largura, float altura, float forca, unsigned int semente ) {
+
+    campo->largura = largura;
+    campo->altura = altura;
+
+    // fases "aleatórias" a partir da semente para cada mapa ter seu padrão
+    float fase1 = ( semente % 628 ) / 100.0f;
+    float fase2 = ( ( semente / 628 ) % 628 ) / 100.0f;
+
+    for ( int l = 0; l < CORRENTE_LINHAS; l++ ) {
+        for ( int c = 0; c < CORRENTE_COLUNAS; c++ ) {
+
+            float u = (float)c / ( CORRENTE_COLUNAS - 1 );
+            float v = (float)l / ( CORRENTE_LINHAS - 1 );
+
+            // derivadas de uma função de fluxo: a água gira em redemoinhos
+            // largos em vez de empurrar tudo para o mesmo lado
+            float dpsiDy = cosf( v * 6.0f + fase1 ) * sinf( u * 4.0f + fase2 ) * 6.0f
+                         + cosf( v * 11.0f + fase2 ) * 0.5f * 11.0f;
+            float dpsiDx = sinf( v * 6.0f + fase1 ) * cosf( u * 4.0f + fase2 ) * 4.0f
+                         - sinf( u * 9.0f + fase1 ) * 0.5f * 9.0f;
+
+            // correntes mais fortes perto da superfície
+            float profundidade = 1.0f - 0.6f * v;
+
+            campo->vx[l * CORRENTE_COLUNAS + c] = dpsiDy / 11.5f * forca * profundidade;
+            campo->vy[l * CORRENTE_COLUNAS + c] = -dpsiDx / 11.5f * forca * profundidade * 0.4f;
+
+        }
+    }
+
+}
+
+Vector2 CampoCorrenteAmostrar( const CampoCorrente *campo, float x, float y ) {
+
+    float gx = x / campo->largura * ( CORRENTE_COLUNAS - 1 );
+    float gy = y / campo->altura * ( CORRENTE_LINHAS - 1 );
+    if ( gx < 0 ) gx = 0;
+    if ( gy < 0 ) gy = 0;
+    if ( gx > CORRENTE_COLUNAS - 1.001f ) gx = CORRENTE_COLUNAS - 1.001f;
+    if ( gy > CORRENTE_LINHAS - 1.001f ) gy = CORRENTE_LINHAS - 1.001f;
+
+    int c = (int)gx;
+    int l = (int)gy;
+    float fx = gx - c;
+    float fy = gy - l;
+
+    int i00 = l * CORRENTE_COLUNAS + c;
+    int i10 = i00 + 1;
+    int i01 = i00 + CORRENTE_COLUNAS;
+    int i11 = i01 + 1;
+
+    float w00 = ( 1 - fx ) * ( 1 - fy );
+    float w10 = fx * ( 1 - fy );
+    float w01 = ( 1 - fx ) * fy;
+    float w11 = fx * fy;
+
+    return (Vector2){
+        campo->vx[i00] * w00 + campo->vx[i10] * w10 + campo->vx[i01] * w01 + campo->vx[i11] * w11,
+        campo->vy[i00] * w00 + campo->vy[i10] * w10 + campo->vy[i01] * w01 + campo->vy[i11] * w11
+    };
+
+}
+
+void DerivaCriar( Deriva *deriva, int capacidade, float xMaximo, float yMaximo ) {
+
+    capacidade = ( capacidade + 3 ) & ~3;
+
+    float *bloco = (float*)MemoriaZerada( MEMORIA_CORRENTES, (size_t)capacidade * 5, sizeof(float) );
+    deriva->x = bloco;
+    deriva->y = bloco + capacidade;
+    deriva->vx = bloco + capacidade * 2;
+    deriva->vy = bloco + capacidade * 3;
+    deriva->afundamento = bloco + capacidade * 4;
+    deriva->quantidade = 0;
+    deriva->capacidade = capacidade;
+    deriva->xMaximo = xMaximo;
+    deriva->yMaximo = yMaximo;
+
+}
+
+void DerivaDestruir( Deriva *deriva ) {
+    MemoriaLiberar( deriva->x );
+    deriva->x = NULL;
+    deriva->quantidade = 0;
+    deriva->capacidade = 0;
+}
+
+void DerivaDefinir( Deriva *deriva, int indice, Vector2 pos, float afundamento ) {
+    deriva->x[indice] = pos.x;
+    deriva->y[indice] = pos.y;
+    deriva->vx[indice] = 0;
+    deriva->vy[indice] = 0;
+    deriva->afundamento[indice] = afundamento;
+    if ( indice >= deriva->quantidade ) {
+        deriva->quantidade = indice + 1;
+    }
+}
+
+typedef struct PassoDeriva {
+    Deriva *deriva;
+    const CampoCorrente *campo;
+    float intensidade;
+    float delta;
+} PassoDeriva;
+
+static void integrarIntervalo( void *contexto, int inicio, int fim ) {
+
+    PassoDeriva *passo = (PassoDeriva*)contexto;
+    Deriva *d = passo->deriva;
+    float relaxamento = DERIVA_ARRASTO * passo->delta;
+    if ( relaxamento > 1 ) {
+        relaxamento = 1;
+    }
+
+    float agua[2][DERIVA_BLOCO];
+
+    for ( int b = inicio; b < fim; b += DERIVA_BLOCO ) {
+
+        int n = fim - b < DERIVA_BLOCO ? fim - b : DERIVA_BLOCO;
+
+        // 1) amostra a corrente de cada item (acesso indireto, escalar)
+        for ( int k = 0; k < n; k++ ) {
+            Vector2 c = CampoCorrenteAmostrar( passo->campo, d->x[b + k], d->y[b + k] );
+            agua[0][k] = c.x * passo->intensidade;
+            agua[1][k] = c.y * passo->intensidade;
+        }
+
+        // 2) integra o bloco: v += (agua + afundamento - v) * relaxamento,
+        //    p += v * delta, depois prende no leito e nas laterais
+        int k = 0;
+#ifdef CORRENTES_SSE2
+        __m128 vRelax = _mm_set1_ps( relaxamento );
+        __m128 vDelta = _mm_set1_ps( passo->delta );
+        __m128 vZero = _mm_setzero_ps();
+        __m128 vXMax = _mm_set1_ps( d->xMaximo );
+        __m128 vYMax = _mm_set1_ps( d->yMaximo );
+        for ( ; k + 4 <= n; k += 4 ) {
+            int i = b + k;
+            __m128 vx = _mm_loadu_ps( d->vx + i );
+            __m128 vy = _mm_loadu_ps( d->vy + i );
+            __m128 alvoX = _mm_loadu_ps( agua[0] + k );
+            __m128 alvoY = _mm_add_ps( _mm_loadu_ps( agua[1] + k ), _mm_loadu_ps( d->afundamento + i ) );
+            vx = _mm_add_ps( vx, _mm_mul_ps( _mm_sub_ps( alvoX, vx ), vRelax ) );
+            vy = _mm_add_ps( vy, _mm_mul_ps( _mm_sub_ps( alvoY, vy ), vRelax ) );
+            __m128 x = _mm_add_ps( _mm_loadu_ps( d->x + i ), _mm_mul_ps( vx, vDelta ) );
+            __m128 y = _mm_add_ps( _mm_loadu_ps( d->y + i ), _mm_mul_ps( vy, vDelta ) );
+
+            // no leito o item para de vez
+            __m128 noFundo = _mm_cmpge_ps( y, vYMax );
+            vx = _mm_andnot_ps( noFundo, vx );
+            vy = _mm_andnot_ps( noFundo, vy );
+            y = _mm_min_ps( y, vYMax );
+            x = _mm_min_ps( _mm_max_ps( x, vZero ), vXMax );
+            y = _mm_max_ps( y, vZero );
+
+            _mm_storeu_ps( d->vx + i, vx );
+            _mm_storeu_ps( d->vy + i, vy );
+            _mm_storeu_ps( d->x + i, x );
+            _mm_storeu_ps( d->y + i, y );
+        }
+#endif
+        for ( ; k < n; k++ ) {
+            int i = b + k;
+            d->vx[i] += ( agua[0][k] - d->vx[i] ) * relaxamento;
+            d->vy[i] += ( agua[1][k] + d->afundamento[i] - d->vy[i] ) * relaxamento;
+            d->x[i] += d->vx[i] * passo->delta;
+            d->y[i] += d->vy[i] * passo->delta;
+            if ( d->y[i] >= d->yMaximo ) {
+                d->y[i] = d->yMaximo;
+                d->vx[i] = 0;
+                d->vy[i] = 0;
+            }
+            d->x[i] = fminf( fmaxf( d->x[i], 0 ), d->xMaximo );
+            d->y[i] = fmaxf( d->y[i], 0 );
+        }
+
+    }
+
+}
+
+void DerivaIntegrar( Deriva *deriva, const CampoCorrente *campo, float intensidade, float delta, PoolTarefas *pool ) {
+
+    PassoDeriva passo = { deriva, campo, intensidade, delta };
+
+    if ( pool == NULL || deriva->quantidade < DERIVA_MINIMO_PARALELO ) {
+        integrarIntervalo( &passo, 0, deriva->quantidade );
+        return;
+    }
+
+    // blocos múltiplos de DERIVA_BLOCO, uns 4 por thread
+    int threads = PoolTarefasThreads( pool );
+    int bloco = deriva->quantidade / ( threads * 4 );
+    bloco = ( bloco / DERIVA_BLOCO + 1 ) * DERIVA_BLOCO;
+    ParaleloPara( pool, deriva->quantidade, bloco, integrarIntervalo, &passo );
+
+}
@@ -0,0 +1,292 @@
+/**
+ * @file entrada.c
+ * @brief Leitura dos dispositivos, troca de teclas e anel de eventos.
+ * @copyright Copyright (c) 2025
+ */
+#include <math.h>
+#include <stdio.h>
+#include <string.h>
+
+#include "entrada.h"
+#include "plataforma.h"
+#include "rede.h"
+
+#define BITS_SEGURADOS ( REDE_ESQUERDA | REDE_DIREITA | REDE_CIMA | REDE_BAIXO | REDE_PEGAR | REDE_DESCARTAR )
+
+// um layout de teclado por jogador, para quem nao tem controle
+static const ControlesJogador TECLADO_PADRAO[ENTRADA_MAX_JOGADORES] = {
+    { KEY_A, KEY_D, KEY_W, KEY_S, KEY_E, KEY_Q },
+    { KEY_J, KEY_L, KEY_I, KEY_K, KEY_O, KEY_U },
+    { KEY_LEFT, KEY_RIGHT, KEY_UP, KEY_DOWN, KEY_RIGHT_CONTROL, KEY_RIGHT_SHIFT },
+    { KEY_KP_4, KEY_KP_6, KEY_KP_8, KEY_KP_5, KEY_KP_9, KEY_KP_7 }
+};
+
+static const int ATALHOS_PADRAO[NUM_ATALHOS] = {
+    [ATALHO_UM_JOGADOR]       = KEY_ONE,
+    [ATALHO_DOIS_JOGADORES]   = KEY_TWO,
+    [ATALHO_TRES_JOGADORES]   = KEY_THREE,
+    [ATALHO_QUATRO_JOGADORES] = KEY_FOUR,
+    [ATALHO_SALVAR]           = KEY_F5,
+    [ATALHO_CARREGAR]         = KEY_F9,
+    [ATALHO_GANHAR]           = KEY_G,
+    [ATALHO_PERDER]           = KEY_P
+};
+
+static const char *NOMES_ATALHOS[NUM_ATALHOS] = {
+    "1", "2", "3", "4", "salvar", "carregar", "ganhar", "perder"
+};
+
+// na ordem dos bits REDE_ESQUERDA ... REDE_DESCARTAR
+static const char *NOMES_ACOES[] = {
+    "esquerda", "direita", "cima", "baixo", "pegar", "descartar"
+};
+
+static int *teclaDaAcao( ControlesJogador *c, int acao ) {
+    switch ( acao ) {
+        case 0: return &c->esquerda;
+        case 1: return &c->direita;
+        case 2: return &c->cima;
+        case 3: return &c->baixo;
+        case 4: return &c->pegar;
+        default: return &c->descartar;
+    }
+}
+
+static bool teclaSegurada( const Entrada *entrada, int tecla ) {
+
+    if ( entrada->fonte != NULL ) {
+        return entrada->fonte( tecla, false );
+    }
+    if ( tecla >= TECLA_CONTROLE_BASE ) {
+        int gamepad = ( tecla - TECLA_CONTROLE_BASE ) / 32;
+        int botao = ( tecla - TECLA_CONTROLE_BASE ) % 32;
+
+        // o direcional tambem aceita o analogico esquerdo
+        float eixoX = GetGamepadAxisMovement( gamepad, GAMEPAD_AXIS_LEFT_X );
+        float eixoY = GetGamepadAxisMovement( gamepad, GAMEPAD_AXIS_LEFT_Y );
+        switch ( botao ) {
+            case GAMEPAD_BUTTON_LEFT_FACE_LEFT: if ( eixoX < -ENTRADA_EIXO_MORTO ) return true; break;
+            case GAMEPAD_BUTTON_LEFT_FACE_RIGHT: if ( eixoX > ENTRADA_EIXO_MORTO ) return true; break;
+            case GAMEPAD_BUTTON_LEFT_FACE_UP: if ( eixoY < -ENTRADA_EIXO_MORTO ) return true; break;
+            case GAMEPAD_BUTTON_LEFT_FACE_DOWN: if ( eixoY > ENTRADA_EIXO_MORTO ) return true; break;
+            default: break;
+        }
+        return IsGamepadButtonDown( gamepad, botao );
+    }
+    return IsKeyDown( tecla );
+
+}
+
+static bool teclaPressionada( const Entrada *entrada, int tecla ) {
+
+    if ( entrada->fonte != NULL ) {
+        return entrada->fonte( tecla, true );
+    }
+    if ( tecla >= TECLA_CONTROLE_BASE ) {
+        return IsGamepadButtonPressed( ( tecla - TECLA_CONTROLE_BASE ) / 32, ( tecla - TECLA_CONTROLE_BASE ) % 32 );
+    }
+    return IsKeyPressed( tecla );
+
+}
+
+static uint8_t lerJogador( const Entrada *entrada, const ControlesJogador *c, uint8_t anterior ) {
+    uint8_t bits = 0;
+    if ( teclaSegurada( entrada, c->esquerda ) ) bits |= REDE_ESQUERDA;
+    if ( teclaSegurada( entrada, c->direita ) ) bits |= REDE_DIREITA;
+    if ( teclaSegurada( entrada, c->cima ) ) bits |= REDE_CIMA;
+    if ( teclaSegurada( entrada, c->baixo ) ) bits |= REDE_BAIXO;
+    if ( teclaSegurada( entrada, c->pegar ) ) bits |= REDE_PEGAR;
+    if ( teclaSegurada( entrada, c->descartar ) ) bits |= REDE_DESCARTAR;
+    // segurada agora e solta na leitura anterior tambem e aperto: com um
+    // PollInputEvents extra (modo de baixa latencia), o IsKeyPressed da
+    // busca do EndDrawing se perde. Os bots dizem sozinhos quando apertam
+    uint8_t subiu = entrada->fonte == NULL ? (uint8_t)( bits & ~anterior ) : 0;
+    if ( teclaPressionada( entrada, c->pegar ) || ( subiu & REDE_PEGAR ) ) bits |= REDE_PEGOU;
+    if ( teclaPressionada( entrada, c->descartar ) || ( subiu & REDE_DESCARTAR ) ) bits |= REDE_DESCARTOU;
+    return bits;
+}
+
+static void lerPonteiro( Entrada *entrada, QuadroEntrada *quadro, int numJogadores ) {
+
+    if ( GetTouchPointCount() > 0 ) {
+        Vector2 dedo = GetTouchPosition( 0 );
+        quadro->ponteiro = dedo;
+        if ( !entrada->tocando ) {
+            entrada->tocando = true;
+            entrada->arrastou = false;
+            entrada->origemToque = dedo;
+            entrada->inicioToque = quadro->tempo;
+            quadro->clicou = true;
+        }
+
+        // direcional virtual: a direcao e a do dedo em relacao a onde desceu
+        float dx = dedo.x - entrada->origemToque.x;
+        float dy = dedo.y - entrada->origemToque.y;
+        if ( fabsf( dx ) > ENTRADA_ARRASTO_MINIMO || fabsf( dy ) > ENTRADA_ARRASTO_MINIMO ) {
+            entrada->arrastou = true;
+        }
+        if ( entrada->arrastou && numJogadores > 0 ) {
+            if ( dx < -ENTRADA_ARRASTO_MINIMO ) quadro->jogadores[0] |= REDE_ESQUERDA;
+            if ( dx > ENTRADA_ARRASTO_MINIMO ) quadro->jogadores[0] |= REDE_DIREITA;
+            if ( dy < -ENTRADA_ARRASTO_MINIMO ) quadro->jogadores[0] |= REDE_CIMA;
+            if ( dy > ENTRADA_ARRASTO_MINIMO ) quadro->jogadores[0] |= REDE_BAIXO;
+        }
+    } else {
+        quadro->ponteiro = GetMousePosition();
+        if ( entrada->tocando ) {
+            entrada->tocando = false;
+            quadro->tocou = !entrada->arrastou && quadro->tempo - entrada->inicioToque < ENTRADA_TOQUE_CURTO;
+        }
+    }
+
+    bool botao = IsMouseButtonDown( MOUSE_LEFT_BUTTON );
+    if ( IsMouseButtonPressed( MOUSE_LEFT_BUTTON ) || ( botao && !entrada->mouseSegurado ) ) {
+        quadro->clicou = true;
+    }
+    entrada->mouseSegurado = botao;
+
+}
+
+static void publicar( Entrada *entrada, const EventoEntrada *evento ) {
+
+    // só esta thread escreve em escrita; leitura vem do consumidor
+    uint32_t escrita = entrada->escrita;
+    uint32_t leitura = __atomic_load_n( &entrada->leitura, __ATOMIC_ACQUIRE );
+    if ( escrita - leitura == ENTRADA_EVENTOS ) {
+        entrada->eventosPerdidos++;
+        return;
+    }
+    entrada->eventos[escrita & ( ENTRADA_EVENTOS - 1 )] = *evento;
+    __atomic_store_n( &entrada->escrita, escrita + 1, __ATOMIC_RELEASE );
+
+}
+
+void EntradaCriar( Entrada *entrada ) {
+    memset( entrada, 0, sizeof(Entrada) );
+    memcpy( entrada->teclado, TECLADO_PADRAO, sizeof(TECLADO_PADRAO) );
+    memcpy( entrada->controles, TECLADO_PADRAO, sizeof(TECLADO_PADRAO) );
+    memcpy( entrada->atalhos, ATALHOS_PADRAO, sizeof(ATALHOS_PADRAO) );
+}
+
+bool EntradaCarregarTeclas( Entrada *entrada, const char *arquivo ) {
+
+    FILE *f = fopen( arquivo, "r" );
+    if ( f == NULL ) {
+        return false;
+    }
+
+    bool ok = true;
+    char linha[128];
+    while ( ok && fgets( linha, sizeof(linha), f ) != NULL ) {
+
+        char dono[16];
+        char nome[16];
+        int codigo;
+        if ( linha[0] == '#' || sscanf( linha, "%15s", dono ) != 1 ) {
+            continue;
+        }
+        ok = sscanf( linha, "%15s %15s %d", dono, nome, &codigo ) == 3 && codigo > 0;
+
+        int *tecla = NULL;
+        if ( ok && strcmp( dono, "atalho" ) == 0 ) {
+            for ( int a = 0; a < NUM_ATALHOS; a++ ) {
+                if ( strcmp( nome, NOMES_ATALHOS[a] ) == 0 ) {
+                    tecla = &entrada->atalhos[a];
+                }
+            }
+        } else if ( ok ) {
+            int j = dono[0] - '1';
+            if ( dono[1] == '\0' && j >= 0 && j < ENTRADA_MAX_JOGADORES ) {
+                for ( int a = 0; a < (int)( sizeof(NOMES_ACOES) / sizeof(NOMES_ACOES[0]) ); a++ ) {
+                    if ( strcmp( nome, NOMES_ACOES[a] ) == 0 ) {
+                        tecla = teclaDaAcao( &entrada->teclado[j], a );
+                    }
+                }
+            }
+        }
+
+        ok = tecla != NULL;
+        if ( ok ) {
+            *tecla = codigo;
+        }
+
+    }
+
+    fclose( f );
+    memcpy( entrada->controles, entrada->teclado, sizeof(entrada->teclado) );
+    return ok;
+
+}
+
+ControlesJogador EntradaControlesDoGamepad( int gamepad ) {
+    return (ControlesJogador){
+        TECLA_CONTROLE( gamepad, GAMEPAD_BUTTON_LEFT_FACE_LEFT ),
+        TECLA_CONTROLE( gamepad, GAMEPAD_BUTTON_LEFT_FACE_RIGHT ),
+        TECLA_CONTROLE( gamepad, GAMEPAD_BUTTON_LEFT_FACE_UP ),
+        TECLA_CONTROLE( gamepad, GAMEPAD_BUTTON_LEFT_FACE_DOWN ),
+        TECLA_CONTROLE( gamepad, GAMEPAD_BUTTON_RIGHT_FACE_DOWN ),
+        TECLA_CONTROLE( gamepad, GAMEPAD_BUTTON_RIGHT_FACE_RIGHT )
+    };
+}
+
+void EntradaLer( Entrada *entrada, int numJogadores ) {
+
+    if ( numJogadores > ENTRADA_MAX_JOGADORES ) {
+        numJogadores = ENTRADA_MAX_JOGADORES;
+    }
+
+    QuadroEntrada anterior = entrada->atual;
+    QuadroEntrada *quadro = &entrada->atual;
+    memset( quadro, 0, sizeof(QuadroEntrada) );
+    quadro->tempo = PlataformaTempo();
+
+    for ( int j = 0; j < numJogadores; j++ ) {
+        quadro->jogadores[j] = lerJogador( entrada, &entrada->controles[j], anterior.jogadores[j] );
+    }
+    uint16_t segurados = 0;
+    for ( int a = 0; a < NUM_ATALHOS; a++ ) {
+        uint16_t bit = (uint16_t)( 1u << a );
+        if ( IsKeyDown( entrada->atalhos[a] ) ) {
+            segurados |= bit;
+        }
+        if ( IsKeyPressed( entrada->atalhos[a] ) || ( segurados & ~entrada->atalhosSegurados & bit ) ) {
+            quadro->atalhos |= bit;
+        }
+    }
+    entrada->atalhosSegurados = segurados;
+    lerPonteiro( entrada, quadro, numJogadores );
+
+    if ( !entrada->registrarEventos ) {
+        return;
+    }
+    for ( int j = 0; j < numJogadores; j++ ) {
+        unsigned int mudou = ( anterior.jogadores[j] ^ quadro->jogadores[j] ) & BITS_SEGURADOS;
+        for ( int a = 0; mudou != 0; a++, mudou >>= 1 ) {
+            if ( mudou & 1u ) {
+                EventoEntrada evento = {
+                    quadro->tempo, *teclaDaAcao( &entrada->controles[j], a ), (int8_t)j, (uint8_t)( 1u << a ),
+                    ( quadro->jogadores[j] & ( 1u << a ) ) != 0
+                };
+                publicar( entrada, &evento );
+            }
+        }
+    }
+
+}
+
+bool EntradaAtalho( const Entrada *entrada, AtalhoEntrada atalho ) {
+    return ( entrada->atual.atalhos & ( 1u << atalho ) ) != 0;
+}
+
+bool EntradaProximoEvento( Entrada *entrada, EventoEntrada *evento ) {
+
+    uint32_t leitura = entrada->leitura;
+    uint32_t escrita = __atomic_load_n( &entrada->escrita, __ATOMIC_ACQUIRE );
+    if ( leitura == escrita ) {
+        return false;
+    }
+    *evento = entrada->eventos[leitura & ( ENTRADA_EVENTOS - 1 )];
+    __atomic_store_n( &entrada->leitura, leitura + 1, __ATOMIC_RELEASE );
+    return true;
+
+}
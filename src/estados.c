@@ -0,0 +1,81 @@
+/**
+ * @file estados.c
+ * @brief Troca de estados com ganchos e medição das transições.
+ * @copyright Copyright (c) 2025
+ */
+#include <string.h>
+
+#include "estados.h"
+#include "plataforma.h"
+
+void EstadosIniciar( MaquinaEstados *maquina, const EstadoJogo *estados, int quantidade, int inicial ) {
+
+    memset( maquina, 0, sizeof(MaquinaEstados) );
+    maquina->estados = estados;
+    maquina->quantidade = quantidade < ESTADOS_MAX ? quantidade : ESTADOS_MAX;
+    maquina->atual = inicial;
+    maquina->inicioAtual = PlataformaTempo();
+
+    if ( estados[inicial].entrar != NULL ) {
+        estados[inicial].entrar( -1 );
+    }
+
+}
+
+void EstadosTrocar( MaquinaEstados *maquina, int novo ) {
+
+    int anterior = maquina->atual;
+    if ( novo == anterior || novo < 0 || novo >= maquina->quantidade ) {
+        return;
+    }
+
+    double inicio = PlataformaTempo();
+    maquina->segundosEm[anterior] += inicio - maquina->inicioAtual;
+
+    if ( maquina->estados[anterior].sair != NULL ) {
+        maquina->estados[anterior].sair( novo );
+    }
+    maquina->atual = novo;
+    if ( maquina->estados[novo].entrar != NULL ) {
+        maquina->estados[novo].entrar( anterior );
+    }
+
+    double fim = PlataformaTempo();
+    double ms = ( fim - inicio ) * 1000.0;
+    TempoTransicao *t = &maquina->transicoes[anterior][novo];
+    t->vezes++;
+    t->totalMs += ms;
+    if ( ms > t->maiorMs ) {
+        t->maiorMs = ms;
+    }
+    maquina->inicioAtual = fim;
+
+}
+
+void EstadosAtualizar( MaquinaEstados *maquina, float delta ) {
+    maquina->estados[maquina->atual].atualizar( delta );
+}
+
+void EstadosDesenhar( MaquinaEstados *maquina ) {
+    maquina->estados[maquina->atual].desenhar();
+}
+
+void EstadosRelatorio( const MaquinaEstados *maquina, FILE *saida ) {
+
+    double agora = PlataformaTempo();
+    fprintf( saida, "%-24s %9s %8s %10s %10s\n", "estado", "tempo (s)", "trocas", "media (ms)", "maior (ms)" );
+    for ( int i = 0; i < maquina->quantidade; i++ ) {
+        double segundos = maquina->segundosEm[i] + ( i == maquina->atual ? agora - maquina->inicioAtual : 0 );
+        fprintf( saida, "%-24s %9.1f\n", maquina->estados[i].nome, segundos );
+        for ( int j = 0; j < maquina->quantidade; j++ ) {
+            const TempoTransicao *t = &maquina->transicoes[i][j];
+            if ( t->vezes == 0 ) {
+                continue;
+            }
+            char par[64];
+            snprintf( par, sizeof(par), "  -> %s", maquina->estados[j].nome );
+            fprintf( saida, "%-24s %9s %8lld %10.3f %10.3f\n", par, "", t->vezes, t->totalMs / t->vezes, t->maiorMs );
+        }
+    }
+
+}
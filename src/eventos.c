@@ -0,0 +1,341 @@
+/**
+ * @file eventos.c
+ * @brief Buffer por quadro, anel, thread de gravação e codificação dos
+ * lotes do log de eventos.
+ * @copyright Copyright (c) 2025
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include "eventos.h"
+#include "memoria.h"
+
+#define EVENTOS_MAGICA 0x5645474Fu // "OGEV"
+#define TAMANHO_CABECALHO 8
+#define TAMANHO_CABECALHO_LOTE 16
+#define MAXIMO_BYTES_EVENTO 18 // tipo, tempo (varint de 64 bits), a, b e valor
+
+// campos gravados por tipo de evento (o jogador vai junto com o tipo)
+#define CAMPO_A     0x01
+#define CAMPO_B     0x02
+#define CAMPO_VALOR 0x04
+
+static const uint8_t CAMPOS[NUM_TIPOS_EVENTO] = {
+    [EVENTO_ABERTURA] = CAMPO_VALOR,
+    [EVENTO_QUADRO]   = CAMPO_VALOR,
+    [EVENTO_ESTADO]   = CAMPO_A | CAMPO_B | CAMPO_VALOR,
+    [EVENTO_COLETA]   = CAMPO_A,
+    [EVENTO_DESCARTE] = CAMPO_A | CAMPO_B | CAMPO_VALOR
+};
+
+static uint8_t *escreverVarint( uint8_t *p, uint64_t v ) {
+    while ( v >= 0x80 ) {
+        *p++ = (uint8_t)( v | 0x80 );
+        v >>= 7;
+    }
+    *p++ = (uint8_t)v;
+    return p;
+}
+
+static bool lerVarint( const uint8_t *dados, size_t fim, size_t *pos, uint64_t *v ) {
+    *v = 0;
+    for ( int deslocamento = 0; deslocamento < 64 && *pos < fim; deslocamento += 7 ) {
+        uint8_t byte = dados[(*pos)++];
+        *v |= (uint64_t)( byte & 0x7F ) << deslocamento;
+        if ( !( byte & 0x80 ) ) {
+            return true;
+        }
+    }
+    return false;
+}
+
+static uint8_t *escrever32( uint8_t *p, uint32_t v ) {
+    for ( int i = 0; i < 4; i++ ) {
+        *p++ = (uint8_t)( v >> ( 8 * i ) );
+    }
+    return p;
+}
+
+static uint32_t ler32( const uint8_t *p ) {
+    return (uint32_t)p[0] | (uint32_t)p[1] << 8 | (uint32_t)p[2] << 16 | (uint32_t)p[3] << 24;
+}
+
+static void gravarLote( LogEventos *log, int quantidade ) {
+
+    uint8_t *p = log->comprimido + TAMANHO_CABECALHO_LOTE;
+    uint64_t anterior = log->lote[0].tempo;
+    for ( int i = 0; i < quantidade; i++ ) {
+        const Evento *e = &log->lote[i];
+        uint8_t campos = CAMPOS[e->tipo];
+        *p++ = (uint8_t)( e->tipo | e->jogador << 4 );
+        p = escreverVarint( p, e->tempo - anterior );
+        anterior = e->tempo;
+        if ( campos & CAMPO_A ) {
+            *p++ = e->a;
+        }
+        if ( campos & CAMPO_B ) {
+            *p++ = e->b;
+        }
+        if ( campos & CAMPO_VALOR ) {
+            // zigzag: valores negativos pequenos também ficam com poucos bytes
+            uint32_t zigzag = ( (uint32_t)e->valor << 1 ) ^ (uint32_t)( e->valor < 0 ? -1 : 0 );
+            p = escreverVarint( p, zigzag );
+        }
+    }
+
+    uint32_t tamanho = (uint32_t)( p - log->comprimido - TAMANHO_CABECALHO_LOTE );
+    uint8_t *cabecalho = escrever32( log->comprimido, (uint32_t)quantidade );
+    cabecalho = escrever32( cabecalho, tamanho );
+    cabecalho = escrever32( cabecalho, (uint32_t)log->lote[0].tempo );
+    escrever32( cabecalho, (uint32_t)( log->lote[0].tempo >> 32 ) );
+
+    size_t total = TAMANHO_CABECALHO_LOTE + tamanho;
+    if ( fwrite( log->comprimido, 1, total, log->saida ) == total ) {
+        fflush( log->saida );
+        log->gravados += quantidade;
+        log->bytes += (long long)total;
+    }
+
+}
+
+static void publicarQuadro( LogEventos *log ) {
+
+    // uma trava por quadro; com o anel cheio os eventos se perdem, o jogo
+    // nunca espera o disco
+    MutexTravar( log->mutex );
+    uint32_t livres = EVENTOS_ANEL - ( log->fimAnel - log->inicioAnel );
+    int quantidade = log->quantidadeQuadro < (int)livres ? log->quantidadeQuadro : (int)livres;
+    for ( int i = 0; i < quantidade; i++ ) {
+        log->anel[( log->fimAnel + i ) & ( EVENTOS_ANEL - 1 )] = log->quadro[i];
+    }
+    log->fimAnel += quantidade;
+    if ( log->fimAnel - log->inicioAnel >= EVENTOS_LOTE ) {
+        CondSinalizar( log->cond );
+    }
+    MutexDestravar( log->mutex );
+
+    log->perdidos += log->quantidadeQuadro - quantidade;
+    log->quantidadeQuadro = 0;
+
+}
+
+// a thread espera um lote completo (ou o fechamento) e o grava fora do mutex
+static void executarGravacao( void *dados ) {
+
+    LogEventos *log = (LogEventos*)dados;
+
+    MutexTravar( log->mutex );
+    while ( true ) {
+        while ( !log->encerrar && log->fimAnel - log->inicioAnel < EVENTOS_LOTE ) {
+            CondEsperar( log->cond, log->mutex );
+        }
+        uint32_t disponiveis = log->fimAnel - log->inicioAnel;
+        if ( disponiveis == 0 ) {
+            break;
+        }
+        int quantidade = disponiveis < EVENTOS_LOTE ? (int)disponiveis : EVENTOS_LOTE;
+        for ( int i = 0; i < quantidade; i++ ) {
+            log->lote[i] = log->anel[( log->inicioAnel + i ) & ( EVENTOS_ANEL - 1 )];
+        }
+        log->inicioAnel += quantidade;
+        MutexDestravar( log->mutex );
+
+        gravarLote( log, quantidade );
+
+        MutexTravar( log->mutex );
+    }
+    MutexDestravar( log->mutex );
+
+}
+
+bool LogEventosAbrir( LogEventos *log, const char *arquivo ) {
+
+    memset( log, 0, sizeof(LogEventos) );
+    if ( arquivo == NULL ) {
+        return true;
+    }
+
+    // se o jogo caiu no meio de um lote, o lote pela metade esconderia das
+    // ferramentas tudo o que viesse depois: o arquivo volta ao fim do
+    // último lote completo antes de acrescentar
+    size_t tamanho = 0;
+    const uint8_t *dados = PlataformaMapearArquivo( arquivo, &tamanho );
+    if ( dados != NULL ) {
+        size_t pos = 0;
+        size_t fim = 0;
+        bool valido = LogEventosLerCabecalho( dados, tamanho, &pos );
+        if ( valido ) {
+            fim = pos;
+            while ( LogEventosPularLote( dados, tamanho, &pos ) ) {
+                fim = pos;
+            }
+        }
+        PlataformaDesmapearArquivo( dados, tamanho );
+        // arquivo que não é log (nem cabeçalho cortado) não é mexido
+        if ( !valido && tamanho >= TAMANHO_CABECALHO ) {
+            return false;
+        }
+        if ( fim < tamanho && !PlataformaTruncarArquivo( arquivo, fim ) ) {
+            return false;
+        }
+    }
+
+    log->saida = fopen( arquivo, "ab" );
+    if ( log->saida == NULL ) {
+        return false;
+    }
+    fseek( log->saida, 0, SEEK_END );
+    if ( ftell( log->saida ) == 0 ) {
+        uint8_t cabecalho[TAMANHO_CABECALHO];
+        escrever32( escrever32( cabecalho, EVENTOS_MAGICA ), EVENTOS_VERSAO );
+        fwrite( cabecalho, 1, sizeof(cabecalho), log->saida );
+    }
+
+    log->anel = (Evento*)MemoriaAlocar( MEMORIA_EVENTOS, sizeof(Evento) * EVENTOS_ANEL );
+    log->lote = (Evento*)MemoriaAlocar( MEMORIA_EVENTOS, sizeof(Evento) * EVENTOS_LOTE );
+    log->comprimido = (uint8_t*)MemoriaAlocar( MEMORIA_EVENTOS, TAMANHO_CABECALHO_LOTE + EVENTOS_LOTE * MAXIMO_BYTES_EVENTO );
+    log->mutex = MutexCriar();
+    log->cond = CondCriar();
+    log->thread = ThreadCriar( executarGravacao, log );
+    if ( log->thread == NULL ) {
+        LogEventosFechar( log );
+        return false;
+    }
+
+    log->ativo = true;
+    log->inicio = PlataformaTempo();
+    LogEventosRegistrar( log, EVENTO_ABERTURA, 0, 0, 0, (int32_t)time( NULL ) );
+    return true;
+
+}
+
+void LogEventosFechar( LogEventos *log ) {
+
+    if ( log->saida == NULL ) {
+        return;
+    }
+
+    if ( log->thread != NULL ) {
+        // o último quadro pode não ter terminado
+        publicarQuadro( log );
+        MutexTravar( log->mutex );
+        log->encerrar = true;
+        CondSinalizar( log->cond );
+        MutexDestravar( log->mutex );
+        ThreadAguardar( log->thread );
+    }
+
+    fclose( log->saida );
+    CondDestruir( log->cond );
+    MutexDestruir( log->mutex );
+    MemoriaLiberar( log->anel );
+    MemoriaLiberar( log->lote );
+    MemoriaLiberar( log->comprimido );
+    log->saida = NULL;
+    log->ativo = false;
+
+}
+
+void LogEventosRegistrar( LogEventos *log, TipoEvento tipo, int jogador, int a, int b, int32_t valor ) {
+
+    if ( !log->ativo ) {
+        return;
+    }
+    if ( log->quantidadeQuadro == EVENTOS_POR_QUADRO ) {
+        log->perdidos++;
+        return;
+    }
+
+    Evento *e = &log->quadro[log->quantidadeQuadro++];
+    e->tempo = (uint64_t)( ( PlataformaTempo() - log->inicio ) * 1e6 );
+    e->valor = valor;
+    e->tipo = (uint8_t)tipo;
+    e->jogador = (uint8_t)jogador;
+    e->a = (uint8_t)a;
+    e->b = (uint8_t)b;
+
+}
+
+void LogEventosFimDoQuadro( LogEventos *log, float ms ) {
+    if ( log->ativo ) {
+        LogEventosRegistrar( log, EVENTO_QUADRO, 0, 0, 0, (int32_t)( ms * 1000.0f ) );
+        publicarQuadro( log );
+    }
+}
+
+bool LogEventosLerCabecalho( const uint8_t *dados, size_t tamanho, size_t *pos ) {
+    if ( tamanho < TAMANHO_CABECALHO || ler32( dados ) != EVENTOS_MAGICA || ler32( dados + 4 ) != EVENTOS_VERSAO ) {
+        return false;
+    }
+    *pos = TAMANHO_CABECALHO;
+    return true;
+}
+
+bool LogEventosPularLote( const uint8_t *dados, size_t tamanho, size_t *pos ) {
+    if ( tamanho - *pos < TAMANHO_CABECALHO_LOTE ) {
+        return false;
+    }
+    uint32_t bytes = ler32( dados + *pos + 4 );
+    if ( bytes > tamanho - *pos - TAMANHO_CABECALHO_LOTE ) {
+        return false;
+    }
+    *pos += TAMANHO_CABECALHO_LOTE + bytes;
+    return true;
+}
+
+int LogEventosLerLote( const uint8_t *dados, size_t tamanho, size_t *pos, Evento *eventos ) {
+
+    if ( *pos == tamanho ) {
+        return 0;
+    }
+    if ( tamanho - *pos < TAMANHO_CABECALHO_LOTE ) {
+        return -1;
+    }
+
+    const uint8_t *cabecalho = dados + *pos;
+    uint32_t quantidade = ler32( cabecalho );
+    uint32_t bytes = ler32( cabecalho + 4 );
+    uint64_t tempo = ler32( cabecalho + 8 ) | (uint64_t)ler32( cabecalho + 12 ) << 32;
+    size_t p = *pos + TAMANHO_CABECALHO_LOTE;
+    if ( quantidade == 0 || quantidade > EVENTOS_LOTE || bytes > tamanho - p ) {
+        return -1;
+    }
+    size_t fim = p + bytes;
+
+    for ( uint32_t i = 0; i < quantidade; i++ ) {
+        Evento *e = &eventos[i];
+        uint64_t delta;
+        uint64_t zigzag = 0;
+        if ( p >= fim ) {
+            return -1;
+        }
+        e->tipo = dados[p] & 0x0F;
+        e->jogador = dados[p] >> 4;
+        p++;
+        if ( e->tipo >= NUM_TIPOS_EVENTO || !lerVarint( dados, fim, &p, &delta ) ) {
+            return -1;
+        }
+        tempo += delta;
+        e->tempo = tempo;
+        uint8_t campos = CAMPOS[e->tipo];
+        size_t bytesAB = ( campos & CAMPO_A ? 1 : 0 ) + ( campos & CAMPO_B ? 1 : 0 );
+        if ( fim - p < bytesAB ) {
+            return -1;
+        }
+        e->a = campos & CAMPO_A ? dados[p++] : 0;
+        e->b = campos & CAMPO_B ? dados[p++] : 0;
+        if ( ( campos & CAMPO_VALOR ) && !lerVarint( dados, fim, &p, &zigzag ) ) {
+            return -1;
+        }
+        e->valor = (int32_t)( (uint32_t)( zigzag >> 1 ) ^ -(uint32_t)( zigzag & 1 ) );
+    }
+    if ( p != fim ) {
+        return -1;
+    }
+
+    *pos = fim;
+    return (int)quantidade;
+
+}
@@ -0,0 +1,104 @@
+/**
+ * @file gravacao.c
+ * @brief Gravação das entradas em memória e em arquivo.
+ * @copyright Copyright (c) 2025
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "gravacao.h"
+#include "memoria.h"
+
+#define GRAVACAO_MAGICA 0x4E45474Fu // "OGEN"
+
+// cabeçalho do arquivo (16 bytes, sem preenchimento)
+typedef struct CabecalhoGravacao {
+    uint32_t magica;
+    uint32_t versao;
+    uint32_t numJogadores;
+    uint32_t passos;
+} CabecalhoGravacao;
+
+void GravacaoCriar( GravacaoEntradas *gravacao, int numJogadores ) {
+    gravacao->numJogadores = numJogadores;
+    gravacao->passos = 0;
+    gravacao->capacidade = 0;
+    gravacao->entradas = NULL;
+}
+
+void GravacaoDestruir( GravacaoEntradas *gravacao ) {
+    MemoriaLiberar( gravacao->entradas );
+    gravacao->entradas = NULL;
+    gravacao->passos = 0;
+    gravacao->capacidade = 0;
+}
+
+void GravacaoAdicionar( GravacaoEntradas *gravacao, const uint8_t *entradas ) {
+
+    if ( gravacao->passos == gravacao->capacidade ) {
+        // começa com um minuto de partida e dobra
+        int capacidade = gravacao->capacidade > 0 ? gravacao->capacidade * 2 : 3600;
+        uint8_t *novas = (uint8_t*)MemoriaRealocar( MEMORIA_GRAVACAO, gravacao->entradas, (size_t)capacidade * gravacao->numJogadores );
+        if ( novas == NULL ) {
+            return;
+        }
+        gravacao->entradas = novas;
+        gravacao->capacidade = capacidade;
+    }
+
+    memcpy( gravacao->entradas + (size_t)gravacao->passos * gravacao->numJogadores, entradas, gravacao->numJogadores );
+    gravacao->passos++;
+
+}
+
+const uint8_t *GravacaoPasso( const GravacaoEntradas *gravacao, long long passo ) {
+    return gravacao->entradas + (size_t)( passo % gravacao->passos ) * gravacao->numJogadores;
+}
+
+bool GravacaoSalvar( const GravacaoEntradas *gravacao, const char *arquivo ) {
+
+    FILE *saida = fopen( arquivo, "wb" );
+    if ( saida == NULL ) {
+        return false;
+    }
+
+    CabecalhoGravacao cabecalho = {
+        GRAVACAO_MAGICA, GRAVACAO_VERSAO, (uint32_t)gravacao->numJogadores, (uint32_t)gravacao->passos
+    };
+    size_t bytes = (size_t)gravacao->passos * gravacao->numJogadores;
+    bool ok = fwrite( &cabecalho, sizeof(cabecalho), 1, saida ) == 1 &&
+              ( bytes == 0 || fwrite( gravacao->entradas, 1, bytes, saida ) == bytes );
+    return fclose( saida ) == 0 && ok;
+
+}
+
+bool GravacaoCarregar( GravacaoEntradas *gravacao, const char *arquivo ) {
+
+    FILE *entrada = fopen( arquivo, "rb" );
+    if ( entrada == NULL ) {
+        return false;
+    }
+
+    CabecalhoGravacao cabecalho;
+    bool ok = fread( &cabecalho, sizeof(cabecalho), 1, entrada ) == 1 &&
+              cabecalho.magica == GRAVACAO_MAGICA && cabecalho.versao == GRAVACAO_VERSAO &&
+              cabecalho.numJogadores >= 1 && cabecalho.numJogadores <= GRAVACAO_MAX_JOGADORES &&
+              cabecalho.passos > 0 && cabecalho.passos < ( 1u << 26 );
+    if ( ok ) {
+        size_t bytes = (size_t)cabecalho.passos * cabecalho.numJogadores;
+        GravacaoCriar( gravacao, (int)cabecalho.numJogadores );
+        gravacao->entradas = (uint8_t*)MemoriaAlocar( MEMORIA_GRAVACAO, bytes );
+        ok = gravacao->entradas != NULL && fread( gravacao->entradas, 1, bytes, entrada ) == bytes;
+        if ( ok ) {
+            gravacao->passos = (int)cabecalho.passos;
+            gravacao->capacidade = gravacao->passos;
+        } else {
+            GravacaoDestruir( gravacao );
+        }
+    }
+
+    fclose( entrada );
+    return ok;
+
+}
@@ -0,0 +1,88 @@
+/**
+ * @file arena.h
+ * @brief Arena linear para dados temporários de um quadro (listas de
+ * visíveis, resultados de consulta, textos formatados): alocar é avançar um
+ * ponteiro e tudo é liberado de uma vez no início do quadro seguinte.
+ *
+ * A capacidade é reservada fora da partida (ArenaReservar). Se um quadro
+ * passar dela, a arena pede outro bloco ao alocador (aparece como alocação
+ * do subsistema arena no relatório de memoria.h) e, no ArenaResetar, troca
+ * os blocos por um só do tamanho do pico.
+ *
+ * A ArenaDupla alterna duas arenas: o que um quadro escreveu continua
+ * válido durante o quadro seguinte, para quem consome com um quadro de
+ * atraso (uma thread de render, por exemplo).
+ * @copyright Copyright (c) 2025
+ */
+#ifndef ARENA_H
+#define ARENA_H
+
+#include <stdbool.h>
+#include <stddef.h>
+
+/*---------------------------------------------
+ * Macros.
+ *-------------------------------------------*/
+#define ARENA_ALINHAMENTO 16
+
+/*---------------------------------------------
+ * Custom types (enums, structs, unions, etc.)
+ *-------------------------------------------*/
+typedef struct BlocoArena BlocoArena;
+
+typedef struct Arena {
+    BlocoArena *bloco;    // bloco atual; os anteriores ficam encadeados até o reset
+    size_t usado;         // no bloco atual
+    size_t usadoQuadro;   // em todos os blocos desde o último reset
+    size_t pico;          // maior usadoQuadro
+    int blocosExtras;     // blocos pedidos além da capacidade desde a criação
+} Arena;
+
+typedef struct ArenaDupla {
+    Arena arenas[2];
+    int atual;
+} ArenaDupla;
+
+/*---------------------------------------------
+ * Function prototypes.
+ *-------------------------------------------*/
+/**
+ * @brief Arena vazia com capacidade bytes.
+ */
+void ArenaCriar( Arena *arena, size_t capacidade );
+void ArenaDestruir( Arena *arena );
+
+/**
+ * @brief Garante capacidade bytes para os próximos quadros. O que já foi
+ * alocado no quadro continua válido até o próximo reset.
+ */
+void ArenaReservar( Arena *arena, size_t capacidade );
+
+/**
+ * @brief Bloco de tamanho bytes, alinhado a ARENA_ALINHAMENTO, válido até
+ * o próximo ArenaResetar. Retorna NULL só se faltar memória.
+ */
+void *ArenaAlocar( Arena *arena, size_t tamanho );
+
+/**
+ * @brief Como snprintf, com o texto guardado na arena.
+ */
+char *ArenaFormatar( Arena *arena, const char *formato, ... );
+
+/**
+ * @brief Libera de uma vez tudo o que foi alocado desde o último reset.
+ */
+void ArenaResetar( Arena *arena );
+
+void ArenaDuplaCriar( ArenaDupla *dupla, size_t capacidade );
+void ArenaDuplaDestruir( ArenaDupla *dupla );
+
+/**
+ * @brief Começa um quadro: esvazia a arena de dois quadros atrás e a
+ * devolve. A do quadro anterior continua intacta (ArenaDuplaAnterior).
+ */
+Arena *ArenaDuplaTrocar( ArenaDupla *dupla );
+Arena *ArenaDuplaAtual( ArenaDupla *dupla );
+Arena *ArenaDuplaAnterior( ArenaDupla *dupla );
+
+#endif
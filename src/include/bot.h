@@ -0,0 +1,87 @@
+/**
+ * @file bot.h
+ * @brief Mergulhador automático para testes longos. O bot funciona como um
+ * teclado falso: a cada quadro decide quais teclas do jogador estão
+ * seguradas ou foram apertadas, e o jogo lê essas teclas no lugar das do
+ * teclado de verdade.
+ * @copyright Copyright (c) 2025
+ */
+#ifndef BOT_H
+#define BOT_H
+
+#include <stdbool.h>
+
+#include "raylib/raylib.h"
+#include "colisao.h"
+#include "navegacao.h"
+
+/*---------------------------------------------
+ * Custom types (enums, structs, unions, etc.)
+ *-------------------------------------------*/
+typedef enum AcaoBot {
+    BOT_ESQUERDA,
+    BOT_DIREITA,
+    BOT_CIMA,
+    BOT_BAIXO,
+    BOT_PEGAR,
+    BOT_DESCARTAR,
+    BOT_NUM_ACOES
+} AcaoBot;
+
+/**
+ * @brief O que o bot enxerga do jogo a cada quadro.
+ */
+typedef struct VisaoBot {
+    Rectangle jogador;
+    int tipoNaMao;            // tipo do lixo segurado ou -1
+    const LoteAABB *lixos;    // lixos desativados nunca colidem
+    const LoteAABB *lixeiras; // a lixeira i aceita o lixo do tipo i
+    const NavGrade *nav;        // rochas (pode ser NULL: mar aberto)
+    const CampoFluxo *caminhos; // um campo por lixeira (se nav != NULL)
+} VisaoBot;
+
+typedef struct Bot {
+
+    int teclas[BOT_NUM_ACOES];
+    unsigned int seguradas;    // bit por AcaoBot
+    unsigned int pressionadas; // só no quadro em que a tecla desce
+
+    int alvo;           // lixo sendo buscado ou -1
+    int ignorado;       // lixo abandonado por falta de progresso
+    float tempoNoAlvo;
+    float melhorDistancia;
+
+    // caminho até o lixo alvo, refeito quando o lixo muda de célula
+    CampoFluxo caminhoAlvo;
+
+} Bot;
+
+/*---------------------------------------------
+ * Function prototypes.
+ *-------------------------------------------*/
+/**
+ * @brief Prepara o bot para controlar as teclas dadas.
+ */
+void BotCriar( Bot *bot, int teclaEsquerda, int teclaDireita, int teclaCima, int teclaBaixo,
+               int teclaPegar, int teclaDescartar );
+void BotDestruir( Bot *bot );
+
+/**
+ * @brief Aloca já o campo de fluxo do alvo, que senão seria criado no
+ * primeiro alvo, no meio da partida.
+ */
+void BotReservar( Bot *bot, const NavGrade *nav );
+
+/**
+ * @brief Escolhe o alvo (lixo mais próximo ou a lixeira do lixo na mão) e
+ * decide as teclas do quadro, contornando as rochas pelos campos de fluxo.
+ */
+void BotPensar( Bot *bot, const VisaoBot *visao, float delta );
+
+/**
+ * @brief Equivalentes de IsKeyDown e IsKeyPressed para o bot.
+ */
+bool BotTeclaSegurada( const Bot *bot, int tecla );
+bool BotTeclaPressionada( const Bot *bot, int tecla );
+
+#endif
@@ -0,0 +1,88 @@
+/**
+ * @file cardume.h
+ * @brief Cardumes de peixes (boids). O estado fica em SoA e é reordenado a
+ * cada passo por célula de uma grade uniforme, assim os vizinhos de cada
+ * peixe ficam contíguos na memória e podem ser processados com SIMD. Os
+ * peixes fogem das células com mais lixo.
+ * @copyright Copyright (c) 2025
+ */
+#ifndef CARDUME_H
+#define CARDUME_H
+
+#include "raylib/raylib.h"
+#include "tarefas.h"
+
+/*---------------------------------------------
+ * Macros.
+ *-------------------------------------------*/
+// lado da célula = raio em que um peixe enxerga os outros
+#define CARDUME_CELULA 48
+
+/*---------------------------------------------
+ * Custom types (enums, structs, unions, etc.)
+ *-------------------------------------------*/
+typedef struct Cardume {
+
+    // estado, sempre ordenado por célula depois de CardumeAtualizar
+    float *x;
+    float *y;
+    float *vx;
+    float *vy;
+
+    // buffers de trabalho do passo (ordenação e nova velocidade)
+    float *auxX;
+    float *auxY;
+    float *auxVx;
+    float *auxVy;
+    int *celulaDoPeixe;
+    float *bloco; // uma alocação para os 8 vetores acima (trocados a cada passo)
+
+    // grade: peixes da célula c estão em [inicioCelula[c], inicioCelula[c + 1])
+    int *inicioCelula;
+    float *poluicao; // lixo por célula, preenchido pelo jogo
+    int colunas;
+    int linhas;
+
+    int quantidade;
+    int capacidade;
+    float largura;
+    float altura;
+    unsigned int passo;
+
+} Cardume;
+
+/*---------------------------------------------
+ * Function prototypes.
+ *-------------------------------------------*/
+void CardumeCriar( Cardume *cardume, int capacidade, float largura, float altura );
+void CardumeDestruir( Cardume *cardume );
+
+/**
+ * @brief Cria quantidade peixes em grupos espalhados pelo mapa.
+ */
+void CardumeEspalhar( Cardume *cardume, int quantidade, unsigned int semente );
+
+/**
+ * @brief Zera o mapa de poluição visto pelos peixes.
+ */
+void CardumeLimparPoluicao( Cardume *cardume );
+
+/**
+ * @brief Soma peso à poluição da célula que contém pos (e metade às
+ * vizinhas).
+ */
+void CardumeAdicionarPoluicao( Cardume *cardume, Vector2 pos, float peso );
+
+/**
+ * @brief Reordena a grade, calcula separação/alinhamento/coesão e move os
+ * peixes. Peixes fora de visivel recalculam a direção só a cada 4 passos.
+ */
+void CardumeAtualizar( Cardume *cardume, float delta, Rectangle visivel, PoolTarefas *pool );
+
+/**
+ * @brief Desenha os peixes visíveis com DrawTexturePro, no mesmo lote de
+ * sprites usado para o lixo.
+ */
+void CardumeDesenhar( const Cardume *cardume, Texture2D sprite, Rectangle visivel );
+
+#endif
@@ -0,0 +1,64 @@
+/**
+ * @file colisao.h
+ * @brief Teste de colisão de um retângulo contra um lote de retângulos
+ * guardados em SoA (minX, minY, maxX, maxY). Usa AVX2 ou SSE2 quando o
+ * compilador habilita, senão um laço escalar. O resultado é igual ao de
+ * chamar CheckCollisionRecs para cada item.
+ * @copyright Copyright (c) 2025
+ */
+#ifndef COLISAO_H
+#define COLISAO_H
+
+#include "raylib/raylib.h"
+
+/*---------------------------------------------
+ * Custom types (enums, structs, unions, etc.)
+ *-------------------------------------------*/
+typedef struct LoteAABB {
+    float *minX;
+    float *minY;
+    float *maxX;
+    float *maxY;
+    int quantidade; // itens 0..quantidade-1 são testados
+    int capacidade; // múltipla de 8; as sobras nunca colidem
+} LoteAABB;
+
+/*---------------------------------------------
+ * Function prototypes.
+ *-------------------------------------------*/
+/**
+ * @brief Aloca o lote com todos os itens desativados.
+ */
+void LoteAABBCriar( LoteAABB *lote, int capacidade );
+
+void LoteAABBDestruir( LoteAABB *lote );
+
+/**
+ * @brief Guarda o retângulo do item indice.
+ */
+void LoteAABBDefinir( LoteAABB *lote, int indice, Rectangle rec );
+
+/**
+ * @brief Faz o item indice nunca colidir até ser definido de novo.
+ */
+void LoteAABBDesativar( LoteAABB *lote, int indice );
+
+/**
+ * @brief Escreve em mascara um bit por item (bit i da palavra i/32) ligado
+ * quando o item colide com rec. mascara precisa de (capacidade + 31) / 32
+ * palavras.
+ */
+void ColisaoLoteMascara( Rectangle rec, const LoteAABB *lote, unsigned int *mascara );
+
+/**
+ * @brief Escreve em indices, em ordem crescente, os itens que colidem com
+ * rec e retorna quantos foram escritos (no máximo maxIndices).
+ */
+int ColisaoLoteIndices( Rectangle rec, const LoteAABB *lote, int *indices, int maxIndices );
+
+/**
+ * @brief Nome do caminho compilado: "AVX2", "SSE2" ou "escalar".
+ */
+const char *ColisaoCaminhoSimd( void );
+
+#endif
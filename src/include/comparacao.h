@@ -0,0 +1,40 @@
+/**
+ * @file comparacao.h
+ * @brief Comparação perceptual de imagens RGBA8 (telas de referência do
+ * --golden). A diferença de cada pixel é medida em YIQ, com peso maior no
+ * brilho do que na cor, como o olho: trocas de arredondamento do driver
+ * ficam abaixo do limiar, um sprite fora do lugar não.
+ * @copyright Copyright (c) 2025
+ */
+#ifndef COMPARACAO_H
+#define COMPARACAO_H
+
+#include <stdint.h>
+
+/*---------------------------------------------
+ * Macros.
+ *-------------------------------------------*/
+#define COMPARACAO_LIMIAR_PADRAO 0.1f // diferença de pixel (0 a 1) tolerada
+
+/*---------------------------------------------
+ * Custom types (enums, structs, unions, etc.)
+ *-------------------------------------------*/
+typedef struct ResultadoComparacao {
+    int diferentes;   // pixels acima do limiar
+    float fracao;     // diferentes / total
+    float maiorDelta; // maior diferença de um pixel, de 0 (igual) a 1
+} ResultadoComparacao;
+
+/*---------------------------------------------
+ * Function prototypes.
+ *-------------------------------------------*/
+/**
+ * @brief Compara duas imagens RGBA8 de largura x altura. O alfa é aplicado
+ * sobre fundo branco antes da comparação. Com mapa (largura x altura RGBA8,
+ * pode ser NULL), desenha a referência em cinza claro e os pixels diferentes
+ * em vermelho.
+ */
+ResultadoComparacao CompararImagens( const uint8_t *referencia, const uint8_t *imagem, int largura, int altura,
+                                     float limiar, uint8_t *mapa );
+
+#endif
@@ -0,0 +1,79 @@
+/**
+ * @file correntes.h
+ * @brief Deriva do lixo no mar: um campo de correntes pré-calculado
+ * (uma "textura" de vetores sobre o mapa) e a integração de posição e
+ * velocidade de muitos itens guardados em SoA, com afundamento que depende
+ * do material.
+ * @copyright Copyright (c) 2025
+ */
+#ifndef CORRENTES_H
+#define CORRENTES_H
+
+#include "raylib/raylib.h"
+#include "tarefas.h"
+
+/*---------------------------------------------
+ * Macros.
+ *-------------------------------------------*/
+#define CORRENTE_COLUNAS 64
+#define CORRENTE_LINHAS 32
+
+// abaixo disso o custo de acordar as threads é maior que o ganho
+#define DERIVA_MINIMO_PARALELO 4096
+
+/*---------------------------------------------
+ * Custom types (enums, structs, unions, etc.)
+ *-------------------------------------------*/
+/**
+ * @brief Velocidade da água (px/s) amostrada em uma grade que cobre o mapa.
+ * Entre os pontos da grade o valor é interpolado (bilinear).
+ */
+typedef struct CampoCorrente {
+    float vx[CORRENTE_LINHAS * CORRENTE_COLUNAS];
+    float vy[CORRENTE_LINHAS * CORRENTE_COLUNAS];
+    float largura;
+    float altura;
+} CampoCorrente;
+
+typedef struct Deriva {
+    float *x;
+    float *y;
+    float *vx;
+    float *vy;
+    float *afundamento; // velocidade final de afundamento (px/s) do item
+    int quantidade;
+    int capacidade;
+    float xMaximo;      // limites da posição (canto superior esquerdo)
+    float yMaximo;      // leito do mar: o item para quando chega aqui
+} Deriva;
+
+/*---------------------------------------------
+ * Function prototypes.
+ *-------------------------------------------*/
+/**
+ * @brief Preenche o campo com correntes suaves (soma de senoides) de
+ * intensidade até forca px/s.
+ */
+void CampoCorrenteGerar( CampoCorrente *campo, float largura, float altura, float forca, unsigned int semente );
+
+/**
+ * @brief Velocidade da água no ponto (x, y) do mapa.
+ */
+Vector2 CampoCorrenteAmostrar( const CampoCorrente *campo, float x, float y );
+
+void DerivaCriar( Deriva *deriva, int capacidade, float xMaximo, float yMaximo );
+void DerivaDestruir( Deriva *deriva );
+
+/**
+ * @brief Coloca o item parado em pos com a taxa de afundamento dada.
+ */
+void DerivaDefinir( Deriva *deriva, int indice, Vector2 pos, float afundamento );
+
+/**
+ * @brief Avança todos os itens em delta segundos. A corrente é
+ * multiplicada por intensidade (dificuldade). Com pool, o laço é dividido
+ * entre as threads quando há itens suficientes.
+ */
+void DerivaIntegrar( Deriva *deriva, const CampoCorrente *campo, float intensidade, float delta, PoolTarefas *pool );
+
+#endif
@@ -0,0 +1,154 @@
+/**
+ * @file entrada.h
+ * @brief Entrada dos dispositivos (teclado, controles, mouse e toque) lida
+ * uma vez por passo em um QuadroEntrada: um byte por jogador, no formato
+ * da rede e da gravação (REDE_*), os atalhos apertados e o ponteiro. O
+ * jogo só lê esse quadro, nunca a raylib direto.
+ *
+ * As mudanças das teclas dos jogadores viram eventos (apertou/soltou, com
+ * a hora da leitura) em um anel sem travas de um produtor e um consumidor,
+ * para quem mede a latência da entrada até a tela. A raylib não informa a
+ * hora em que o sistema recebeu a tecla; a hora é a da leitura, logo
+ * depois de a raylib buscar os eventos do sistema.
+ *
+ * As teclas de cada jogador e os atalhos podem ser trocados por um arquivo
+ * de texto (EntradaCarregarTeclas). Toque: arrastar um dedo move o primeiro
+ * mergulhador como um direcional e um toque curto é uma ação (quem usa o
+ * quadro decide qual).
+ * @copyright Copyright (c) 2025
+ */
+#ifndef ENTRADA_H
+#define ENTRADA_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "raylib/raylib.h"
+
+/*---------------------------------------------
+ * Macros.
+ *-------------------------------------------*/
+#define ENTRADA_MAX_JOGADORES 4
+#define ENTRADA_EVENTOS 256          // anel de eventos, potência de 2
+#define ENTRADA_EIXO_MORTO 0.5f      // analógico conta como direcional além disso
+#define ENTRADA_ARRASTO_MINIMO 24.0f // pixels do dedo até virar direção
+#define ENTRADA_TOQUE_CURTO 0.25     // segundos; mais que isso não é toque
+
+// botoes de controle viram teclas virtuais acima das do teclado, assim
+// os jogadores e o bot continuam trabalhando so com codigos de tecla
+#define TECLA_CONTROLE_BASE 1000
+#define TECLA_CONTROLE( gamepad, botao ) ( TECLA_CONTROLE_BASE + (gamepad) * 32 + (botao) )
+
+/*---------------------------------------------
+ * Custom types (enums, structs, unions, etc.)
+ *-------------------------------------------*/
+// teclas de cada jogador (do teclado ou TECLA_CONTROLE)
+typedef struct ControlesJogador {
+    int esquerda;
+    int direita;
+    int cima;
+    int baixo;
+    int pegar;
+    int descartar;
+} ControlesJogador;
+
+// teclas do jogo que não são de um jogador
+typedef enum AtalhoEntrada {
+    ATALHO_UM_JOGADOR,  // menu: quantidade de mergulhadores (1 a 4)
+    ATALHO_DOIS_JOGADORES,
+    ATALHO_TRES_JOGADORES,
+    ATALHO_QUATRO_JOGADORES,
+    ATALHO_SALVAR,      // quicksave
+    ATALHO_CARREGAR,
+    ATALHO_GANHAR,      // depuração
+    ATALHO_PERDER,
+    NUM_ATALHOS
+} AtalhoEntrada;
+
+// teclas falsas no lugar das dos jogadores (bots); os atalhos e o ponteiro
+// continuam vindo dos dispositivos
+typedef bool (*FonteTeclas)( int tecla, bool pressionada );
+
+typedef struct QuadroEntrada {
+    double tempo;                               // PlataformaTempo da leitura
+    uint8_t jogadores[ENTRADA_MAX_JOGADORES];   // bits REDE_*
+    uint16_t atalhos;                           // bit por AtalhoEntrada apertado neste passo
+    Vector2 ponteiro;                           // mouse ou primeiro dedo, em pixels da janela (o jogo converte)
+    bool clicou;                                // botão esquerdo ou dedo desceu neste passo
+    bool tocou;                                 // toque curto terminou neste passo
+} QuadroEntrada;
+
+typedef struct EventoEntrada {
+    double tempo;    // da leitura que viu a mudança
+    int tecla;
+    int8_t jogador;
+    uint8_t acao;    // bit REDE_* da tecla
+    bool apertou;    // false: soltou
+} EventoEntrada;
+
+typedef struct Entrada {
+
+    ControlesJogador teclado[ENTRADA_MAX_JOGADORES];  // layout de teclado de cada jogador
+    ControlesJogador controles[ENTRADA_MAX_JOGADORES]; // em uso (teclado ou controle)
+    int atalhos[NUM_ATALHOS];
+    FonteTeclas fonte; // NULL: dispositivos
+
+    QuadroEntrada atual;
+    uint16_t atalhosSegurados;
+    bool mouseSegurado;
+
+    // toque em andamento
+    bool tocando;
+    bool arrastou;
+    Vector2 origemToque;
+    double inicioToque;
+
+    // anel de eventos: EntradaLer produz, EntradaProximoEvento consome
+    bool registrarEventos; // ligado por quem consome
+    EventoEntrada eventos[ENTRADA_EVENTOS];
+    uint32_t escrita;
+    uint32_t leitura;
+    long long eventosPerdidos;
+
+} Entrada;
+
+/*---------------------------------------------
+ * Function prototypes.
+ *-------------------------------------------*/
+/**
+ * @brief Layouts de teclado e atalhos padrão; os controles em uso começam
+ * com o teclado.
+ */
+void EntradaCriar( Entrada *entrada );
+
+/**
+ * @brief Troca teclas a partir de um arquivo de texto com uma troca por
+ * linha: "<jogador 1-4> <acao> <codigo>" (acao: esquerda, direita, cima,
+ * baixo, pegar ou descartar) ou "atalho <nome> <codigo>" (nome: 1, 2, 3,
+ * 4, salvar, carregar, ganhar ou perder). O código é o KEY_* da raylib ou
+ * TECLA_CONTROLE(controle, botao); linhas com # são comentários. Retorna
+ * false se o arquivo não abrir ou tiver uma linha inválida (as linhas
+ * válidas antes dela ficam valendo).
+ */
+bool EntradaCarregarTeclas( Entrada *entrada, const char *arquivo );
+
+/**
+ * @brief Direcional, A (pegar) e B (descartar) do controle gamepad.
+ */
+ControlesJogador EntradaControlesDoGamepad( int gamepad );
+
+/**
+ * @brief Lê todos os dispositivos uma vez e monta entrada->atual para
+ * numJogadores jogadores (os outros ficam zerados).
+ */
+void EntradaLer( Entrada *entrada, int numJogadores );
+
+bool EntradaAtalho( const Entrada *entrada, AtalhoEntrada atalho );
+
+/**
+ * @brief Tira o evento mais antigo do anel. Retorna false se estiver vazio.
+ * Pode ser chamada de outra thread que não a de EntradaLer (uma só).
+ */
+bool EntradaProximoEvento( Entrada *entrada, EventoEntrada *evento );
+
+#endif
@@ -0,0 +1,73 @@
+/**
+ * @file estados.h
+ * @brief Máquina de estados do jogo: uma tabela com as funções de cada
+ * estado (atualizar, desenhar e os ganchos de entrada e saída). O quadro
+ * chama a função do estado atual direto pela tabela, e as trocas medem
+ * quanto tempo os ganchos levaram.
+ *
+ * Um estado novo (pausa, tutorial, placar) é só mais uma linha na tabela.
+ * @copyright Copyright (c) 2025
+ */
+#ifndef ESTADOS_H
+#define ESTADOS_H
+
+#include <stdio.h>
+
+/*---------------------------------------------
+ * Macros.
+ *-------------------------------------------*/
+#define ESTADOS_MAX 8
+
+/*---------------------------------------------
+ * Custom types (enums, structs, unions, etc.)
+ *-------------------------------------------*/
+typedef struct EstadoJogo {
+    const char *nome;
+    void (*entrar)( int anterior );   // pode ser NULL
+    void (*sair)( int proximo );      // pode ser NULL
+    void (*atualizar)( float delta );
+    void (*desenhar)( void );
+} EstadoJogo;
+
+// trocas de um estado para outro (ganchos de saída e entrada)
+typedef struct TempoTransicao {
+    long long vezes;
+    double totalMs;
+    double maiorMs;
+} TempoTransicao;
+
+typedef struct MaquinaEstados {
+    const EstadoJogo *estados;
+    int quantidade;
+    int atual;
+    double inicioAtual;                 // PlataformaTempo da última troca
+    double segundosEm[ESTADOS_MAX];     // tempo já passado em cada estado
+    TempoTransicao transicoes[ESTADOS_MAX][ESTADOS_MAX];
+} MaquinaEstados;
+
+/*---------------------------------------------
+ * Function prototypes.
+ *-------------------------------------------*/
+/**
+ * @brief Usa a tabela estados (quantidade <= ESTADOS_MAX, válida enquanto a
+ * máquina existir) e entra em inicial, chamando o gancho de entrada dele
+ * com anterior -1.
+ */
+void EstadosIniciar( MaquinaEstados *maquina, const EstadoJogo *estados, int quantidade, int inicial );
+
+/**
+ * @brief Sai do estado atual e entra em novo. O estado já é novo quando o
+ * gancho de entrada roda. Trocar para o mesmo estado não faz nada.
+ */
+void EstadosTrocar( MaquinaEstados *maquina, int novo );
+
+void EstadosAtualizar( MaquinaEstados *maquina, float delta );
+void EstadosDesenhar( MaquinaEstados *maquina );
+
+/**
+ * @brief Tempo em cada estado e, para cada par que aconteceu, quantas
+ * trocas e quanto os ganchos levaram.
+ */
+void EstadosRelatorio( const MaquinaEstados *maquina, FILE *saida );
+
+#endif
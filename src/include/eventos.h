@@ -0,0 +1,131 @@
+/**
+ * @file eventos.h
+ * @brief Log binário de eventos da sessão (coletas, descartes, mudanças de
+ * estado e tempo de quadro), só acrescentado ao fim do arquivo. O jogo
+ * guarda os eventos de cada quadro em um buffer próprio, sem travas, e no
+ * fim do quadro os passa de uma vez para um anel; uma thread tira lotes do
+ * anel, comprime e grava. A leitura (LogEventosLerLote) é usada pelas
+ * ferramentas de análise.
+ *
+ * Formato: cabeçalho ("OGEV" e versão) e lotes. Cada lote tem quantidade de
+ * eventos, tamanho em bytes e tempo do primeiro evento; cada evento grava o
+ * tipo, a diferença de tempo para o evento anterior em varint e só os campos
+ * que o seu tipo usa. Um quadro custa uns 6 bytes.
+ * @copyright Copyright (c) 2025
+ */
+#ifndef EVENTOS_H
+#define EVENTOS_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+
+#include "plataforma.h"
+
+/*---------------------------------------------
+ * Macros.
+ *-------------------------------------------*/
+#define EVENTOS_VERSAO 1
+#define EVENTOS_POR_QUADRO 256 // além disso o quadro perde eventos
+#define EVENTOS_ANEL 8192      // potência de 2
+#define EVENTOS_LOTE 512       // eventos por lote gravado
+
+/*---------------------------------------------
+ * Custom types (enums, structs, unions, etc.)
+ *-------------------------------------------*/
+typedef enum TipoEvento {
+    EVENTO_ABERTURA,  // início da execução; valor = segundos desde 1970
+    EVENTO_QUADRO,    // valor = duração do quadro em microssegundos
+    EVENTO_ESTADO,    // a = estado anterior, b = novo, valor = pontos da equipe
+    EVENTO_COLETA,    // jogador pegou lixo do tipo a
+    EVENTO_DESCARTE,  // jogador jogou lixo do tipo a na lixeira do tipo b; valor = pontos dele
+    NUM_TIPOS_EVENTO
+} TipoEvento;
+
+typedef struct Evento {
+    uint64_t tempo; // microssegundos desde a abertura do log
+    int32_t valor;
+    uint8_t tipo;
+    uint8_t jogador;
+    uint8_t a;
+    uint8_t b;
+} Evento;
+
+typedef struct LogEventos {
+
+    bool ativo;
+    double inicio;
+
+    // eventos do quadro atual (só o jogo mexe)
+    Evento quadro[EVENTOS_POR_QUADRO];
+    int quantidadeQuadro;
+
+    // anel entre o jogo e a thread de gravação
+    Evento *anel;
+    uint32_t inicioAnel;
+    uint32_t fimAnel;
+    PlataformaMutex *mutex;
+    PlataformaCond *cond;
+    bool encerrar;
+
+    // thread de gravação
+    PlataformaThread *thread;
+    FILE *saida;
+    Evento *lote;
+    uint8_t *comprimido;
+
+    long long perdidos; // quadro ou anel cheios
+    long long gravados;
+    long long bytes;
+
+} LogEventos;
+
+/*---------------------------------------------
+ * Function prototypes.
+ *-------------------------------------------*/
+/**
+ * @brief Abre arquivo para acrescentar (cria com o cabeçalho se não
+ * existir) e inicia a thread de gravação. Um lote cortado no fim do
+ * arquivo, deixado por uma execução que caiu, é descartado antes. Com
+ * arquivo NULL o log fica desligado e registrar não faz nada. Retorna
+ * false em caso de falha ou se o arquivo não for um log de eventos.
+ */
+bool LogEventosAbrir( LogEventos *log, const char *arquivo );
+
+/**
+ * @brief Grava o que falta e fecha o arquivo.
+ */
+void LogEventosFechar( LogEventos *log );
+
+/**
+ * @brief Guarda um evento no buffer do quadro atual. Não trava nem faz I/O.
+ */
+void LogEventosRegistrar( LogEventos *log, TipoEvento tipo, int jogador, int a, int b, int32_t valor );
+
+/**
+ * @brief Registra o tempo do quadro e passa os eventos do quadro para a
+ * thread de gravação, que é acordada quando há um lote completo.
+ */
+void LogEventosFimDoQuadro( LogEventos *log, float ms );
+
+/**
+ * @brief Confere o cabeçalho e avança pos até o primeiro lote.
+ */
+bool LogEventosLerCabecalho( const uint8_t *dados, size_t tamanho, size_t *pos );
+
+/**
+ * @brief Avança pos até o próximo lote sem descomprimir (para dividir um
+ * log entre threads). Retorna false no fim dos dados ou se o lote estiver
+ * truncado.
+ */
+bool LogEventosPularLote( const uint8_t *dados, size_t tamanho, size_t *pos );
+
+/**
+ * @brief Descomprime o lote em pos para eventos (EVENTOS_LOTE posições) e
+ * avança pos. Retorna a quantidade de eventos, 0 no fim dos dados ou -1 se
+ * o lote estiver truncado ou corrompido.
+ */
+int LogEventosLerLote( const uint8_t *dados, size_t tamanho, size_t *pos, Evento *eventos );
+
+#endif
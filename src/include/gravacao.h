@@ -0,0 +1,68 @@
+/**
+ * @file gravacao.h
+ * @brief Gravação das entradas de uma partida, um byte por mergulhador a
+ * cada passo de 1/60 s, no mesmo formato das entradas da rede (REDE_*).
+ * Os cenários do benchmark repetem essas gravações, assim cada execução
+ * recebe exatamente as mesmas teclas.
+ *
+ * Formato: cabeçalho ("OGEN", versão, mergulhadores e passos) seguido dos
+ * bytes de cada passo, na ordem dos mergulhadores.
+ * @copyright Copyright (c) 2025
+ */
+#ifndef GRAVACAO_H
+#define GRAVACAO_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+/*---------------------------------------------
+ * Macros.
+ *-------------------------------------------*/
+#define GRAVACAO_VERSAO 1
+#define GRAVACAO_MAX_JOGADORES 4
+
+/*---------------------------------------------
+ * Custom types (enums, structs, unions, etc.)
+ *-------------------------------------------*/
+typedef struct GravacaoEntradas {
+    int numJogadores;
+    int passos;
+    int capacidade; // em passos
+    uint8_t *entradas; // passos * numJogadores bytes
+} GravacaoEntradas;
+
+/*---------------------------------------------
+ * Function prototypes.
+ *-------------------------------------------*/
+/**
+ * @brief Gravação vazia para numJogadores mergulhadores.
+ */
+void GravacaoCriar( GravacaoEntradas *gravacao, int numJogadores );
+
+/**
+ * @brief Libera a memória da gravação.
+ */
+void GravacaoDestruir( GravacaoEntradas *gravacao );
+
+/**
+ * @brief Acrescenta um passo (uma entrada por mergulhador).
+ */
+void GravacaoAdicionar( GravacaoEntradas *gravacao, const uint8_t *entradas );
+
+/**
+ * @brief Entradas do passo (volta ao início depois do último passo).
+ */
+const uint8_t *GravacaoPasso( const GravacaoEntradas *gravacao, long long passo );
+
+/**
+ * @brief Grava em arquivo. Retorna false em caso de falha.
+ */
+bool GravacaoSalvar( const GravacaoEntradas *gravacao, const char *arquivo );
+
+/**
+ * @brief Lê a gravação de arquivo. Retorna false se o arquivo não existir,
+ * não for uma gravação desta versão ou estiver vazio.
+ */
+bool GravacaoCarregar( GravacaoEntradas *gravacao, const char *arquivo );
+
+#endif
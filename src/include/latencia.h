@@ -0,0 +1,93 @@
+/**
+ * @file latencia.h
+ * @brief Sonda de latência da entrada até a tela e atraso de quadro do modo
+ * de baixa latência.
+ *
+ * A sonda tira do anel da Entrada os apertos de tecla dos jogadores (com a
+ * hora da leitura) e, quando o quadro que já mostra o efeito deles termina
+ * de ir para a tela, guarda a diferença em ms. O resumo sai com média e
+ * percentis, como o do medidor de quadros.
+ *
+ * O atraso de quadro é quanto esperar depois da última apresentação antes
+ * de ler a entrada: quanto mais perto da próxima troca a leitura acontece,
+ * menos tempo a tecla fica parada esperando. No automático, o atraso é o
+ * período da tela menos o maior custo recente de atualizar e desenhar, com
+ * uma margem; cai na hora quando um quadro pesa e sobe devagar.
+ * @copyright Copyright (c) 2025
+ */
+#ifndef LATENCIA_H
+#define LATENCIA_H
+
+#include <stdbool.h>
+#include <stdio.h>
+
+#include "entrada.h"
+
+/*---------------------------------------------
+ * Macros.
+ *-------------------------------------------*/
+#define LATENCIA_PENDENTES 64       // apertos esperando a tela
+#define LATENCIA_AMOSTRAS 8192
+#define ATRASO_QUADRO_CUSTOS 64     // quadros olhados pelo automático
+#define ATRASO_QUADRO_MARGEM 0.0015 // segundos de folga antes da troca
+
+/*---------------------------------------------
+ * Custom types (enums, structs, unions, etc.)
+ *-------------------------------------------*/
+typedef struct SondaLatencia {
+    double pendentes[LATENCIA_PENDENTES]; // hora de cada aperto ainda não na tela
+    int quantidadePendentes;
+    float amostras[LATENCIA_AMOSTRAS];    // ms até a tela; as mais antigas saem
+    int quantidade;
+    long long medidos;
+    long long descartados;                // pendentes demais no mesmo quadro
+} SondaLatencia;
+
+typedef struct AtrasoQuadro {
+    bool automatico;
+    double atraso;                        // segundos depois da última apresentação
+    double periodo;                       // segundos entre trocas da tela
+    float custos[ATRASO_QUADRO_CUSTOS];   // segundos de atualizar + desenhar
+    int proximoCusto;
+    int quantidadeCustos;
+} AtrasoQuadro;
+
+/*---------------------------------------------
+ * Function prototypes.
+ *-------------------------------------------*/
+void SondaLatenciaCriar( SondaLatencia *sonda );
+
+/**
+ * @brief Tira do anel da entrada os apertos (as solturas não contam) e os
+ * guarda até a próxima apresentação. Chamar depois de atualizar o passo
+ * que leu a entrada.
+ */
+void SondaLatenciaColetar( SondaLatencia *sonda, Entrada *entrada );
+
+/**
+ * @brief Há apertos esperando a tela (o quadro desenhado agora é o primeiro
+ * a mostrar o efeito deles).
+ */
+bool SondaLatenciaPendente( const SondaLatencia *sonda );
+
+/**
+ * @brief O quadro com os apertos pendentes chegou à tela na hora tempo
+ * (PlataformaTempo); vira uma amostra por aperto.
+ */
+void SondaLatenciaApresentado( SondaLatencia *sonda, double tempo );
+
+void SondaLatenciaRelatorio( SondaLatencia *sonda, FILE *saida );
+
+/**
+ * @brief Atraso fixo em segundos ou, com atraso negativo, automático.
+ * periodo é o tempo entre trocas da tela.
+ */
+void AtrasoQuadroCriar( AtrasoQuadro *atraso, double periodo, double segundos );
+
+/**
+ * @brief Registra quanto o quadro levou entre ler a entrada e mandar o
+ * desenho (segundos) e recalcula o atraso automático.
+ */
+void AtrasoQuadroRegistrar( AtrasoQuadro *atraso, double custo );
+
+#endif
@@ -0,0 +1,78 @@
+/**
+ * @file medidor.h
+ * @brief Medição do tempo de quadro e da memória para sessões longas. As
+ * amostras são agrupadas em janelas de alguns segundos e cada janela vira
+ * uma linha CSV com média, percentis e memória residente.
+ * @copyright Copyright (c) 2025
+ */
+#ifndef MEDIDOR_H
+#define MEDIDOR_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdio.h>
+
+/*---------------------------------------------
+ * Macros.
+ *-------------------------------------------*/
+// amostras guardadas por janela; a janela fecha antes se encher
+#define MEDIDOR_AMOSTRAS 8192
+
+/*---------------------------------------------
+ * Custom types (enums, structs, unions, etc.)
+ *-------------------------------------------*/
+typedef struct MedidorQuadros {
+
+    // janela atual
+    float amostras[MEDIDOR_AMOSTRAS]; // ms por quadro
+    int quantidade;
+    double inicioJanela;
+    double intervalo; // segundos por linha
+
+    FILE *saida;
+    double inicio;
+
+    // totais desde MedidorCriar
+    long long quadros;
+    double somaMs;
+    float maximoMs;
+    size_t memoriaInicial;
+    size_t memoriaMaxima;
+
+} MedidorQuadros;
+
+// média e percentis de uma série de tempos (ms)
+typedef struct ResumoTempos {
+    float media;
+    float p50;
+    float p90;
+    float p99;
+    float maximo;
+} ResumoTempos;
+
+/*---------------------------------------------
+ * Function prototypes.
+ *-------------------------------------------*/
+/**
+ * @brief Abre arquivo (ou usa stdout quando NULL) e escreve o cabeçalho.
+ * Retorna false se o arquivo não pôde ser criado.
+ */
+bool MedidorCriar( MedidorQuadros *medidor, const char *arquivo, double intervalo );
+
+/**
+ * @brief Fecha a última janela, escreve o resumo em stdout e fecha o arquivo.
+ */
+void MedidorDestruir( MedidorQuadros *medidor );
+
+/**
+ * @brief Registra a duração de um quadro em milissegundos.
+ */
+void MedidorRegistrar( MedidorQuadros *medidor, float ms );
+
+/**
+ * @brief Ordena as amostras e calcula média e percentis (zeros se a série
+ * estiver vazia).
+ */
+ResumoTempos MedidorResumir( float *amostras, int quantidade );
+
+#endif
@@ -0,0 +1,96 @@
+/**
+ * @file memoria.h
+ * @brief Alocador com contagem: todo malloc/free do jogo passa por aqui com
+ * o subsistema que pediu a memória. Guarda alocações, liberações, bytes
+ * vivos e pico de cada subsistema e quantas alocações a thread principal
+ * fez no quadro atual, para conferir que a partida em andamento não aloca.
+ *
+ * Compilado com MEMORIA_CONTAR_RAYLIB e ligado com
+ * -Wl,--wrap=malloc,--wrap=calloc,--wrap=realloc,--wrap=free (raylib
+ * estática, como no Windows), o malloc/free de dentro da raylib também é
+ * contado, no subsistema MEMORIA_RAYLIB (só chamadas, sem bytes).
+ * @copyright Copyright (c) 2025
+ */
+#ifndef MEMORIA_H
+#define MEMORIA_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdio.h>
+
+/*---------------------------------------------
+ * Custom types (enums, structs, unions, etc.)
+ *-------------------------------------------*/
+typedef enum SubsistemaMemoria {
+    MEMORIA_JOGO,       // main.c: lixos, quicksave, medições
+    MEMORIA_MUNDO,      // grade espacial
+    MEMORIA_COLISAO,
+    MEMORIA_CORRENTES,
+    MEMORIA_PARTICULAS,
+    MEMORIA_CARDUME,
+    MEMORIA_NAVEGACAO,
+    MEMORIA_STREAMING,
+    MEMORIA_REDE,
+    MEMORIA_EVENTOS,
+    MEMORIA_PLACAR,
+    MEMORIA_GRAVACAO,
+    MEMORIA_TAREFAS,
+    MEMORIA_PLATAFORMA,
+    MEMORIA_ARENA,      // blocos das arenas de quadro
+    MEMORIA_RAYLIB,     // malloc/free de fora do jogo (só com MEMORIA_CONTAR_RAYLIB)
+    NUM_SUBSISTEMAS_MEMORIA
+} SubsistemaMemoria;
+
+typedef struct EstatisticaMemoria {
+    long long alocacoes;
+    long long liberacoes;
+    long long bytesVivos;
+    long long picoBytes;
+    long long alocacoesEmPartida; // em quadros marcados em MemoriaFimDoQuadro
+} EstatisticaMemoria;
+
+/*---------------------------------------------
+ * Function prototypes.
+ *-------------------------------------------*/
+/**
+ * @brief Como malloc, calloc e realloc, contando para o subsistema. Os
+ * blocos só podem ser liberados com MemoriaLiberar (nunca por free ou pela
+ * raylib).
+ */
+void *MemoriaAlocar( SubsistemaMemoria subsistema, size_t tamanho );
+void *MemoriaZerada( SubsistemaMemoria subsistema, size_t quantidade, size_t tamanho );
+void *MemoriaRealocar( SubsistemaMemoria subsistema, void *bloco, size_t tamanho );
+
+/**
+ * @brief Como free, para blocos de MemoriaAlocar/Zerada/Realocar.
+ */
+void MemoriaLiberar( void *bloco );
+
+/**
+ * @brief Marca a thread atual como a do jogo: só as alocações dela entram
+ * na contagem do quadro (decodificação do streaming, gravação do log e
+ * tarefas alocam em paralelo sem serem do quadro).
+ */
+void MemoriaThreadPrincipal( void );
+
+/**
+ * @brief Fecha o quadro: retorna quantas alocações a thread principal fez
+ * desde a última chamada e, com porSubsistema (NUM_SUBSISTEMAS_MEMORIA
+ * posições, pode ser NULL), quantas de cada subsistema. Com emPartida, elas
+ * somam em alocacoesEmPartida.
+ */
+int MemoriaFimDoQuadro( bool emPartida, int *porSubsistema );
+
+/**
+ * @brief Totais de um subsistema desde o início do programa.
+ */
+EstatisticaMemoria MemoriaEstatistica( SubsistemaMemoria subsistema );
+
+const char *MemoriaNomeSubsistema( SubsistemaMemoria subsistema );
+
+/**
+ * @brief Tabela com os totais de cada subsistema que alocou algo.
+ */
+void MemoriaRelatorio( FILE *saida );
+
+#endif
@@ -0,0 +1,100 @@
+/**
+ * @file mundo.h
+ * @brief Mapa do oceano maior que a janela: câmera que segue o mergulhador
+ * e grade espacial usada para desenhar apenas o que está visível.
+ * @copyright Copyright (c) 2025
+ */
+#ifndef MUNDO_H
+#define MUNDO_H
+
+#include <stdbool.h>
+
+#include "raylib/raylib.h"
+
+/*---------------------------------------------
+ * Macros.
+ *-------------------------------------------*/
+// dimensões do mapa em pixels de mundo (6 x 4 telas de fundo)
+#define MUNDO_WIDTH 4608
+#define MUNDO_HEIGHT 2048
+
+// tela virtual: o jogo desenha sempre nesse tamanho e a janela mostra a
+// tela escalada (tela.h)
+#define TELA_LARGURA 800
+#define TELA_ALTURA 600
+
+// cada ladrilho do fundo é uma cópia de fundo.jpg nesse tamanho
+#define FUNDO_TILE_WIDTH 768
+#define FUNDO_TILE_HEIGHT 512
+
+// a grade espacial divide o mapa em células quadradas
+#define GRADE_CELULA 128
+#define GRADE_COLUNAS ( MUNDO_WIDTH / GRADE_CELULA )
+#define GRADE_LINHAS ( MUNDO_HEIGHT / GRADE_CELULA )
+
+/*---------------------------------------------
+ * Custom types (enums, structs, unions, etc.)
+ *-------------------------------------------*/
+/**
+ * @brief Grade uniforme com uma lista encadeada de itens por célula.
+ * Cada item fica na célula da sua posição (canto superior esquerdo), então
+ * os itens precisam ser menores que uma célula.
+ */
+typedef struct GradeEspacial {
+    int cabeca[GRADE_COLUNAS * GRADE_LINHAS]; // primeiro item da célula (-1 = vazia)
+    int *proximo;                             // próximo item na mesma célula
+    int *celula;                              // célula de cada item (-1 = fora da grade)
+    int capacidade;
+} GradeEspacial;
+
+/*---------------------------------------------
+ * Function prototypes.
+ *-------------------------------------------*/
+/**
+ * @brief Aloca a grade para itens com índices em [0, capacidade).
+ */
+void GradeCriar( GradeEspacial *grade, int capacidade );
+
+/**
+ * @brief Libera a memória da grade.
+ */
+void GradeDestruir( GradeEspacial *grade );
+
+/**
+ * @brief Remove todos os itens da grade.
+ */
+void GradeLimpar( GradeEspacial *grade );
+
+/**
+ * @brief Insere (ou move) o item na célula correspondente à posição.
+ */
+void GradeInserir( GradeEspacial *grade, int indice, Vector2 pos );
+
+/**
+ * @brief Retira o item da grade, se estiver nela.
+ */
+void GradeRemover( GradeEspacial *grade, int indice );
+
+/**
+ * @brief Escreve em resultado os itens que podem tocar a área e retorna
+ * quantos foram escritos (no máximo maxResultado).
+ */
+int GradeConsultar( const GradeEspacial *grade, Rectangle area, int *resultado, int maxResultado );
+
+/**
+ * @brief Move a câmera suavemente em direção ao alvo sem mostrar nada além
+ * das bordas do mapa.
+ */
+void AtualizarCamera( Camera2D *camera, Vector2 alvo, float delta );
+
+/**
+ * @brief Posiciona a câmera direto no alvo (usado ao iniciar a partida).
+ */
+void CentralizarCamera( Camera2D *camera, Vector2 alvo );
+
+/**
+ * @brief Retângulo do mundo que a câmera está mostrando.
+ */
+Rectangle AreaVisivel( Camera2D camera );
+
+#endif
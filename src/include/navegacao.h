@@ -0,0 +1,139 @@
+/**
+ * @file navegacao.h
+ * @brief Grade de navegação montada a partir das rochas do mapa e campos de
+ * fluxo (flow fields). Cada campo guarda, para todas as células, o custo até
+ * um objetivo e a direção do próximo passo, então qualquer quantidade de
+ * agentes indo para o mesmo lugar consulta o mesmo campo em vez de rodar um
+ * A* por agente. Quando uma rocha muda, só as células afetadas são
+ * recalculadas.
+ * @copyright Copyright (c) 2025
+ */
+#ifndef NAVEGACAO_H
+#define NAVEGACAO_H
+
+#include <stdbool.h>
+
+#include "raylib/raylib.h"
+
+/*---------------------------------------------
+ * Macros.
+ *-------------------------------------------*/
+#define NAV_INALCANCAVEL 0x3fffffff
+
+// célula usada quando não há arquivo de rochas
+#define NAV_CELULA_PADRAO 64
+
+// custo de um passo reto e na diagonal (aproxima 1 : raiz de 2)
+#define NAV_CUSTO_RETO 10
+#define NAV_CUSTO_DIAGONAL 14
+
+/*---------------------------------------------
+ * Custom types (enums, structs, unions, etc.)
+ *-------------------------------------------*/
+typedef struct NavGrade {
+
+    int colunas;
+    int linhas;
+    int celula; // lado da célula em pixels de mundo
+    int folga;  // células livres exigidas ao redor de uma rocha
+
+    unsigned char *rocha;     // obstáculo do mapa
+    unsigned char *bloqueada; // rocha aumentada pela folga: o centro de um
+                              // agente nunca entra nessas células
+
+    // células de bloqueada que mudaram desde NavLimparAlteracoes
+    int *alteradas;
+    int quantidadeAlteradas;
+    int capacidadeAlteradas;
+
+} NavGrade;
+
+typedef struct CampoFluxo {
+
+    int destino;   // célula pedida
+    int objetivo;  // destino ou, se ele estiver na folga de uma rocha, a
+                   // célula livre mais próxima dele
+    int *distancia; // custo até o objetivo ou NAV_INALCANCAVEL
+    int *proximo;   // próxima célula do caminho (-1 no objetivo ou sem caminho)
+    float *direcaoX; // vetor unitário do centro da célula ao centro de proximo
+    float *direcaoY;
+
+    // heap de (distância, célula) e região invalidada, reutilizados entre
+    // atualizações
+    long long *heap;
+    int quantidadeHeap;
+    int capacidadeHeap;
+    int *regiao;
+
+} CampoFluxo;
+
+/*---------------------------------------------
+ * Function prototypes.
+ *-------------------------------------------*/
+/**
+ * @brief Grade toda livre com colunas x linhas células.
+ */
+void NavGradeCriar( NavGrade *nav, int colunas, int linhas, int celula, int folga );
+
+/**
+ * @brief Lê as rochas de um arquivo (formato descrito em
+ * resources/mapa/rochas.txt). Sem o arquivo, ou se ele não cobrir
+ * largura x altura, a grade fica livre e a função retorna false.
+ */
+bool NavGradeCarregar( NavGrade *nav, const char *arquivo, int largura, int altura, int folga );
+
+void NavGradeDestruir( NavGrade *nav );
+
+/**
+ * @brief Coloca ou tira uma rocha e registra as células bloqueadas que
+ * mudaram. Depois de atualizar todos os campos com FluxoAtualizar, chame
+ * NavLimparAlteracoes.
+ */
+void NavDefinirRocha( NavGrade *nav, int cx, int cy, bool rocha );
+void NavLimparAlteracoes( NavGrade *nav );
+
+/**
+ * @brief Célula que contém pos (limitada à grade).
+ */
+int NavCelula( const NavGrade *nav, Vector2 pos );
+
+/**
+ * @brief Verdadeiro se o retângulo encosta em alguma rocha.
+ */
+bool NavRetanguloNaRocha( const NavGrade *nav, Rectangle rec );
+
+/**
+ * @brief Desenha as rochas que aparecem em visivel.
+ */
+void NavDesenharRochas( const NavGrade *nav, Rectangle visivel, Color cor );
+
+/**
+ * @brief Aloca o campo e calcula os caminhos até a célula de destino.
+ */
+void FluxoCriar( CampoFluxo *campo, const NavGrade *nav, Vector2 destino );
+void FluxoDestruir( CampoFluxo *campo );
+
+/**
+ * @brief Recalcula o campo inteiro (Dijkstra a partir do objetivo).
+ */
+void FluxoRecalcular( CampoFluxo *campo, const NavGrade *nav );
+
+/**
+ * @brief Troca o destino; só recalcula se ele mudou de célula.
+ */
+void FluxoDefinirDestino( CampoFluxo *campo, const NavGrade *nav, Vector2 destino );
+
+/**
+ * @brief Corrige o campo depois de NavDefinirRocha: invalida só as células
+ * cujo caminho passava por uma célula que fechou e propaga a partir da
+ * borda da região afetada.
+ */
+void FluxoAtualizar( CampoFluxo *campo, const NavGrade *nav );
+
+/**
+ * @brief Direção (unitária) para seguir a partir de pos, ou (0, 0) no
+ * objetivo ou quando não há caminho.
+ */
+Vector2 FluxoDirecao( const CampoFluxo *campo, const NavGrade *nav, Vector2 pos );
+
+#endif
@@ -0,0 +1,66 @@
+/**
+ * @file particulas.h
+ * @brief Sistema de partículas (bolhas e respingos). Cada emissor guarda as
+ * partículas em arrays separados por campo (SoA), integra com SSE2 quando
+ * disponível e desenha tudo em um único lote do rlgl.
+ * @copyright Copyright (c) 2025
+ */
+#ifndef PARTICULAS_H
+#define PARTICULAS_H
+
+#include "raylib/raylib.h"
+
+/*---------------------------------------------
+ * Custom types (enums, structs, unions, etc.)
+ *-------------------------------------------*/
+typedef struct Emissor {
+
+    // um array por campo; a capacidade é múltipla de 4 para o laço SIMD
+    float *x;
+    float *y;
+    float *vx;
+    float *vy;
+    float *vida;
+    float *tamanho;
+    int quantidade;
+    int capacidade;
+
+    Vector2 aceleracao; // empuxo/gravidade aplicado a todas as partículas
+    float arrasto;      // fração da velocidade perdida por segundo
+    float vidaMaxima;   // usada para o fade out
+    Color cor;
+    Texture2D textura;
+
+} Emissor;
+
+/*---------------------------------------------
+ * Function prototypes.
+ *-------------------------------------------*/
+/**
+ * @brief Aloca um emissor com espaço para capacidade partículas.
+ */
+void EmissorCriar( Emissor *emissor, int capacidade, Texture2D textura, Vector2 aceleracao, float arrasto, float vidaMaxima, Color cor );
+
+/**
+ * @brief Libera os arrays do emissor (a textura pertence a quem chamou).
+ */
+void EmissorDestruir( Emissor *emissor );
+
+/**
+ * @brief Cria até quantidade partículas em pos com a velocidade base mais
+ * um desvio aleatório de até espalhamento em cada eixo. Partículas que não
+ * cabem são descartadas.
+ */
+void EmissorEmitir( Emissor *emissor, Vector2 pos, int quantidade, Vector2 velocidade, float espalhamento, float tamanho );
+
+/**
+ * @brief Integra as partículas e remove as que morreram.
+ */
+void EmissorAtualizar( Emissor *emissor, float delta );
+
+/**
+ * @brief Desenha as partículas dentro da área visível em um único lote.
+ */
+void EmissorDesenhar( const Emissor *emissor, Rectangle visivel );
+
+#endif
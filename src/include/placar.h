@@ -0,0 +1,96 @@
+/**
+ * @file placar.h
+ * @brief Placar persistente: cada partida grava um registro por
+ * mergulhador, e o ranking e os recordes de cada jogador (J1 a J4) e da
+ * equipe saem desses registros. A gravação roda em uma thread própria, que
+ * escreve um arquivo temporário e o troca pelo placar com rename, então o
+ * laço do jogo nunca espera o disco e uma queda no meio da gravação não
+ * corrompe o placar. O arquivo é um cabeçalho seguido dos registros como
+ * estão na memória, lido com um único fread.
+ *
+ * Quando o histórico enche, os PLACAR_DESCARTE registros mais antigos são
+ * descartados, menos os que sustentam o ranking e os recordes, que
+ * continuam iguais depois da carga.
+ * @copyright Copyright (c) 2025
+ */
+#ifndef PLACAR_H
+#define PLACAR_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "plataforma.h"
+
+/*---------------------------------------------
+ * Macros.
+ *-------------------------------------------*/
+#define PLACAR_VERSAO 1
+#define PLACAR_MAX_REGISTROS 65536 // histórico guardado (1 MiB)
+#define PLACAR_DESCARTE ( PLACAR_MAX_REGISTROS / 4 ) // antigos descartados quando enche
+#define PLACAR_MAX_JOGADORES 4
+#define PLACAR_RANKING 5 // melhores pontuações individuais mostradas
+
+/*---------------------------------------------
+ * Custom types (enums, structs, unions, etc.)
+ *-------------------------------------------*/
+// 16 bytes sem preenchimento: o arquivo é o array como está na memória
+typedef struct RegistroPlacar {
+    int32_t pontuacao;   // do mergulhador
+    int32_t equipe;      // soma da equipe na partida
+    uint32_t data;       // segundos desde 1970
+    uint8_t jogador;     // 0 a 3
+    uint8_t numJogadores;
+    uint8_t vitoria;
+    uint8_t reservado;
+} RegistroPlacar;
+
+typedef struct Placar {
+
+    RegistroPlacar *registros; // PLACAR_MAX_REGISTROS posições, do mais antigo ao mais novo
+    int quantidade;
+
+    // calculados na carga e atualizados a cada partida
+    RegistroPlacar ranking[PLACAR_RANKING];
+    int tamanhoRanking;
+    int melhorJogador[PLACAR_MAX_JOGADORES];
+    int melhorEquipe;
+
+    // gravação em segundo plano
+    char arquivo[256];
+    char temporario[264];
+    PlataformaThread *thread;
+    PlataformaMutex *mutex;
+    PlataformaCond *cond;
+    int gravados;     // registros já no disco
+    int publicados;   // registros que a thread pode gravar
+    bool encerrar;
+    bool gravando;    // a thread está lendo os registros
+    bool falhou;      // a última gravação não chegou ao disco
+
+} Placar;
+
+/*---------------------------------------------
+ * Function prototypes.
+ *-------------------------------------------*/
+/**
+ * @brief Carrega o placar de arquivo (ou do temporário, se a última
+ * gravação caiu antes do rename) e inicia a thread de gravação. Com
+ * arquivo NULL o placar fica só na memória. Arquivo inexistente ou
+ * corrompido começa vazio. Retorna false se faltou memória.
+ */
+bool PlacarAbrir( Placar *placar, const char *arquivo );
+
+/**
+ * @brief Espera a gravação pendente terminar e libera o placar.
+ */
+void PlacarFechar( Placar *placar );
+
+/**
+ * @brief Acrescenta os registros de uma partida e acorda a thread de
+ * gravação, sem esperar o disco. Com o histórico cheio, descarta os
+ * registros mais antigos antes; só aí espera a gravação em andamento, se
+ * houver. Retorna false se quantidade não cabe nem assim.
+ */
+bool PlacarRegistrar( Placar *placar, const RegistroPlacar *registros, int quantidade );
+
+#endif
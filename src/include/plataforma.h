@@ -0,0 +1,120 @@
+/**
+ * @file plataforma.h
+ * @brief Threads, mutex, variáveis de condição e relógio de alta resolução
+ * com a mesma interface no Linux (POSIX) e no Windows (API Win32). A
+ * implementação não inclui a raylib, pois windows.h e raylib.h não podem ser
+ * usados juntos.
+ * @copyright Copyright (c) 2025
+ */
+#ifndef PLATAFORMA_H
+#define PLATAFORMA_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+
+/*---------------------------------------------
+ * Custom types (enums, structs, unions, etc.)
+ *-------------------------------------------*/
+typedef struct PlataformaThread PlataformaThread;
+typedef struct PlataformaMutex PlataformaMutex;
+typedef struct PlataformaCond PlataformaCond;
+
+typedef void (*PlataformaFuncaoThread)( void *dados );
+
+/*---------------------------------------------
+ * Function prototypes.
+ *-------------------------------------------*/
+/**
+ * @brief Inicia uma thread que executa funcao(dados). Retorna NULL em caso
+ * de falha.
+ */
+PlataformaThread *ThreadCriar( PlataformaFuncaoThread funcao, void *dados );
+
+/**
+ * @brief Espera a thread terminar e libera seus recursos.
+ */
+void ThreadAguardar( PlataformaThread *thread );
+
+PlataformaMutex *MutexCriar( void );
+void MutexDestruir( PlataformaMutex *mutex );
+void MutexTravar( PlataformaMutex *mutex );
+void MutexDestravar( PlataformaMutex *mutex );
+
+PlataformaCond *CondCriar( void );
+void CondDestruir( PlataformaCond *cond );
+
+/**
+ * @brief Libera o mutex (que deve estar travado), dorme até um sinal e
+ * trava o mutex de novo antes de retornar.
+ */
+void CondEsperar( PlataformaCond *cond, PlataformaMutex *mutex );
+void CondSinalizar( PlataformaCond *cond );
+void CondSinalizarTodos( PlataformaCond *cond );
+
+/**
+ * @brief Relógio monotônico em segundos. Ao contrário de GetTime(), não
+ * depende de uma janela aberta.
+ */
+double PlataformaTempo( void );
+
+/**
+ * @brief Suspende a thread atual por pelo menos a quantidade de segundos.
+ */
+void PlataformaDormir( double segundos );
+
+/**
+ * @brief Espera até o relógio de PlataformaTempo chegar a tempo, com
+ * precisão de microssegundos (dorme e termina em espera ativa).
+ */
+void PlataformaDormirAte( double tempo );
+
+/**
+ * @brief Espera a GPU terminar tudo o que recebeu, inclusive a troca de
+ * buffers (glFinish). Logo depois do EndDrawing, com vsync, volta quando o
+ * quadro foi para a tela e o driver fica sem quadros na fila. Precisa do
+ * contexto OpenGL da janela.
+ */
+void PlataformaEsperarGpu( void );
+
+/**
+ * @brief Esvazia o buffer do arquivo e espera os dados chegarem ao disco.
+ */
+bool PlataformaGravarNoDisco( FILE *arquivo );
+
+/**
+ * @brief Troca destino por origem de uma vez (rename atômico), mesmo que
+ * destino já exista.
+ */
+bool PlataformaSubstituirArquivo( const char *origem, const char *destino );
+
+/**
+ * @brief Corta o arquivo (fechado) em tamanho bytes.
+ */
+bool PlataformaTruncarArquivo( const char *caminho, size_t tamanho );
+
+/**
+ * @brief Mapeia o arquivo inteiro na memória, só para leitura. Retorna NULL
+ * se o arquivo não abrir ou estiver vazio.
+ */
+const uint8_t *PlataformaMapearArquivo( const char *caminho, size_t *tamanho );
+void PlataformaDesmapearArquivo( const uint8_t *dados, size_t tamanho );
+
+/**
+ * @brief Quantidade de núcleos lógicos da máquina (pelo menos 1).
+ */
+int PlataformaNucleos( void );
+
+/**
+ * @brief Memória residente do processo em bytes (0 se não disponível).
+ */
+size_t PlataformaMemoriaResidente( void );
+
+/**
+ * @brief Bytes alocados com malloc e ainda não liberados (0 se não
+ * disponível). Percorre o heap: serve para amostras, não para cada quadro.
+ */
+size_t PlataformaMemoriaHeap( void );
+
+#endif
@@ -0,0 +1,92 @@
+/**
+ * @file qualidade.h
+ * @brief Governador de qualidade: acompanha o tempo de quadro e troca o
+ * nível de qualidade (MSAA, escala da renderização, partículas e ritmo das
+ * animações) para segurar o FPS alvo em máquinas fracas.
+ *
+ * Os quadros são vistos em janelas de QUALIDADE_JANELA. Desce um nível
+ * depois de QUALIDADE_JANELAS_RUINS janelas seguidas abaixo do FPS alvo;
+ * sobe depois de uma sequência de janelas com folga no custo do quadro.
+ * Para não oscilar, as faixas de descer e subir são separadas, a janela
+ * logo depois de uma troca é ignorada e, quando uma subida precisa ser
+ * desfeita logo em seguida, a próxima subida exige o dobro de janelas.
+ *
+ * O governador só decide; quem desenha aplica o NivelQualidade.
+ * @copyright Copyright (c) 2025
+ */
+#ifndef QUALIDADE_H
+#define QUALIDADE_H
+
+#include <stdbool.h>
+#include <stdio.h>
+
+/*---------------------------------------------
+ * Macros.
+ *-------------------------------------------*/
+#define QUALIDADE_JANELA 30               // quadros por janela (0,5 s a 60 FPS)
+#define QUALIDADE_JANELAS_RUINS 2         // seguidas, para descer
+#define QUALIDADE_JANELAS_FOLGA 6         // seguidas, para subir (dobra a cada subida desfeita)
+#define QUALIDADE_JANELAS_FOLGA_MAXIMO 64
+#define QUALIDADE_LIMITE_RUIM 1.10f       // intervalo médio acima do orçamento
+#define QUALIDADE_LIMITE_FOLGA 0.50f      // custo médio abaixo do orçamento
+#define QUALIDADE_SUBIDA_RECENTE 4        // janelas em que descer desfaz a subida
+
+/*---------------------------------------------
+ * Custom types (enums, structs, unions, etc.)
+ *-------------------------------------------*/
+typedef enum NivelQualidadeId {
+    QUALIDADE_ALTA, QUALIDADE_MEDIA, QUALIDADE_BAIXA, QUALIDADE_MINIMA, NUM_NIVEIS_QUALIDADE
+} NivelQualidadeId;
+
+typedef struct NivelQualidade {
+    const char *nome;
+    bool msaa;          // desenha direto na janela (com MSAA, se ela tiver)
+    float escala;       // fora do MSAA: lado da RenderTexture / lado da janela
+    float particulas;   // fração das partículas emitidas
+    int passoAnimacao;  // peixes atualizados a cada passoAnimacao quadros
+} NivelQualidade;
+
+typedef struct GovernadorQualidade {
+
+    bool automatico;
+    int nivel;
+    float orcamentoMs;
+
+    // janela atual
+    double somaIntervalos;
+    double somaCustos;
+    int quadros;
+
+    int janelasRuins;
+    int janelasFolga;
+    int folgaExigida;
+    int janelasDesdeSubida;   // -1: a última troca não foi subida
+    bool ignorarJanela;       // a janela da troca paga a troca
+
+    long long descidas;
+    long long subidas;
+
+} GovernadorQualidade;
+
+/*---------------------------------------------
+ * Function prototypes.
+ *-------------------------------------------*/
+/**
+ * @brief Começa em nivel (limitado aos níveis existentes); com automatico
+ * false o nível nunca muda.
+ * orcamentoMs é o tempo de um quadro no FPS alvo.
+ */
+void GovernadorCriar( GovernadorQualidade *governador, bool automatico, int nivel, float orcamentoMs );
+
+/**
+ * @brief Registra um quadro: intervalo entre o início deste e o do próximo
+ * (com a espera do FPS) e custo (atualizar e desenhar, sem a espera).
+ * Retorna true se o nível mudou.
+ */
+bool GovernadorRegistrar( GovernadorQualidade *governador, float intervaloMs, float custoMs );
+
+const NivelQualidade *GovernadorNivel( const GovernadorQualidade *governador );
+
+void GovernadorRelatorio( const GovernadorQualidade *governador, FILE *saida );
+
+#endif
@@ -0,0 +1,121 @@
+/**
+ * @file rede.h
+ * @brief Multiplayer em rede local por UDP. O servidor roda as regras do
+ * jogo e manda snapshots do estado; os clientes mandam só as teclas de cada
+ * passo (um byte por passo) e preveem o próprio mergulhador. Os snapshots
+ * (codec de snapshot.h) vão como delta contra o último snapshot confirmado
+ * pelo cliente. Assim como plataforma.c, a implementação não inclui a raylib
+ * (winsock2.h e raylib.h não podem ser usados juntos).
+ * @copyright Copyright (c) 2025
+ */
+#ifndef REDE_H
+#define REDE_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "snapshot.h"
+
+/*---------------------------------------------
+ * Macros.
+ *-------------------------------------------*/
+#define REDE_MAX_JOGADORES SNAPSHOT_MAX_JOGADORES
+#define REDE_MAX_LIXOS 32
+#define REDE_TAMANHO_PACOTE 1200 // abaixo do MTU comum, sem fragmentação
+#define REDE_HISTORICO 64 // snapshots/entradas guardados para delta e replay
+#define REDE_ENTRADAS_POR_PACOTE 8 // redundância contra perda de pacotes
+#define REDE_TAXA_MAXIMA 1000 // ticks por segundo do servidor
+
+// bits da entrada de um passo
+#define REDE_ESQUERDA   0x01
+#define REDE_DIREITA    0x02
+#define REDE_CIMA       0x04
+#define REDE_BAIXO      0x08
+#define REDE_PEGAR      0x10 // segurando
+#define REDE_DESCARTAR  0x20
+#define REDE_PEGOU      0x40 // apertou neste passo
+#define REDE_DESCARTOU  0x80
+#define REDE_MOVIMENTO  ( REDE_ESQUERDA | REDE_DIREITA | REDE_CIMA | REDE_BAIXO )
+
+/*---------------------------------------------
+ * Custom types (enums, structs, unions, etc.)
+ *-------------------------------------------*/
+typedef enum TipoPacote {
+    PACOTE_CONECTAR = 1,  // cliente -> servidor
+    PACOTE_BOAS_VINDAS,   // servidor -> cliente: índice do jogador
+    PACOTE_ENTRADA,       // cliente -> servidor: últimas entradas e ack
+    PACOTE_SNAPSHOT,      // servidor -> cliente
+    PACOTE_FIM            // servidor -> cliente: o servidor encerrou
+} TipoPacote;
+
+typedef struct RedeSocket RedeSocket;
+
+// IPv4 e porta na ordem do host
+typedef struct RedeEndereco {
+    uint32_t ip;
+    uint16_t porta;
+} RedeEndereco;
+
+// snapshot com espaço próprio para os lixos, para guardar no histórico;
+// jogo.lixos não é usado (o codec recebe lixos)
+typedef struct SnapshotRede {
+    Snapshot jogo;
+    SnapshotLixo lixos[REDE_MAX_LIXOS];
+} SnapshotRede;
+
+/*---------------------------------------------
+ * Function prototypes.
+ *-------------------------------------------*/
+/**
+ * @brief Abre um socket UDP não bloqueante na porta (0 = qualquer uma).
+ * Retorna NULL em caso de falha.
+ */
+RedeSocket *RedeAbrir( int porta );
+void RedeFechar( RedeSocket *socket );
+
+/**
+ * @brief Converte "host:porta" (nome ou IPv4) em endereço.
+ */
+bool RedeResolver( const char *texto, RedeEndereco *endereco );
+
+bool RedeEnviar( RedeSocket *socket, RedeEndereco destino, const uint8_t *dados, int tamanho );
+
+/**
+ * @brief Lê um pacote se houver algum esperando. Retorna o tamanho, ou 0
+ * se não houver nada.
+ */
+int RedeReceber( RedeSocket *socket, uint8_t *dados, int capacidade, RedeEndereco *origem );
+
+bool RedeMesmoEndereco( RedeEndereco a, RedeEndereco b );
+
+/**
+ * @brief Resposta ao PACOTE_CONECTAR: índice do jogador do cliente,
+ * jogadores da partida e ticks por segundo do servidor. A leitura só
+ * escreve nas saídas se o pacote for válido: jogador dentro da partida, de
+ * 1 a REDE_MAX_JOGADORES jogadores e taxa de 1 a REDE_TAXA_MAXIMA.
+ */
+int RedeEscreverBoasVindas( uint8_t *dados, int jogador, int numJogadores, int taxa );
+bool RedeLerBoasVindas( const uint8_t *dados, int tamanho, int *jogador, int *numJogadores, int *taxa );
+
+/**
+ * @brief Pacote de entrada: sequência da entrada mais recente, as últimas
+ * quantidade entradas (da mais nova para a mais velha) e o tick do último
+ * snapshot recebido, que o servidor usa como base do delta.
+ */
+int RedeEscreverEntrada( uint8_t *dados, uint32_t sequencia, const uint8_t *entradas, int quantidade, uint32_t ackSnapshot );
+bool RedeLerEntrada( const uint8_t *dados, int tamanho, uint32_t *sequencia, uint8_t *entradas, int *quantidade, uint32_t *ackSnapshot );
+
+/**
+ * @brief Escreve o pacote do snapshot, como delta contra base se ela não
+ * for NULL. Retorna o tamanho.
+ */
+int RedeEscreverSnapshot( uint8_t *dados, const SnapshotRede *snapshot, const SnapshotRede *base );
+
+/**
+ * @brief Tick da base usada pelo pacote (0 = snapshot completo), para o
+ * cliente achar a base no seu histórico antes de RedeLerSnapshot.
+ */
+uint32_t RedeBaseSnapshot( const uint8_t *dados, int tamanho );
+bool RedeLerSnapshot( const uint8_t *dados, int tamanho, const SnapshotRede *base, SnapshotRede *snapshot );
+
+#endif
@@ -0,0 +1,94 @@
+/**
+ * @file snapshot.h
+ * @brief Codec binário do estado do jogo (rede, replays e saves). O formato
+ * é versionado e empacotado em bits: posições quantizadas em 1/8 px, flags
+ * em XOR com a base e números como diferença em relação à base, gravados
+ * com o menor tamanho que couber. Sem base, o snapshot é completo. O codec
+ * não aloca memória: escreve e lê em buffers do chamador.
+ * @copyright Copyright (c) 2025
+ */
+#ifndef SNAPSHOT_H
+#define SNAPSHOT_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+/*---------------------------------------------
+ * Macros.
+ *-------------------------------------------*/
+#define SNAPSHOT_VERSAO 1
+#define SNAPSHOT_MAX_JOGADORES 4
+#define SNAPSHOT_MAX_LIXEIRAS 7
+#define SNAPSHOT_QUANTIZACAO 8.0f // passos por pixel (até 8191 px)
+#define SNAPSHOT_NUM_ESTADOS 4     // o campo estado tem 2 bits
+#define SNAPSHOT_MAX_TIPO 3        // tipos de lixo e de lixeira: 0 a 3
+#define SNAPSHOT_SEM_LIXO 4        // tipoLixo de jogador de mãos vazias
+
+/*---------------------------------------------
+ * Custom types (enums, structs, unions, etc.)
+ *-------------------------------------------*/
+typedef struct SnapshotJogador {
+    float x;
+    float y;
+    int pontuacao;
+    int tipoLixo; // 0 a SNAPSHOT_MAX_TIPO, ou SNAPSHOT_SEM_LIXO
+    int quadro;   // quadro da animação, 0 a 3
+    bool virado;
+    bool movendo;
+} SnapshotJogador;
+
+typedef struct SnapshotLixeira {
+    float x;
+    float y;
+    float largura;
+    float altura;
+    int tipo;
+} SnapshotLixeira;
+
+typedef struct SnapshotLixo {
+    float x;
+    float y;
+    int tipo;
+    bool ativo;
+} SnapshotLixo;
+
+typedef struct Snapshot {
+    uint32_t tick;
+    uint32_t ultimaEntrada;
+    int estado;
+    float tempoRestante; // resolução de 0,1 s, até 409 s
+    int numJogadores;
+    SnapshotJogador jogadores[SNAPSHOT_MAX_JOGADORES];
+    int numLixeiras;
+    SnapshotLixeira lixeiras[SNAPSHOT_MAX_LIXEIRAS];
+    int numLixos;
+    int capacidadeLixos; // tamanho do array lixos (usado na leitura)
+    SnapshotLixo *lixos; // memória do chamador
+} Snapshot;
+
+/*---------------------------------------------
+ * Function prototypes.
+ *-------------------------------------------*/
+/**
+ * @brief Codifica snapshot em dados. Com base != NULL grava só o que mudou
+ * desde a base. Retorna o tamanho em bytes, ou -1 se não couber em
+ * capacidade ou se estado não couber no formato (fora de 0 a
+ * SNAPSHOT_NUM_ESTADOS - 1).
+ */
+int SnapshotEscrever( uint8_t *dados, int capacidade, const Snapshot *snapshot, const Snapshot *base );
+
+/**
+ * @brief Tick da base usada pelos dados (0 = snapshot completo), para
+ * achar a base antes de SnapshotLer.
+ */
+uint32_t SnapshotTickBase( const uint8_t *dados, int tamanho );
+
+/**
+ * @brief Decodifica dados em snapshot, cujo array lixos deve ter
+ * capacidadeLixos posições. A base precisa ser a mesma usada na escrita.
+ * Falha com versão diferente, base errada, dados truncados ou tipos fora
+ * da faixa.
+ */
+bool SnapshotLer( const uint8_t *dados, int tamanho, const Snapshot *base, Snapshot *snapshot );
+
+#endif
@@ -0,0 +1,109 @@
+/**
+ * @file streaming.h
+ * @brief Fundo do oceano dividido em chunks que são decodificados em uma
+ * thread de fundo conforme o mergulhador se aproxima. Só um número fixo de
+ * chunks fica carregado (cache LRU), então a memória usada não depende do
+ * tamanho do mapa.
+ * @copyright Copyright (c) 2025
+ */
+#ifndef STREAMING_H
+#define STREAMING_H
+
+#include <stdbool.h>
+
+#include "raylib/raylib.h"
+#include "plataforma.h"
+
+/*---------------------------------------------
+ * Macros.
+ *-------------------------------------------*/
+#define STREAMING_MAX_CACHE 32      // chunks residentes na GPU (LRU)
+#define STREAMING_MAX_PEDIDOS 16    // chunks esperando a thread de fundo
+#define STREAMING_MAX_PRONTOS 4     // chunks decodificados esperando upload
+#define STREAMING_MAX_IMAGENS 4     // imagens de origem citadas pelo mapa
+#define STREAMING_UPLOADS_POR_QUADRO 2
+#define STREAMING_PREFETCH_SEGUNDOS 1.0f
+
+#define CHUNK_AUSENTE -1
+#define CHUNK_PEDIDO -2
+
+/*---------------------------------------------
+ * Custom types (enums, structs, unions, etc.)
+ *-------------------------------------------*/
+typedef struct ChunkResidente {
+    int chunk;              // índice linha * colunas + coluna
+    Texture2D textura;
+    unsigned int ultimoUso; // quadro em que foi pedido pela última vez
+} ChunkResidente;
+
+typedef struct ChunkDecodificado {
+    int chunk;
+    Image imagem;
+} ChunkDecodificado;
+
+typedef struct Streaming {
+
+    // mapa
+    bool valido;
+    int tamanhoChunk;
+    int colunas;
+    int linhas;
+    unsigned char *variacoes;  // uma por chunk, veja resources/mapa/oceano.txt
+    int *slotCache;            // posição no cache, CHUNK_AUSENTE ou CHUNK_PEDIDO
+    char imagens[STREAMING_MAX_IMAGENS][256];
+    int quantidadeImagens;
+
+    // cache LRU (só a thread principal mexe)
+    ChunkResidente cache[STREAMING_MAX_CACHE];
+    int quantidadeCache;
+    unsigned int quadro;
+
+    // filas compartilhadas com a thread de fundo (protegidas pelo mutex)
+    int pedidos[STREAMING_MAX_PEDIDOS];
+    int quantidadePedidos;
+    ChunkDecodificado prontos[STREAMING_MAX_PRONTOS];
+    int quantidadeProntos;
+    bool encerrar;
+
+    PlataformaThread *thread;
+    PlataformaMutex *mutex;
+    PlataformaCond *temTrabalho;
+    PlataformaCond *temEspaco;
+
+} Streaming;
+
+/*---------------------------------------------
+ * Function prototypes.
+ *-------------------------------------------*/
+/**
+ * @brief Lê o arquivo do mapa e inicia a thread de fundo. Se o arquivo não
+ * existir ou não cobrir exatamente largura x altura, stream->valido fica
+ * falso e nada é carregado.
+ */
+void StreamingCarregar( Streaming *stream, const char *arquivoMapa, int largura, int altura );
+
+/**
+ * @brief Encerra a thread e libera todos os chunks.
+ */
+void StreamingDescarregar( Streaming *stream );
+
+/**
+ * @brief Envia os chunks decodificados para a GPU e pede os chunks da área
+ * visível, do anel ao redor dela e do caminho à frente da velocidade.
+ */
+void StreamingAtualizar( Streaming *stream, Rectangle visivel, Vector2 velocidade );
+
+/**
+ * @brief Atualiza até todos os chunks da área visível estarem na GPU ou o
+ * limite de tempo passar (capturas de tela e testes, que não podem sair com
+ * chunks faltando). Retorna false se o tempo acabou.
+ */
+bool StreamingAguardar( Streaming *stream, Rectangle visivel, double limiteSegundos );
+
+/**
+ * @brief Desenha os chunks visíveis (dentro de BeginMode2D). Chunks que
+ * ainda não chegaram são preenchidos com uma cor sólida.
+ */
+void StreamingDesenhar( Streaming *stream, Rectangle visivel );
+
+#endif
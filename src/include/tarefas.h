@@ -0,0 +1,43 @@
+/**
+ * @file tarefas.h
+ * @brief Pool de threads para dividir laços grandes (física, cardumes,
+ * análise de logs) em blocos executados em paralelo.
+ * @copyright Copyright (c) 2025
+ */
+#ifndef TAREFAS_H
+#define TAREFAS_H
+
+/*---------------------------------------------
+ * Custom types (enums, structs, unions, etc.)
+ *-------------------------------------------*/
+typedef struct PoolTarefas PoolTarefas;
+
+/**
+ * @brief Processa os itens [inicio, fim) do laço.
+ */
+typedef void (*FuncaoIntervalo)( void *contexto, int inicio, int fim );
+
+/*---------------------------------------------
+ * Function prototypes.
+ *-------------------------------------------*/
+/**
+ * @brief Cria um pool com a quantidade de threads auxiliares pedida. A
+ * thread que chama ParaleloPara também trabalha, então trabalhadores = 0
+ * executa tudo em série.
+ */
+PoolTarefas *PoolTarefasCriar( int trabalhadores );
+
+void PoolTarefasDestruir( PoolTarefas *pool );
+
+/**
+ * @brief Quantas threads (auxiliares + a que chama) executam os laços.
+ */
+int PoolTarefasThreads( const PoolTarefas *pool );
+
+/**
+ * @brief Executa funcao sobre [0, total) em blocos de até bloco itens e só
+ * retorna quando todos terminarem. Com pool NULL executa em série.
+ */
+void ParaleloPara( PoolTarefas *pool, int total, int bloco, FuncaoIntervalo funcao, void *contexto );
+
+#endif
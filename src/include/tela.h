@@ -0,0 +1,65 @@
+/**
+ * @file tela.h
+ * @brief Tela virtual de tamanho fixo: o jogo desenha sempre em pixels da
+ * tela virtual e ela aparece na janela no maior múltiplo inteiro que cabe,
+ * centralizada, com faixas pretas em volta. Se a janela for menor que a
+ * tela virtual, a tela encolhe para caber (sem múltiplo inteiro).
+ *
+ * Com escala 0 a tela é desenhada direto na janela (viewport e projeção da
+ * tela virtual), mantendo o MSAA da janela. Com escala > 0 ela é desenhada
+ * em uma RenderTexture de escala vezes o tamanho da tela virtual e depois
+ * copiada para a janela: abaixo de 1, menos pixels para preencher em
+ * máquinas fracas.
+ * @copyright Copyright (c) 2025
+ */
+#ifndef TELA_H
+#define TELA_H
+
+#include "raylib/raylib.h"
+
+/*---------------------------------------------
+ * Custom types (enums, structs, unions, etc.)
+ *-------------------------------------------*/
+typedef struct TelaVirtual {
+    int largura;            // pixels da tela virtual
+    int altura;
+    float escala;           // lado do alvo / lado da tela virtual; 0: direto na janela
+    RenderTexture2D alvo;
+    int filtro;             // TEXTURE_FILTER_* em uso no alvo
+    Rectangle destino;      // onde a tela aparece, em pixels da janela
+} TelaVirtual;
+
+/*---------------------------------------------
+ * Function prototypes.
+ *-------------------------------------------*/
+/**
+ * @brief Tela virtual largura x altura, desenhada direto na janela.
+ */
+void TelaVirtualCriar( TelaVirtual *tela, int largura, int altura );
+
+/**
+ * @brief Escala 0 desenha direto na janela; > 0, em uma RenderTexture desse
+ * tamanho relativo (precisa do contexto OpenGL).
+ */
+void TelaVirtualDefinirEscala( TelaVirtual *tela, float escala );
+
+void TelaVirtualDestruir( TelaVirtual *tela );
+
+/**
+ * @brief Entre BeginDrawing e TelaVirtualTerminar, tudo é desenhado em
+ * pixels da tela virtual (ClearBackground só limpa a tela, não as faixas).
+ */
+void TelaVirtualComecar( TelaVirtual *tela );
+
+/**
+ * @brief Leva a tela para a janela e volta às coordenadas da janela.
+ */
+void TelaVirtualTerminar( TelaVirtual *tela );
+
+/**
+ * @brief Converte um ponto da janela (mouse, toque) para a tela virtual.
+ * Antes do primeiro quadro, ou sem janela, devolve o ponto como veio.
+ */
+Vector2 TelaVirtualPonto( const TelaVirtual *tela, Vector2 janela );
+
+#endif
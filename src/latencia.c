@@ -0,0 +1,100 @@
+/**
+ * @file latencia.c
+ * @brief Sonda de latência e cálculo do atraso de quadro.
+ * @copyright Copyright (c) 2025
+ */
+#include <string.h>
+
+#include "latencia.h"
+#include "medidor.h"
+
+void SondaLatenciaCriar( SondaLatencia *sonda ) {
+    memset( sonda, 0, sizeof(SondaLatencia) );
+}
+
+void SondaLatenciaColetar( SondaLatencia *sonda, Entrada *entrada ) {
+
+    EventoEntrada evento;
+    while ( EntradaProximoEvento( entrada, &evento ) ) {
+        if ( !evento.apertou ) {
+            continue;
+        }
+        if ( sonda->quantidadePendentes == LATENCIA_PENDENTES ) {
+            sonda->descartados++;
+            continue;
+        }
+        sonda->pendentes[sonda->quantidadePendentes++] = evento.tempo;
+    }
+
+}
+
+bool SondaLatenciaPendente( const SondaLatencia *sonda ) {
+    return sonda->quantidadePendentes > 0;
+}
+
+void SondaLatenciaApresentado( SondaLatencia *sonda, double tempo ) {
+
+    for ( int i = 0; i < sonda->quantidadePendentes; i++ ) {
+        // cheio: recomeça por cima, o resumo é das últimas amostras
+        sonda->amostras[sonda->medidos % LATENCIA_AMOSTRAS] = (float)( ( tempo - sonda->pendentes[i] ) * 1000.0 );
+        sonda->medidos++;
+    }
+    sonda->quantidade = sonda->medidos < LATENCIA_AMOSTRAS ? (int)sonda->medidos : LATENCIA_AMOSTRAS;
+    sonda->quantidadePendentes = 0;
+
+}
+
+void SondaLatenciaRelatorio( SondaLatencia *sonda, FILE *saida ) {
+
+    // MedidorResumir ordena as amostras: a sonda não serve mais depois disso
+    ResumoTempos resumo = MedidorResumir( sonda->amostras, sonda->quantidade );
+    fprintf( saida, "latencia entrada->tela: %lld apertos (%d no resumo, %lld descartados)\n",
+             sonda->medidos, sonda->quantidade, sonda->descartados );
+    fprintf( saida, "  media %.2f ms, p50 %.2f, p90 %.2f, p99 %.2f, max %.2f\n",
+             resumo.media, resumo.p50, resumo.p90, resumo.p99, resumo.maximo );
+
+}
+
+void AtrasoQuadroCriar( AtrasoQuadro *atraso, double periodo, double segundos ) {
+
+    memset( atraso, 0, sizeof(AtrasoQuadro) );
+    atraso->periodo = periodo;
+    atraso->automatico = segundos < 0;
+    // o automático começa sem esperar e vai subindo conforme os custos
+    atraso->atraso = atraso->automatico ? 0 : segundos;
+    if ( atraso->atraso > periodo ) {
+        atraso->atraso = periodo;
+    }
+
+}
+
+void AtrasoQuadroRegistrar( AtrasoQuadro *atraso, double custo ) {
+
+    atraso->custos[atraso->proximoCusto] = (float)custo;
+    atraso->proximoCusto = ( atraso->proximoCusto + 1 ) % ATRASO_QUADRO_CUSTOS;
+    if ( atraso->quantidadeCustos < ATRASO_QUADRO_CUSTOS ) {
+        atraso->quantidadeCustos++;
+    }
+    if ( !atraso->automatico ) {
+        return;
+    }
+
+    float maior = 0;
+    for ( int i = 0; i < atraso->quantidadeCustos; i++ ) {
+        if ( atraso->custos[i] > maior ) {
+            maior = atraso->custos[i];
+        }
+    }
+
+    double alvo = atraso->periodo - maior - ATRASO_QUADRO_MARGEM;
+    if ( alvo < 0 ) {
+        alvo = 0;
+    }
+    // perder a troca custa um período inteiro: desce na hora, sobe aos poucos
+    if ( alvo < atraso->atraso ) {
+        atraso->atraso = alvo;
+    } else {
+        atraso->atraso += ( alvo - atraso->atraso ) * 0.05;
+    }
+
+}
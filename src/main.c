@@ -8,6 +8,8 @@
 #include <stdio.h>
 #include <stdlib.h>
 #include <stdbool.h>
+#include <string.h>
+#include <time.h>
 
 /*---------------------------------------------
  * Library headers.
@@ -18,43 +20,73 @@
 /*---------------------------------------------
  * Project headers.
  *-------------------------------------------*/
+#include "mundo.h"
+#include "streaming.h"
+#include "particulas.h"
+#include "colisao.h"
+#include "correntes.h"
+#include "cardume.h"
+#include "navegacao.h"
+#include "bot.h"
+#include "medidor.h"
+#include "plataforma.h"
+#include "tarefas.h"
+#include "rede.h"
+#include "placar.h"
+#include "eventos.h"
+#include "gravacao.h"
+#include "comparacao.h"
+#include "memoria.h"
+#include "arena.h"
+#include "estados.h"
+#include "entrada.h"
+#include "latencia.h"
+#include "qualidade.h"
+#include "tela.h"
 
 /*---------------------------------------------
  * Macros.
  *-------------------------------------------*/
+#define MAX_JOGADORES ENTRADA_MAX_JOGADORES // multiplayer local na mesma tela
 
 /*--------------------------------------------
  * Constants.
  *------------------------------------------*/
-const int PARADO = 0;
-const int RODANDO = 1;
-const int GAME_WIN = 2;
-const int GAME_LOSE = 3;
-int ESTADO = PARADO;
-
 const int LIXO_WIDTH = 30;
 const int LIXO_HEIGHT = 35;
 
 const int LIXEIRA_WIDTH = 85;
 const int LIXEIRA_HEIGHT = 105;
 
+// o mergulhador começa no fundo do mar, perto das lixeiras
+const Vector2 POSICAO_INICIAL_JOGADOR = { 360, MUNDO_HEIGHT - 360 };
+
+// botoes em pixels da tela virtual: o desenho e o clique usam o mesmo
+const Rectangle BOTAO_INICIAR = { TELA_LARGURA / 2 - 90, 260, 180, 55 };
+const Rectangle BOTAO_MENU = { TELA_LARGURA / 2 - 90, 267, 180, 50 };
+
 /*---------------------------------------------
  * Custom types (enums, structs, unions, etc.)
  *-------------------------------------------*/
+// linhas de ESTADOS_JOGO (o snapshot guarda o estado em 2 bits)
+typedef enum EstadoId {
+    PARADO, RODANDO, GAME_WIN, GAME_LOSE, NUM_ESTADOS
+} EstadoId;
+
 typedef enum TipoDoLixo {
     PLASTICO, VIDRO, METAL, PAPEL, NENHUM
 } TipoDoLixo;
 
+// o sprite e compartilhado (spriteMergulhador): todos os mergulhadores saem
+// no mesmo lote e o array de jogadores fica pequeno e contiguo
 typedef struct Jogador {
-    int spriteX;
-    int spriteY;
     float vel;
     TipoDoLixo tipoLixo;
     int pontuacao;
-    int melhorPontuacao;
     Vector2 pos;
     Vector2 dim;
-    Texture2D sprite;
+    Vector2 velocidade; // deslocamento por segundo no ultimo quadro
+    float acumuladorBolhas;
     // Campos para animação
     int frameWidth;
     int frameHeight;
@@ -79,11 +111,84 @@ typedef struct Lixeira {
     Texture2D sprite;    // A imagem da lixeira
 } Lixeira;
 
+// multiplayer em rede: o servidor roda update() e os clientes so desenham,
+// prevendo o proprio mergulhador
+typedef enum PapelRede {
+    REDE_LOCAL, REDE_SERVIDOR, REDE_CLIENTE
+} PapelRede;
+
+// um cliente visto pelo servidor
+typedef struct ClienteRemoto {
+    bool conectado;
+    RedeEndereco endereco;
+    double ultimoPacote;
+    uint8_t fila[REDE_HISTORICO]; // entradas recebidas, aplicadas uma por tick
+    int inicioFila;
+    int tamanhoFila;
+    uint32_t ultimaAplicada; // sequencia da entrada aplicada no ultimo tick
+    uint8_t entrada;
+    uint32_t ackSnapshot; // ultimo snapshot que o cliente recebeu
+    long long bytesEnviados;
+    long long bytesRecebidos;
+    int ticksSemEntrada;
+} ClienteRemoto;
+
+typedef struct EstadoServidor {
+    ClienteRemoto clientes[MAX_JOGADORES];
+    SnapshotRede historico[REDE_HISTORICO]; // bases do delta, por tick
+    uint32_t tick;
+    uint32_t tickLiberado; // a proxima partida so comeca depois deste tick
+} EstadoServidor;
+
+typedef struct EstadoCliente {
+    RedeEndereco servidor;
+    int jogadorLocal; // -1 ate o servidor responder
+    uint32_t sequencia;
+    uint8_t entradas[REDE_HISTORICO]; // por sequencia: reenvio e replay
+    double envio[REDE_HISTORICO]; // hora em que cada entrada saiu
+    uint8_t apertos; // apertos desde o ultimo passo
+    float acumulador;
+    SnapshotRede recebidos[REDE_HISTORICO]; // bases do delta, por tick
+    uint32_t ultimoTick;
+    uint32_t ultimaConfirmada;
+    double inicio;
+    double ultimoPacote;
+    double ultimaTentativa;
+    bool encerrado;
+    // relatorio
+    long long bytesEnviados;
+    long long bytesRecebidos;
+    int snapshots;
+    int snapshotsPerdidos;
+    float latencias[8192]; // ms entre enviar a entrada e ve-la aplicada
+    int quantidadeLatencias;
+    double somaCorrecao; // px que a reconciliacao moveu o mergulhador
+    int correcoes;
+} EstadoCliente;
+
+// jogador que encosta em um lixo e apertou para pegar neste quadro
+typedef struct PedidoColeta {
+    int jogador;
+    int lixo;
+    float distancia;
+} PedidoColeta;
+
 
 /*---------------------------------------------
  * Global variables.
  *-------------------------------------------*/
-Jogador jogador;
+Jogador jogadores[MAX_JOGADORES];
+Entrada entrada; // dispositivos lidos uma vez por passo; controles definidos ao iniciar a partida
+int numJogadores = 1;
+Placar placar; // recordes da equipe e de cada mergulhador, salvos em disco
+LogEventos logEventos; // coletas, descartes, estados e quadros, para analise
+MaquinaEstados estadoJogo; // estado atual em estadoJogo.atual
+Texture2D spriteMergulhador;
+
+// tinta de cada mergulhador (o primeiro fica com as cores do sprite)
+const Color COR_JOGADOR[MAX_JOGADORES] = {
+    { 255, 255, 255, 255 }, { 170, 255, 170, 255 }, { 255, 200, 140, 255 }, { 210, 170, 255, 255 }
+};
 Texture2D background;
 Texture2D start;
 Texture2D fire;
@@ -103,10 +208,83 @@ Sound somDescarteErrado;
 
 float tempoRestante = 180.0f; // tempo em segundos
 
-#define MAX_LIXOS 1 // O maximo de lixos que podem aparecer na tela
+#define LIXOS_PADRAO 24 // lixos no mapa (--lixos muda, para testes de carga)
 #define NUM_LIXEIRAS 4
-
-Lixo itensLixo[MAX_LIXOS]; // Array para os lixos
+#define NUM_PEIXES 2000 // peixes espalhados em cardumes pelo mapa
+
+int numLixos = LIXOS_PADRAO;
+Lixo *itensLixo; // Array para os lixos (CriarLixos)
+GradeEspacial gradeLixo; // Lixos ativos indexados por posicao no mapa
+LoteAABB loteLixo; // Hitboxes dos lixos em SoA para o teste em lote
+CampoCorrente campoCorrente; // correntes do mar que arrastam o lixo
+Deriva derivaLixo; // posicao e velocidade dos lixos em SoA para a fisica
+PoolTarefas *poolTarefas; // threads auxiliares para os lacos grandes
+Cardume cardume; // peixes que fogem das areas com lixo
+Texture2D spritePeixe; // desenhado em tempo de execucao
+
+#define ARQUIVO_QUICKSAVE "quicksave.dat"
+#define QUICKSAVE_MAGICA 0x5653474Fu // "OGSV"
+#define QUICKSAVE_VERSAO 2
+
+typedef struct QuicksaveLixo {
+    float x;
+    float y;
+    float vx;
+    float vy;
+    float afundamento;
+    TipoDoLixo tipo;
+    bool ativo;
+} QuicksaveLixo;
+
+// imagem da partida em andamento (F5 salva, F9 continua): so campos simples
+// e arrays, sem ponteiros, gravada e lida com uma unica chamada de I/O. Os
+// lixos vao no fim (numLixos itens). Grade, lotes de hitbox e sprites sao
+// refeitos na carga.
+typedef struct Quicksave {
+    uint32_t magica;
+    uint32_t versao;
+    uint32_t tamanho; // sizeof(Quicksave): outro executavel, outro layout
+    uint32_t sementeAleatoria; // os sorteios continuam desta semente
+    int numJogadores;
+    int numLixos;
+    float tempoRestante;
+    Camera2D camera;
+    CampoCorrente correntes;
+    Jogador jogadores[MAX_JOGADORES];
+    float peixeX[NUM_PEIXES];
+    float peixeY[NUM_PEIXES];
+    float peixeVx[NUM_PEIXES];
+    float peixeVy[NUM_PEIXES];
+    QuicksaveLixo lixos[];
+} Quicksave;
+
+const char *mensagemHud = NULL; // aviso rapido na tela ("Partida salva")
+float tempoMensagemHud = 0;
+
+// a partida em andamento nao aloca: quadros em RODANDO que alocaram (fora
+// os do quicksave, que aloca o buffer do arquivo)
+#define AVISOS_ALOCACAO 8 // quadros com alocacao detalhados no log
+bool alocacaoPermitida = false;
+long long quadrosComAlocacao = 0;
+
+// dados temporarios do quadro (lista de lixos visiveis, textos do HUD):
+// esvaziada no inicio de cada quadro, nunca liberada item a item
+#define ARENA_QUADRO_BASE ( 64 * 1024 ) // alem da lista de visiveis
+Arena arenaQuadro;
+
+// velocidade (px/s) com que cada material afunda; vidro e metal descem
+// rapido, plastico quase boia
+const float TAXA_AFUNDAMENTO[4] = {
+    [PLASTICO] = 4.0f, [VIDRO] = 30.0f, [METAL] = 36.0f, [PAPEL] = 12.0f
+};
+Camera2D camera;
+Streaming fundoOceano; // chunks do fundo do mar carregados sob demanda
+Rectangle areaInicioPartida; // pedida ao streaming enquanto o menu esta aberto
+
+Texture2D texturaBolha; // gerada em tempo de execucao (gradiente radial)
+Emissor bolhas; // rastro de bolhas do mergulhador
+Emissor respingosAcerto; // explosao verde ao descartar certo
+Emissor respingosErro; // explosao vermelha ao descartar errado
 Texture2D spritesLixo[4]; // Array para os 4 tipos de lixo
 
 Texture2D lixeiraPlastico;
@@ -114,6 +292,108 @@ Texture2D lixeiraVidro;
 Texture2D lixeiraMetal;
 Texture2D lixeiraPapel;
 Lixeira lixeiras [NUM_LIXEIRAS];
+LoteAABB loteLixeiras;
+NavGrade navegacao; // rochas do mapa
+CampoFluxo caminhoLixeira[NUM_LIXEIRAS]; // caminho de qualquer ponto ate cada lixeira
+
+// modo de teste: o bot joga no lugar do teclado (--bot, --headless)
+bool modoBot = false;
+bool modoHeadless = false;
+Bot bots[MAX_JOGADORES];
+int sessoesDesejadas = 0; // 0 = sem limite
+int sessoesConcluidas = 0;
+int vitorias = 0;
+
+PapelRede papelRede = REDE_LOCAL;
+RedeSocket *socketRede;
+int taxaRede = 60; // ticks por segundo do servidor; cada tick avanca 1/60 s
+uint8_t entradaRede[MAX_JOGADORES]; // entrada do passo atual de cada jogador
+EstadoServidor servidor;
+EstadoCliente cliente;
+
+// --gravar-entradas: as teclas da primeira partida vao para um arquivo,
+// que o benchmark repete no lugar do teclado
+const char *arquivoGravacao = NULL;
+GravacaoEntradas gravacao;
+bool gravandoEntradas = false;
+bool repetindoEntradas = false; // entradaRede vem da gravacao
+
+// --sonda-latencia: tempo entre o aperto de uma tecla e a tela que mostra o
+// efeito; o quadro com apertos pendentes leva um quadrado branco no canto
+// (para conferir com uma camera ou um fotodiodo)
+#define TAMANHO_MARCA_LATENCIA 24
+SondaLatencia *sondaLatencia = NULL;
+
+// --baixa-latencia: vsync sem o limite de FPS da raylib; o quadro espera o
+// atraso depois da ultima troca, busca a entrada, atualiza, desenha e espera
+// a GPU apresentar, sem deixar quadros na fila do driver
+bool baixaLatencia = false;
+AtrasoQuadro atrasoQuadro;
+
+// --qualidade: o governador troca o nivel conforme o tempo de quadro. Fora
+// do nivel alto a tela virtual e desenhada em uma RenderTexture (sem MSAA,
+// menor que a tela) e esticada na janela
+GovernadorQualidade governador;
+TelaVirtual tela; // TELA_LARGURA x TELA_ALTURA, escalada na janela
+double fimDesenho; // PlataformaTempo logo antes do EndDrawing: o resto e espera
+float deltaPeixes = 0; // tempo ainda nao passado ao cardume
+int quadrosPeixes = 0;
+
+#define ARQUIVO_ENTRADAS_BENCHMARK "bench/entradas/partida.ent"
+#define SEMENTE_BENCHMARK 20250u
+#define QUADROS_AQUECIMENTO 60 // rodados antes de cada cenario, sem medir
+
+typedef enum TipoCenario {
+    CENARIO_MENU,       // menu parado, sem entradas
+    CENARIO_PARTIDA,    // repete a gravacao de uma partida
+    CENARIO_RAJADAS,    // partida gravada; a cada meio segundo metade dos lixos reaparece
+    CENARIO_TEMPESTADE  // 4 mergulhadores nas lixeiras pegando e descartando a cada quadro
+} TipoCenario;
+
+// cenarios do benchmark (--benchmark): a mesma semente e as mesmas entradas
+// em toda execucao, para comparar uma versao do jogo com a outra
+typedef struct Cenario {
+    const char *nome;
+    TipoCenario tipo;
+    int lixos;
+    int quadros; // medidos, depois do aquecimento
+} Cenario;
+
+const Cenario CENARIOS[] = {
+    { "menu", CENARIO_MENU, LIXOS_PADRAO, 600 },
+    { "partida_1", CENARIO_PARTIDA, 1, 1200 },
+    { "partida_1k", CENARIO_PARTIDA, 1000, 1200 },
+    { "partida_10k", CENARIO_PARTIDA, 10000, 1200 },
+    { "partida_100k", CENARIO_PARTIDA, 100000, 600 },
+    { "rajadas", CENARIO_RAJADAS, 10000, 1200 },
+    { "tempestade", CENARIO_TEMPESTADE, 1000, 1200 }
+};
+#define NUM_CENARIOS (int)( sizeof(CENARIOS) / sizeof(CENARIOS[0]) )
+
+// telas do render offscreen (--render) e das imagens de referencia
+// (--golden, so as quatro telas do jogo)
+typedef enum TipoTela {
+    TELA_MENU, TELA_PARTIDA, TELA_VITORIA, TELA_DERROTA
+} TipoTela;
+
+typedef struct TelaRender {
+    const char *nome;
+    TipoTela tipo;
+    int lixos;
+    bool golden;
+} TelaRender;
+
+const TelaRender TELAS_RENDER[] = {
+    { "menu", TELA_MENU, LIXOS_PADRAO, true },
+    { "partida", TELA_PARTIDA, LIXOS_PADRAO, true },
+    { "partida_1k", TELA_PARTIDA, 1000, false },
+    { "vitoria", TELA_VITORIA, LIXOS_PADRAO, true },
+    { "derrota", TELA_DERROTA, LIXOS_PADRAO, true }
+};
+#define NUM_TELAS_RENDER (int)( sizeof(TELAS_RENDER) / sizeof(TELAS_RENDER[0]) )
+#define PASSOS_TELA 120 // passos da partida gravada antes de desenhar a tela
+#define ARQUIVO_SNAPSHOT_GOLDEN "partida.dat" // na pasta do --golden
+#define TOLERANCIA_GOLDEN 0.1f // % de pixels diferentes aceita por tela
 
 /*---------------------------------------------
  * Function prototypes.
@@ -127,86 +407,550 @@ void update( float delta );
  * @brief Draws the state of the game.
  */
 void draw( void );
+
+/**
+ * @brief Escala da tela virtual para o nivel atual do governador.
+ */
+void AplicarQualidade( void );
+
+/**
+ * @brief Desenha a tela do estado atual no alvo que estiver ativo (janela
+ * ou RenderTexture), sem BeginDrawing/EndDrawing.
+ */
+void DesenharTela( void );
+
+/**
+ * @brief Funcoes de cada estado em ESTADOS_JOGO. O fim da partida e o mesmo
+ * para vitoria e derrota; so a tela muda.
+ */
+void EntrarMenu( int anterior );
+void AtualizarMenu( float delta );
+void AtualizarPartida( float delta );
+void SairPartida( int proximo );
+void AtualizarFimDePartida( float delta );
+
 void draw_menu(void);
 void draw_gameplay(void);
 void draw_win(void);
 void draw_lose(void);
 
-void AtualizarJogador(Jogador *jogador, int teclaEsquerda, int teclaDireita, int teclaCima, int teclaBaixo, float delta);
+/**
+ * @brief Move o jogador conforme os bits REDE_* de teclas (os mesmos no
+ * jogo local, no servidor, na previsao do cliente e nas gravacoes).
+ */
+void AtualizarJogador(Jogador *jogador, uint8_t teclas, float delta);
+
+/**
+ * @brief Posicao, pontuacao e animacao iniciais do jogador i. Os
+ * mergulhadores comecam lado a lado.
+ */
+void IniciarJogador(Jogador *jogador, int i);
+
+/**
+ * @brief Reinicia os jogadores e escolhe as teclas de cada um: o controle i
+ * se estiver conectado, senao o layout de teclado i.
+ */
+void IniciarEquipe(void);
+
+/**
+ * @brief Soma das pontuacoes (a vitoria e da equipe).
+ */
+int PontuacaoEquipe(void);
+
+/**
+ * @brief Segue o centro dos mergulhadores e afasta o zoom ate todos
+ * caberem na tela.
+ */
+void AtualizarCameraEquipe(float delta);
+
+/**
+ * @brief Resolve os pedidos de coleta do quadro: o par jogador/lixo mais
+ * proximo vence, e cada lixo e cada jogador entram em no maximo um par.
+ */
+void ResolverColetas(void);
+
+/**
+ * @brief Le os dispositivos (EntradaLer) e, no jogo local, passa as teclas
+ * de cada jogador para entradaRede, de onde a partida le. Na rede e nas
+ * gravacoes, entradaRede ja veio preenchida.
+ */
+void LerEntrada(void);
+
+/**
+ * @brief Os bots decidem as teclas do passo (antes de LerEntrada).
+ */
+void PensarBots(float delta);
+
+/**
+ * @brief Teclas dos bots no modo de teste (FonteTeclas da entrada).
+ */
+bool TeclaDosBots(int tecla, bool pressionada);
+
+/**
+ * @brief Toque curto na tela: pega o lixo com as maos vazias, senao
+ * descarta.
+ */
+uint8_t AcaoDoToque(const Jogador *jogador);
+
+/**
+ * @brief Clique do mouse no botao; no modo de teste o bot sempre clica e o
+ * servidor espera todos os clientes conectarem.
+ */
+bool BotaoClicado(Rectangle botao);
+
+/**
+ * @brief Avanca o quadro da animacao e solta as bolhas do capacete.
+ */
+void AnimarJogador(Jogador *jogador, bool movendo, float delta);
+
+/**
+ * @brief Poluicao vista pelos peixes e passo do cardume.
+ */
+void AtualizarPeixes(float delta);
+
+/**
+ * @brief Servidor: recebe conexoes e entradas, aplica uma entrada de cada
+ * cliente, roda update() e manda o snapshot do tick.
+ */
+void ServidorTick(void);
+void ServidorReceber(void);
+void MontarSnapshot(SnapshotRede *snapshot);
+
+/**
+ * @brief Cliente: aplica os snapshots, preve o mergulhador local a passos
+ * fixos de 1/60 s e manda as entradas; o resto so e animado.
+ */
+void AtualizarCliente(float delta);
+void ClienteReceber(void);
+void AplicarSnapshot(const SnapshotRede *snapshot);
+
+/**
+ * @brief Banda, entradas atrasadas, snapshots perdidos, latencia e
+ * correcoes da previsao.
+ */
+void RelatorioRede(void);
+
+/**
+ * @brief Conta a sessao que terminou (modo de teste) e mostra o resultado.
+ */
+void RegistrarSessao(void);
+
+/**
+ * @brief Quicksave: grava a partida em andamento (em um temporario trocado
+ * pelo arquivo com rename) e a restaura, inclusive a semente dos sorteios.
+ */
+bool SalvarPartida(const char *arquivo);
+bool CarregarPartida(const char *arquivo);
+
+/**
+ * @brief Troca o estado do jogo (ganchos de saida e de entrada de
+ * ESTADOS_JOGO) e registra a mudanca no log de eventos. Nao faz nada se o
+ * jogo ja esta em novo.
+ */
+void MudarEstado(int novo);
+
+/**
+ * @brief Grava no placar a pontuacao de cada mergulhador na partida que
+ * acabou de terminar.
+ */
+void RegistrarPlacar(void);
+
+/**
+ * @brief Comeca uma partida: jogadores, lixos espalhados pelo mapa,
+ * particulas e camera. Com --gravar-entradas, a primeira partida e gravada.
+ */
+void IniciarPartida(void);
+
+/**
+ * @brief Fecha a contagem de alocacoes do quadro. Em um quadro inteiro em
+ * RODANDO, alocar conta como falha e os primeiros vao para o log com o
+ * subsistema que alocou.
+ */
+void ConferirAlocacoes(int estadoNoInicio);
+
+/**
+ * @brief Benchmark: roda os cenarios (todos ou so o de nome filtro) e
+ * escreve tempos de quadro, update, draw, memoria e alocacoes de cada um em
+ * JSON. Sem janela (--headless) o draw nao e medido. Falha se algum quadro
+ * medido da partida alocar (RodarCenario retorna false).
+ */
+bool RodarBenchmark(const char *arquivoJson, const char *filtro, const char *arquivoEntradas);
+bool RodarCenario(const Cenario *cenario, const GravacaoEntradas *partida, FILE *json, bool primeiro);
+
+/**
+ * @brief Poe nas entradas da rede o passo da gravacao (a partida le dali;
+ * com repetindoEntradas, LerEntrada nao as sobrescreve).
+ */
+void RepetirEntradas(const GravacaoEntradas *gravacao, long long passo);
+
+/**
+ * @brief Render offscreen: cada tela desenhada quadros vezes em uma
+ * RenderTexture. Mede o tempo de CPU de cada quadro e o tempo total ate a
+ * GPU terminar (a leitura da imagem no fim espera o driver); com pastaPng,
+ * grava a imagem de cada tela.
+ */
+bool RodarRender(const char *arquivoJson, int quadros, const char *pastaPng, const char *arquivoEntradas);
+
+/**
+ * @brief Imagens de referencia: desenha as telas golden de TELAS_RENDER e
+ * compara cada uma com pasta/tela.png (CompararImagens), mostrando os tempos
+ * de render ao lado das diferencas. Com atualizar, todas as telas (e o
+ * snapshot, se faltar) sao gravadas como novas referencias. Com pastaSaida,
+ * as telas que mudaram vao para la junto com o mapa das diferencas. Falha
+ * se faltar o snapshot ou alguma referencia (sem atualizar) ou se alguma
+ * tela passar de tolerancia (fracao de pixels diferentes).
+ */
+bool RodarGolden(const char *pasta, int quadros, const char *pastaSaida, float tolerancia, bool atualizar,
+                 const char *arquivoEntradas);
+
+/**
+ * @brief Desenha a tela atual em alvo: um quadro de aquecimento e depois
+ * quadros medidos (tempo de CPU de cada um em amostras, media com a GPU em
+ * msQuadro). Retorna a imagem do ultimo quadro, ja de cima para baixo.
+ */
+Image MedirTela(RenderTexture2D alvo, int quadros, float *amostras, double *msQuadro);
+
+/**
+ * @brief Monta a tela i de TELAS_RENDER sempre igual: semente fixa,
+ * partida avancada pelas entradas gravadas, o estado da tela e os chunks
+ * visiveis do fundo ja carregados. Com snapshot, a partida vem desse
+ * quicksave (gravado a partir das entradas se nao existir), assim a tela nao
+ * muda quando a simulacao muda. Retorna false se o snapshot nao puder ser
+ * lido nem gravado.
+ */
+bool PrepararTela(int i, const GravacaoEntradas *partida, const char *snapshot);
+
+/**
+ * @brief Texturas, fontes e sons. Nao sao carregados no modo headless, que
+ * roda sem janela nem contexto OpenGL.
+ */
+void CarregarRecursos(void);
+void DescarregarRecursos(void);
+
+/**
+ * @brief Ativa o lixo i em uma posição aleatória do mapa.
+ */
+void SpawnarLixo(int i);
+
+/**
+ * @brief Ativa o lixo i do tipo dado em pos.
+ */
+void ColocarLixo(int i, Vector2 pos, TipoDoLixo tipo);
+
+/**
+ * @brief Desativa todos os lixos do mapa.
+ */
+void LimparLixos(void);
+
+/**
+ * @brief (Re)cria os lixos, a grade, o lote de hitboxes e a deriva para
+ * quantidade lixos, todos inativos.
+ */
+void CriarLixos(int quantidade);
+void DestruirLixos(void);
+
+// indexada por EstadoId
+const EstadoJogo ESTADOS_JOGO[NUM_ESTADOS] = {
+    [PARADO]    = { "menu",    EntrarMenu, NULL,        AtualizarMenu,         draw_menu },
+    [RODANDO]   = { "partida", NULL,       SairPartida, AtualizarPartida,      draw_gameplay },
+    [GAME_WIN]  = { "vitoria", NULL,       NULL,        AtualizarFimDePartida, draw_win },
+    [GAME_LOSE] = { "derrota", NULL,       NULL,        AtualizarFimDePartida, draw_lose }
+};
 
 /**
  * @brief Game entry point.
+ *
+ * Opcoes de teste:
+ *    --bot: o bot joga no lugar do teclado, sem limite de FPS
+ *    --headless: bot sem janela, passo fixo de 1/60 s
+ *    --sessoes N: encerra depois de N partidas (padrao: 1 no headless)
+ *    --semente N: semente dos numeros aleatorios
+ *    --jogadores N: mergulhadores na partida, de 1 a 4 (no menu: teclas 1-4)
+ *    --teclas arquivo: troca as teclas dos jogadores e os atalhos (formato
+ *                      em entrada.h)
+ *
+ * Rede local (UDP):
+ *    --servidor PORTA: servidor sem janela; a partida comeca quando os
+ *                      --jogadores clientes conectarem
+ *    --cliente HOST:PORTA: joga em um servidor (com --headless, o bot joga)
+ *    --taxa N: ticks por segundo do servidor (padrao 60; acima disso a
+ *              partida roda acelerada, para testes)
+ *    --telemetria arquivo.csv: tempo de quadro e memoria (padrao: stdout)
+ *    --placar arquivo: onde salvar o placar (padrao: placar.dat; partidas
+ *                      do bot so sao salvas se o arquivo for indicado)
+ *    --eventos arquivo: log binario de eventos, acrescentado a cada execucao
+ *                       (padrao: eventos.bin, com a mesma regra do placar;
+ *                       tools/eventos_csv converte para CSV)
+ *    --lixos N: lixos no mapa (padrao 24; em rede, no maximo 32)
+ *    --gravar-entradas arquivo: grava as teclas da primeira partida
+ *
+ * Latencia (jogo com janela):
+ *    --sonda-latencia: mede o tempo do aperto de uma tecla ate a tela e
+ *                      escreve o resumo ao sair
+ *    --baixa-latencia: le a entrada o mais tarde possivel antes de desenhar
+ *                      (vsync, sem fila de quadros no driver)
+ *    --atraso-quadro MS: espera fixa depois de cada troca antes de ler a
+ *                        entrada (liga --baixa-latencia; padrao: automatico)
+ *    --qualidade N: nivel fixo de qualidade, de 0 (alta, com MSAA) a 3
+ *                   (minima); padrao: automatico, segurando 60 FPS
+ *
+ * Benchmark (make bench):
+ *    --benchmark arquivo.json: roda os cenarios fixos e sai; com --headless
+ *                              so o update e medido
+ *    --cenario nome: so este cenario
+ *    --entradas arquivo: partida repetida pelos cenarios (padrao:
+ *                        bench/entradas/partida.ent)
+ *    --render arquivo.json: desenha cada tela em uma RenderTexture, sem
+ *                           janela visivel, e mede (make render usa o
+ *                           llvmpipe do Mesa, sem GPU)
+ *    --quadros N: quadros medidos por tela (padrao 300)
+ *    --png pasta: grava a imagem de cada tela em pasta
+ *    --golden pasta: compara as quatro telas com as imagens de referencia
+ *                    em pasta (bench/golden); com --png, as telas que
+ *                    mudaram e o mapa das diferencas vao para a pasta do png
+ *    --atualizar-golden: grava as telas atuais como referencia
+ *    --tolerancia P: % de pixels diferentes aceita por tela (padrao 0.1)
  */
-int main( void ) {
+int main( int argc, char **argv ) {
+
+    MemoriaThreadPrincipal();
+    const char *arquivoTelemetria = NULL;
+    const char *arquivoPlacar = NULL;
+    const char *arquivoEventos = NULL;
+    const char *arquivoBenchmark = NULL;
+    const char *cenarioBenchmark = NULL;
+    const char *arquivoRender = NULL;
+    const char *pastaPng = NULL;
+    int quadrosRender = 300;
+    const char *pastaGolden = NULL;
+    bool atualizarGolden = false;
+    float toleranciaGolden = TOLERANCIA_GOLDEN;
+    const char *arquivoEntradas = ARQUIVO_ENTRADAS_BENCHMARK;
+    const char *semente = NULL;
+    const char *arquivoTeclas = NULL;
+    bool medirLatencia = false;
+    double atrasoFixo = -1; // automatico
+    int nivelQualidade = -1; // automatico
+    const char *enderecoServidor = NULL;
+    int portaServidor = 0;
+    for ( int i = 1; i < argc; i++ ) {
+        if ( strcmp( argv[i], "--bot" ) == 0 ) {
+            modoBot = true;
+        } else if ( strcmp( argv[i], "--headless" ) == 0 ) {
+            modoBot = true;
+            modoHeadless = true;
+        } else if ( strcmp( argv[i], "--sessoes" ) == 0 && i + 1 < argc ) {
+            sessoesDesejadas = atoi( argv[++i] );
+        } else if ( strcmp( argv[i], "--semente" ) == 0 && i + 1 < argc ) {
+            semente = argv[++i];
+        } else if ( strcmp( argv[i], "--telemetria" ) == 0 && i + 1 < argc ) {
+            arquivoTelemetria = argv[++i];
+        } else if ( strcmp( argv[i], "--placar" ) == 0 && i + 1 < argc ) {
+            arquivoPlacar = argv[++i];
+        } else if ( strcmp( argv[i], "--eventos" ) == 0 && i + 1 < argc ) {
+            arquivoEventos = argv[++i];
+        } else if ( strcmp( argv[i], "--jogadores" ) == 0 && i + 1 < argc ) {
+            numJogadores = atoi( argv[++i] );
+            numJogadores = numJogadores < 1 ? 1 : numJogadores > MAX_JOGADORES ? MAX_JOGADORES : numJogadores;
+        } else if ( strcmp( argv[i], "--teclas" ) == 0 && i + 1 < argc ) {
+            arquivoTeclas = argv[++i];
+        } else if ( strcmp( argv[i], "--sonda-latencia" ) == 0 ) {
+            medirLatencia = true;
+        } else if ( strcmp( argv[i], "--baixa-latencia" ) == 0 ) {
+            baixaLatencia = true;
+        } else if ( strcmp( argv[i], "--atraso-quadro" ) == 0 && i + 1 < argc ) {
+            baixaLatencia = true;
+            atrasoFixo = atof( argv[++i] ) / 1000.0;
+            atrasoFixo = atrasoFixo < 0 ? 0 : atrasoFixo;
+        } else if ( strcmp( argv[i], "--qualidade" ) == 0 && i + 1 < argc ) {
+            nivelQualidade = atoi( argv[++i] );
+            nivelQualidade = nivelQualidade < 0 ? 0 : nivelQualidade;
+        } else if ( strcmp( argv[i], "--servidor" ) == 0 && i + 1 < argc ) {
+            papelRede = REDE_SERVIDOR;
+            portaServidor = atoi( argv[++i] );
+        } else if ( strcmp( argv[i], "--cliente" ) == 0 && i + 1 < argc ) {
+            papelRede = REDE_CLIENTE;
+            enderecoServidor = argv[++i];
+        } else if ( strcmp( argv[i], "--taxa" ) == 0 && i + 1 < argc ) {
+            taxaRede = atoi( argv[++i] );
+            taxaRede = taxaRede < 1 ? 1 : taxaRede > REDE_TAXA_MAXIMA ? REDE_TAXA_MAXIMA : taxaRede;
+        } else if ( strcmp( argv[i], "--lixos" ) == 0 && i + 1 < argc ) {
+            numLixos = atoi( argv[++i] );
+            numLixos = numLixos < 1 ? 1 : numLixos > 1000000 ? 1000000 : numLixos;
+        } else if ( strcmp( argv[i], "--gravar-entradas" ) == 0 && i + 1 < argc ) {
+            arquivoGravacao = argv[++i];
+        } else if ( strcmp( argv[i], "--benchmark" ) == 0 && i + 1 < argc ) {
+            arquivoBenchmark = argv[++i];
+        } else if ( strcmp( argv[i], "--cenario" ) == 0 && i + 1 < argc ) {
+            cenarioBenchmark = argv[++i];
+        } else if ( strcmp( argv[i], "--entradas" ) == 0 && i + 1 < argc ) {
+            arquivoEntradas = argv[++i];
+        } else if ( strcmp( argv[i], "--render" ) == 0 && i + 1 < argc ) {
+            arquivoRender = argv[++i];
+        } else if ( strcmp( argv[i], "--quadros" ) == 0 && i + 1 < argc ) {
+            quadrosRender = atoi( argv[++i] );
+            quadrosRender = quadrosRender < 1 ? 1 : quadrosRender;
+        } else if ( strcmp( argv[i], "--png" ) == 0 && i + 1 < argc ) {
+            pastaPng = argv[++i];
+        } else if ( strcmp( argv[i], "--golden" ) == 0 && i + 1 < argc ) {
+            pastaGolden = argv[++i];
+        } else if ( strcmp( argv[i], "--atualizar-golden" ) == 0 ) {
+            atualizarGolden = true;
+        } else if ( strcmp( argv[i], "--tolerancia" ) == 0 && i + 1 < argc ) {
+            toleranciaGolden = (float)atof( argv[++i] );
+            toleranciaGolden = toleranciaGolden < 0 ? 0 : toleranciaGolden;
+        } else {
+            printf( "uso: %s [--bot] [--headless] [--sessoes N] [--semente N] [--jogadores N] [--teclas arquivo]\n"
+                    "       [--telemetria arquivo.csv] [--sonda-latencia] [--baixa-latencia] [--atraso-quadro MS] [--qualidade N]\n"
+                    "       [--servidor PORTA | --cliente HOST:PORTA] [--taxa N] [--placar arquivo] [--eventos arquivo]\n"
+                    "       [--lixos N] [--gravar-entradas arquivo] [--benchmark arquivo.json [--cenario nome] [--entradas arquivo]]\n"
+                    "       [--render arquivo.json [--quadros N] [--png pasta]]\n"
+                    "       [--golden pasta [--atualizar-golden] [--tolerancia P] [--quadros N] [--png pasta]]\n", argv[0] );
+            return 1;
+        }
+    }
+    bool medicao = arquivoBenchmark != NULL || arquivoRender != NULL || pastaGolden != NULL;
+    if ( medicao ) {
+        // benchmark e render repetem as entradas gravadas: nem bot nem rede
+        modoBot = false;
+        papelRede = REDE_LOCAL;
+    }
+    if ( ( arquivoRender != NULL || pastaGolden != NULL ) && modoHeadless ) {
+        printf( "render e golden: precisam de contexto OpenGL (sem --headless; sem servidor X use xvfb-run)\n" );
+        return 1;
+    }
+    if ( papelRede == REDE_SERVIDOR ) {
+        // o servidor nao tem janela; as teclas chegam pela rede
+        modoHeadless = true;
+        modoBot = false;
+    }
+    if ( modoHeadless && papelRede == REDE_LOCAL && sessoesDesejadas == 0 ) {
+        sessoesDesejadas = 1;
+    }
+    if ( modoHeadless || medicao || papelRede != REDE_LOCAL ) {
+        // so o jogo local com janela tem uma tela para medir
+        baixaLatencia = false;
+        medirLatencia = false;
+    }
+    // benchmark, render e golden sempre na qualidade alta; o bot sem limite
+    // de FPS nao tem orcamento para comparar
+    bool qualidadeAutomatica = nivelQualidade < 0 && !modoHeadless && !medicao && !modoBot;
+    GovernadorCriar( &governador, qualidadeAutomatica, medicao || nivelQualidade < 0 ? QUALIDADE_ALTA : nivelQualidade, 1000.0f / 60.0f );
+
+    EntradaCriar( &entrada );
+    if ( arquivoTeclas != NULL && !EntradaCarregarTeclas( &entrada, arquivoTeclas ) ) {
+        TraceLog( LOG_WARNING, "ENTRADA: %s nao abriu ou tem uma linha invalida", arquivoTeclas );
+    }
+    if ( modoBot ) {
+        entrada.fonte = TeclaDosBots;
+    }
+    if ( medirLatencia ) {
+        sondaLatencia = (SondaLatencia*)MemoriaAlocar( MEMORIA_JOGO, sizeof(SondaLatencia) );
+        SondaLatenciaCriar( sondaLatencia );
+        entrada.registrarEventos = true;
+    }
+
+    // o snapshot leva no maximo REDE_MAX_LIXOS lixos: o servidor usa ate
+    // esse limite e o cliente reserva todos
+    if ( papelRede == REDE_CLIENTE || ( papelRede == REDE_SERVIDOR && numLixos > REDE_MAX_LIXOS ) ) {
+        numLixos = REDE_MAX_LIXOS;
+    }
 
-    // antialiasing
-    SetConfigFlags( FLAG_MSAA_4X_HINT );
+    // o cliente nao roda as regras: quem guarda o placar e o servidor
+    bool historico = !modoBot && !medicao && papelRede != REDE_CLIENTE;
+    if ( arquivoPlacar == NULL && historico ) {
+        arquivoPlacar = "placar.dat";
+    }
+    if ( arquivoEventos == NULL && historico ) {
+        arquivoEventos = "eventos.bin";
+    }
+    if ( !LogEventosAbrir( &logEventos, arquivoEventos ) ) {
+        TraceLog( LOG_WARNING, "EVENTOS: nao foi possivel abrir %s", arquivoEventos );
+    }
+    double inicioPlacar = PlataformaTempo();
+    if ( !PlacarAbrir( &placar, papelRede == REDE_CLIENTE ? NULL : arquivoPlacar ) ) {
+        printf( "placar: sem memoria\n" );
+        return 1;
+    }
+    TraceLog( LOG_INFO, "PLACAR: %d registros carregados em %.3f ms", placar.quantidade, ( PlataformaTempo() - inicioPlacar ) * 1000.0 );
+
+    if ( papelRede != REDE_LOCAL ) {
+        socketRede = RedeAbrir( papelRede == REDE_SERVIDOR ? portaServidor : 0 );
+        if ( socketRede == NULL || ( papelRede == REDE_CLIENTE && !RedeResolver( enderecoServidor, &cliente.servidor ) ) ) {
+            printf( "rede: nao foi possivel abrir o socket ou resolver o endereco\n" );
+            RedeFechar( socketRede );
+            return 1;
+        }
+        cliente.jogadorLocal = -1;
+        cliente.inicio = PlataformaTempo();
+    }
 
-    // creates a new window 800 pixels wide and 600 pixels high
-    InitWindow( 800, 600, "Ocean Guardians - O Jogo" );
+    if ( !modoHeadless ) {
 
-    // init audio device only if your game uses sounds
-    InitAudioDevice();
+        // antialiasing; benchmark e render desenham em uma janela escondida
+        // (o MSAA da janela nao muda depois de criada: so e pedido se o jogo
+        // comeca no nivel que usa). A janela pode mudar de tamanho: a tela
+        // virtual se ajusta
+        SetConfigFlags( ( GovernadorNivel( &governador )->msaa ? FLAG_MSAA_4X_HINT : 0 ) |
+                        ( medicao ? FLAG_WINDOW_HIDDEN : FLAG_WINDOW_RESIZABLE ) | ( baixaLatencia ? FLAG_VSYNC_HINT : 0 ) );
 
-    // FPS: frames per second
-    SetTargetFPS( 60 );
+        // creates a new window with the size of the virtual screen (800x600)
+        InitWindow( TELA_LARGURA, TELA_ALTURA, "Ocean Guardians - O Jogo" );
 
-    // Load all game resources here
-    background = LoadTexture( "resources/images/fundo.jpg" );
-    fire = LoadTexture( "resources/images/fire.png" );
-    legenda = LoadTexture( "resources/images/legenda.png" );
-    placaLegenda = LoadTexture( "resources/images/placa_legenda.png" );
-    madeira = LoadTexture( "resources/images/madeira.png" );
-    start = LoadTexture( "resources/images/start_button.png" );
-    tituloFont = LoadFont("resources/font/Asimovian-Regular.ttf");
-    papelLixo = LoadTexture("resources/images/paperGarbage.png");
-    vidroLixo = LoadTexture("resources/images/glassGarbage.png");
-    plasticoLixo = LoadTexture("resources/images/plasticGarbage.png");
-    metalLixo = LoadTexture("resources/images/metalGarbage.png");
-    jogador.sprite = LoadTexture("resources/images/player_spritesheet.png");
-    lixeiraPlastico = LoadTexture("resources/images/lixeira_plastico.png");
-    lixeiraVidro = LoadTexture("resources/images/lixeira_vidro.png");
-    lixeiraMetal = LoadTexture("resources/images/lixeira_metal.png");
-    lixeiraPapel = LoadTexture("resources/images/lixeira_papel.png");
-    frame = LoadTexture("resources/images/frame.png");
-    hand = LoadTexture("resources/images/hand.png");
+        // init audio device only if your game uses sounds
+        InitAudioDevice();
 
-    musica = LoadMusicStream("resources/sounds/fundo.wav");
-    somDescarteCerto = LoadSound("resources/sounds/acerto.mp3");
-    somDescarteErrado = LoadSound("resources/sounds/erro.wav");
-    // configura o volume da musica de fundo
-    SetMusicVolume(musica, 0.2f);
+        // FPS: frames per second (sem limite no modo de teste, para medir
+        // o custo real de cada quadro)
+        SetTargetFPS( modoBot || medicao ? 0 : 60 );
 
-    // Inicia a reprodução da música de fundo
-    PlayMusicStream(musica);
+        if ( baixaLatencia ) {
+            // quem marca o ritmo e a troca com vsync, nao a espera da raylib
+            SetTargetFPS( 0 );
+            int hz = GetMonitorRefreshRate( GetCurrentMonitor() );
+            AtrasoQuadroCriar( &atrasoQuadro, 1.0 / ( hz > 0 ? hz : 60 ), atrasoFixo );
+            governador.orcamentoMs = (float)( atrasoQuadro.periodo * 1000.0 );
+        }
+        TelaVirtualCriar( &tela, TELA_LARGURA, TELA_ALTURA );
+        AplicarQualidade();
 
-    jogador.pos = (Vector2){ GetScreenWidth()/2- 40, GetScreenHeight()/2 - 60 };
-    jogador.dim = (Vector2){ 120, 120 }; //tamanho do mergulhador
-    jogador.vel = 190; // velocidade do mergulhador
-    jogador.tipoLixo = NENHUM;
-    jogador.pontuacao = 0;
-    // Inicialização dos campos de animação
-    jogador.frameWidth = 100;
-    jogador.frameHeight = 100;
-    jogador.currentFrame = 0;
-    jogador.totalFrames = 4;
-    jogador.frameTimer = 0;
-    jogador.frameSpeed = 0.15f;
-    jogador.isMoving = false;
-    jogador.isFlipped = false;
+        CarregarRecursos();
+
+    }
 
+    // sem janela a raylib nao inicializa o gerador de numeros aleatorios
+    if ( semente != NULL ) {
+        SetRandomSeed( (unsigned int)strtoul( semente, NULL, 10 ) );
+    } else if ( medicao ) {
+        SetRandomSeed( SEMENTE_BENCHMARK );
+    } else if ( modoHeadless ) {
+        SetRandomSeed( (unsigned int)time( NULL ) );
+    }
+
+    EmissorCriar(&bolhas, 8192, texturaBolha, (Vector2){ 0, -60 }, 0.8f, 2.5f, (Color){ 200, 230, 255, 200 });
+    EmissorCriar(&respingosAcerto, 4096, texturaBolha, (Vector2){ 0, -40 }, 2.5f, 0.9f, (Color){ 120, 255, 160, 255 });
+    EmissorCriar(&respingosErro, 4096, texturaBolha, (Vector2){ 0, -40 }, 2.5f, 0.9f, (Color){ 255, 90, 90, 255 });
+
+    for (int j = 0; j < MAX_JOGADORES; j++) {
+        IniciarJogador(&jogadores[j], j);
+    }
 
     spritesLixo[PLASTICO] = plasticoLixo;
     spritesLixo[VIDRO] = vidroLixo;
     spritesLixo[PAPEL] = papelLixo;
     spritesLixo[METAL] = metalLixo;
 
-    //loop array lixo
-    for (int i = 0; i < MAX_LIXOS; i++) {
-       itensLixo[i].active = false;
-    }
+    ArenaCriar(&arenaQuadro, ARENA_QUADRO_BASE);
+    CriarLixos(numLixos);
+    CampoCorrenteGerar(&campoCorrente, MUNDO_WIDTH, MUNDO_HEIGHT, 35.0f, (unsigned int)GetRandomValue(0, 1 << 30));
+    poolTarefas = PoolTarefasCriar(PlataformaNucleos() - 1);
+    CardumeCriar(&cardume, NUM_PEIXES, MUNDO_WIDTH, MUNDO_HEIGHT);
+    CardumeEspalhar(&cardume, NUM_PEIXES, (unsigned int)GetRandomValue(0, 1 << 30));
+
+    camera.zoom = 1.0f;
+    CentralizarCamera(&camera, POSICAO_INICIAL_JOGADOR);
 
-    float startY = GetScreenHeight() - LIXEIRA_HEIGHT - 20; // 20 pixels de margem do fundo
+    float startY = MUNDO_HEIGHT - LIXEIRA_HEIGHT - 20; // 20 pixels de margem do fundo do mar
 
     // Configura cada lixeira (tipo e sprite)
     lixeiras[PLASTICO] = (Lixeira){ .type = PLASTICO, .sprite = lixeiraPlastico };
@@ -222,411 +966,716 @@ int main( void ) {
         lixeiras[i].rect.height = LIXEIRA_HEIGHT;
     }
 
-    // game loop
-    while ( !WindowShouldClose() ) {
-        update( GetFrameTime() );
-        UpdateMusicStream(musica);
-        draw();
+    LoteAABBCriar(&loteLixeiras, NUM_LIXEIRAS);
+    for (int i = 0; i < NUM_LIXEIRAS; i++) {
+        LoteAABBDefinir(&loteLixeiras, i, lixeiras[i].rect);
     }
 
-    // Unload resources before closing
-    UnloadTexture(background);
-    UnloadFont(tituloFont);
-    UnloadTexture(fire);
-    UnloadTexture(legenda);
-    UnloadTexture(placaLegenda);
-    UnloadTexture(madeira);
-    UnloadTexture(start);
-    UnloadTexture(papelLixo);
-    UnloadTexture(vidroLixo);
-    UnloadTexture(plasticoLixo);
-    UnloadTexture(metalLixo);
-    UnloadTexture(lixeiraPlastico);
-    UnloadTexture(lixeiraVidro);
-    UnloadTexture(lixeiraMetal);
-    UnloadTexture(lixeiraPapel);
-    UnloadTexture(frame);
-    UnloadTexture(hand);
-
-    UnloadMusicStream(musica);
-    UnloadSound(somDescarteCerto);
-    UnloadSound(somDescarteErrado);
+    // folga de uma celula (64 px): o centro do mergulhador (120x120) pode
+    // seguir os campos sem encostar nas rochas
+    NavGradeCarregar(&navegacao, "resources/mapa/rochas.txt", MUNDO_WIDTH, MUNDO_HEIGHT, 1);
+    for (int i = 0; i < NUM_LIXEIRAS; i++) {
+        Vector2 centro = { lixeiras[i].rect.x + lixeiras[i].rect.width / 2, lixeiras[i].rect.y + lixeiras[i].rect.height / 2 };
+        FluxoCriar(&caminhoLixeira[i], &navegacao, centro);
+    }
 
-    //Liberação da textura do mergulhador
-    UnloadTexture(jogador.sprite);
-    // close audio device only if your game uses sounds
-    CloseAudioDevice();
-    CloseWindow();
+    // o bot e o servidor medem cada quadro e escrevem uma linha a cada 5 s
+    MedidorQuadros *medidor = NULL;
+    if ( modoBot ) {
+        for (int j = 0; j < MAX_JOGADORES; j++) {
+            const ControlesJogador *c = &entrada.teclado[j];
+            BotCriar(&bots[j], c->esquerda, c->direita, c->cima, c->baixo, c->pegar, c->descartar);
+            BotReservar(&bots[j], &navegacao);
+        }
+    }
+    if ( modoBot || papelRede == REDE_SERVIDOR ) {
+        medidor = (MedidorQuadros*)MemoriaAlocar( MEMORIA_JOGO, sizeof(MedidorQuadros) );
+        if ( !MedidorCriar( medidor, arquivoTelemetria, 5.0 ) ) {
+            TraceLog( LOG_WARNING, "BOT: nao foi possivel criar %s", arquivoTelemetria );
+            MemoriaLiberar( medidor );
+            medidor = NULL;
+        }
+    }
 
-    return 0;
+    // cliente com controle conectado joga com ele; senao, WASD/E/Q (o
+    // jogador local e sempre o primeiro da entrada)
+    if ( papelRede == REDE_CLIENTE && !modoHeadless && IsGamepadAvailable(0) ) {
+        entrada.controles[0] = EntradaControlesDoGamepad(0);
+    }
 
-}
+    EstadosIniciar(&estadoJogo, ESTADOS_JOGO, NUM_ESTADOS, PARADO);
 
-void update( float delta ) {
-    if (ESTADO == PARADO) {
-
-        // Botao iniciar
-        Rectangle iniciar = { GetScreenWidth()/2 - 90, 260, 180, 55 };
-        bool isCollision = CheckCollisionPointRec( GetMousePosition(), iniciar );
-        if( isCollision ){
-            if( IsMouseButtonPressed(MOUSE_LEFT_BUTTON) ){
-                ESTADO = RODANDO;
-                // Spawn do primeiro lixo do jogo
-                itensLixo[0].active = true;
-                itensLixo[0].pos.x = GetRandomValue(30, GetScreenWidth() - 30);
-                itensLixo[0].pos.y = GetRandomValue(60, GetScreenHeight() - 150);
-                int tipoAleatorio = GetRandomValue(0, 3);
-                itensLixo[0].type = (TipoDoLixo)tipoAleatorio;
-                itensLixo[0].sprite = spritesLixo[tipoAleatorio];
+    // game loop (benchmark e render tem os seus)
+    bool rodando = !medicao;
+    int retorno = 0;
+    if ( arquivoBenchmark != NULL && !RodarBenchmark( arquivoBenchmark, cenarioBenchmark, arquivoEntradas ) ) {
+        retorno = 1;
+    }
+    if ( arquivoRender != NULL && !RodarRender( arquivoRender, quadrosRender, pastaPng, arquivoEntradas ) ) {
+        retorno = 1;
+    }
+    if ( pastaGolden != NULL && !RodarGolden( pastaGolden, quadrosRender, pastaPng, toleranciaGolden / 100.0f,
+                                              atualizarGolden, arquivoEntradas ) ) {
+        retorno = 1;
+    }
+    double proximoTick = PlataformaTempo();
+    double fimApresentacao = PlataformaTempo();
+    while ( rodando ) {
+
+        double inicioQuadro = PlataformaTempo();
+        double inicioTrabalho = inicioQuadro; // sem a espera do modo de baixa latencia
+        int estadoNoInicio = estadoJogo.atual;
+        ArenaResetar(&arenaQuadro);
+        if ( papelRede == REDE_SERVIDOR ) {
+            ServidorTick();
+        } else if ( papelRede == REDE_CLIENTE ) {
+            // o cliente com janela anda no ritmo do servidor (taxa/60)
+            AtualizarCliente( modoHeadless ? 1.0f / 60.0f : GetFrameTime() * taxaRede / 60.0f );
+            if ( !modoHeadless ) {
+                UpdateMusicStream(musica);
+                draw();
+                rodando = !WindowShouldClose();
             }
-        }
-
-    } else if (ESTADO == RODANDO) {
-
-        // cronometro
-        if( tempoRestante > 0 ) {
-            tempoRestante -= GetFrameTime();
-        } else if ( tempoRestante <= 0 && jogador.pontuacao < 2000 ) { // Sistema de derrota
-            if( jogador.melhorPontuacao < jogador.pontuacao ){
-                jogador.melhorPontuacao = jogador.pontuacao;
+            rodando = rodando && !cliente.encerrado;
+        } else if ( modoHeadless ) {
+            update( 1.0f / 60.0f );
+        } else if ( baixaLatencia ) {
+            // a busca do EndDrawing anterior ficou velha: busca de novo
+            // logo antes de atualizar (EntradaLer nao perde os apertos)
+            PlataformaDormirAte( fimApresentacao + atrasoQuadro.atraso );
+            PollInputEvents();
+            inicioTrabalho = PlataformaTempo();
+            update( GetFrameTime() );
+            if ( sondaLatencia != NULL ) {
+                SondaLatenciaColetar( sondaLatencia, &entrada );
             }
-            tempoRestante = 0;
-            ESTADO = GAME_LOSE;
-            jogador.pos = (Vector2){ GetScreenWidth()/2- 40, GetScreenHeight()/2 - 60 };
-        }
-
-        // movimentacao do jogador
-        AtualizarJogador(&jogador, KEY_A, KEY_D, KEY_W, KEY_S, delta);
-
-        // Lógica de animação do sprite do jogador
-        if (IsKeyDown(KEY_A) || IsKeyDown(KEY_D) || IsKeyDown(KEY_W) || IsKeyDown(KEY_S)) {
-            jogador.isMoving = true;
-            jogador.frameTimer += GetFrameTime();
-            if (jogador.frameTimer >= jogador.frameSpeed) {
-                jogador.frameTimer = 0;
-                jogador.currentFrame++;
-                if (jogador.currentFrame >= jogador.totalFrames) {
-                    jogador.currentFrame = 0; // Reinicia a animação
-                }
+            UpdateMusicStream(musica);
+            draw();
+            double fimCusto = PlataformaTempo();
+            PlataformaEsperarGpu();
+            fimApresentacao = PlataformaTempo();
+            AtrasoQuadroRegistrar( &atrasoQuadro, fimCusto - inicioTrabalho );
+            if ( sondaLatencia != NULL ) {
+                SondaLatenciaApresentado( sondaLatencia, fimApresentacao );
             }
+            rodando = !WindowShouldClose();
         } else {
-            jogador.isMoving = false;
-            jogador.currentFrame = 0; // Volta para a primeira frame quando o jogador para
+            update( GetFrameTime() );
+            if ( sondaLatencia != NULL ) {
+                SondaLatenciaColetar( sondaLatencia, &entrada );
+            }
+            UpdateMusicStream(musica);
+            draw();
+            // sem esperar a GPU, o fim do EndDrawing (troca, espera do
+            // SetTargetFPS e busca da entrada) faz as vezes da apresentacao
+            if ( sondaLatencia != NULL ) {
+                SondaLatenciaApresentado( sondaLatencia, PlataformaTempo() );
+            }
+            rodando = !WindowShouldClose();
         }
 
+        float msQuadro = (float)( ( PlataformaTempo() - inicioQuadro ) * 1000.0 );
+        if ( medidor != NULL ) {
+            MedidorRegistrar( medidor, msQuadro );
+        }
+        LogEventosFimDoQuadro( &logEventos, msQuadro );
+        if ( !modoHeadless && GovernadorRegistrar( &governador, msQuadro, (float)( ( fimDesenho - inicioTrabalho ) * 1000.0 ) ) ) {
+            // a RenderTexture nova nao conta como alocacao da partida
+            alocacaoPermitida = true;
+            AplicarQualidade();
+        }
+        ConferirAlocacoes( estadoNoInicio );
+        if ( sessoesDesejadas > 0 && sessoesConcluidas >= sessoesDesejadas ) {
+            rodando = false;
+        }
 
-        // Colisao do jogador
-        Rectangle jogadorRec = { jogador.pos.x, jogador.pos.y, jogador.dim.x, jogador.dim.y };
-
-        // Aperte E para pegar o lixo
-        if( IsKeyPressed(KEY_E) ){
-            for( int i = 0; i < MAX_LIXOS; i++ ){
-                if( itensLixo[i].active ){
-                    Rectangle lixoRec = { itensLixo[i].pos.x, itensLixo[i].pos.y, LIXO_WIDTH, LIXO_HEIGHT };
-                    if( CheckCollisionRecs(jogadorRec, lixoRec) ){
-                        jogador.tipoLixo = itensLixo[i].type;
-                        itensLixo[i].active = false;
-                        break;
-                    }
-                }
+        // sem janela, servidor e cliente seguem o relogio; atrasado demais,
+        // o tick seguinte nao tenta recuperar o tempo perdido
+        if ( modoHeadless && papelRede != REDE_LOCAL ) {
+            proximoTick += 1.0 / taxaRede;
+            double espera = proximoTick - PlataformaTempo();
+            if ( espera > 0 ) {
+                PlataformaDormir( espera );
+            } else if ( espera < -0.25 ) {
+                proximoTick = PlataformaTempo();
             }
         }
 
-        // Aperte Q para descartar o lixo
-        if( IsKeyPressed(KEY_Q) && jogador.tipoLixo != NENHUM ){
-            for( int i = 0; i < NUM_LIXEIRAS; i++ ){
-                Rectangle lixeiraRec = lixeiras[i].rect;
-                if (CheckCollisionRecs(jogadorRec, lixeiraRec)) {
-                    if (jogador.tipoLixo == lixeiras[i].type) {
-                        printf("Lixo descartado corretamente na lixeira %d!\n", i);
-                        PlaySound(somDescarteCerto);
-                        jogador.pontuacao += 100;
-                    } else {
-                        printf("Tipo de lixo incorreto. Tente outra lixeira.\n");
-                        PlaySound(somDescarteErrado);
-                        jogador.pontuacao -= 50;
-                    }
-                    // Spawn do lixo
-                    for(int i = 0; i < MAX_LIXOS; i++){
-                        if(!itensLixo[i].active){
-                            itensLixo[i].active = true;
-                            itensLixo[i].pos.x = GetRandomValue(30, GetScreenWidth() - 30);
-                            itensLixo[i].pos.y = GetRandomValue(60, GetScreenHeight() - 150);
-
-                            int tipoAleatorio = GetRandomValue(0, 3);
-                            itensLixo[i].type = (TipoDoLixo)tipoAleatorio;
-                            itensLixo[i].sprite = spritesLixo[tipoAleatorio];
-
-                            break;
-                        }
-                    }
-                    // Limpa o lixo da mão do jogador
-                    jogador.tipoLixo = NENHUM;
-                    break;
+    }
+
+    if ( papelRede == REDE_SERVIDOR ) {
+        // avisa os clientes algumas vezes (UDP pode perder o pacote)
+        uint8_t fim = PACOTE_FIM;
+        for (int k = 0; k < 3; k++) {
+            for (int j = 0; j < numJogadores; j++) {
+                if (servidor.clientes[j].conectado) {
+                    RedeEnviar(socketRede, servidor.clientes[j].endereco, &fim, 1);
                 }
             }
         }
+    }
+    if ( papelRede != REDE_LOCAL ) {
+        RelatorioRede();
+        RedeFechar( socketRede );
+    }
 
-        // Sistema de vitoria
-        if ( jogador.pontuacao >= 2000 ){
-            jogador.pontuacao = 2000;
-            if( jogador.melhorPontuacao < jogador.pontuacao ){
-                jogador.melhorPontuacao = jogador.pontuacao;
-            }
-            ESTADO = GAME_WIN;
-            jogador.pos = (Vector2){ GetScreenWidth()/2- 40, GetScreenHeight()/2 - 60 };
-        }
+    if ( gravandoEntradas ) {
+        // a janela fechou no meio da partida gravada
+        MudarEstado( PARADO );
+    }
 
-        // Botao "G" para ganhar automaticamente
-        if( IsKeyPressed(KEY_G) ){
-            jogador.pontuacao = 2000;
-        }
+    LogEventosFechar( &logEventos );
+    if ( logEventos.gravados > 0 && medidor != NULL ) {
+        printf( "eventos: %lld gravados em %lld bytes (%.2f bytes por evento), %lld perdidos\n",
+                logEventos.gravados, logEventos.bytes, (double)logEventos.bytes / logEventos.gravados, logEventos.perdidos );
+    } else if ( logEventos.perdidos > 0 ) {
+        TraceLog( LOG_WARNING, "EVENTOS: %lld eventos perdidos", logEventos.perdidos );
+    }
 
-        // Botao "P" para perder automaticamente
-        if( IsKeyPressed(KEY_P) ){
-            tempoRestante = 0;
+    if ( modoBot ) {
+        for (int j = 0; j < MAX_JOGADORES; j++) {
+            BotDestruir(&bots[j]);
         }
-
-    } else if (ESTADO == GAME_WIN){
-        // Botao menu
-        Rectangle menu = { 310, 267, 180, 50 };
-        bool isCollision = CheckCollisionPointRec( GetMousePosition(), menu );
-        if( isCollision ){
-            if( IsMouseButtonPressed(MOUSE_LEFT_BUTTON) ){
-                ESTADO = PARADO;
-                jogador.pontuacao = 0;
-                tempoRestante = 180.0f;
-                jogador.tipoLixo = NENHUM;
-                for (int i = 0; i < MAX_LIXOS; i++) {
-                    itensLixo[i].active = false;
-                }
-            }
+    }
+    if ( medidor != NULL ) {
+        if ( sessoesConcluidas > 0 ) {
+            printf( "sessoes: %d, vitorias: %d, derrotas: %d\n", sessoesConcluidas, vitorias, sessoesConcluidas - vitorias );
         }
-    } else if (ESTADO == GAME_LOSE){
-        // Botao menu
-        Rectangle menu = { 310, 267, 180, 50 };
-        bool isCollision = CheckCollisionPointRec( GetMousePosition(), menu );
-        if( isCollision ){
-            if( IsMouseButtonPressed(MOUSE_LEFT_BUTTON) ){
-                ESTADO = PARADO;
-                jogador.pontuacao = 0;
-                tempoRestante = 180.0f;
-                jogador.tipoLixo = NENHUM;
-                for (int i = 0; i < MAX_LIXOS; i++) {
-                    itensLixo[i].active = false;
-                }
-            }
+        MedidorDestruir( medidor );
+        MemoriaLiberar( medidor );
+        EstadosRelatorio( &estadoJogo, stdout );
+    }
+    if ( sondaLatencia != NULL ) {
+        SondaLatenciaRelatorio( sondaLatencia, stdout );
+        if ( baixaLatencia ) {
+            printf( "  atraso de quadro: %.2f ms (%s), periodo %.2f ms\n", atrasoQuadro.atraso * 1000.0,
+                    atrasoQuadro.automatico ? "automatico" : "fixo", atrasoQuadro.periodo * 1000.0 );
         }
+        MemoriaLiberar( sondaLatencia );
     }
-}
 
-void draw( void ) {
-    BeginDrawing();
-    ClearBackground( WHITE );
+    if ( !modoHeadless ) {
+        if ( governador.automatico || tela.alvo.id != 0 ) {
+            GovernadorRelatorio( &governador, stdout );
+        }
+        TelaVirtualDestruir( &tela );
+        DescarregarRecursos();
+    }
 
-    if(ESTADO == PARADO) {
-        draw_menu();
-    } else if (ESTADO == RODANDO) {
-        draw_gameplay();
-    } else if (ESTADO == GAME_WIN){
-        draw_win();
-    } else if (ESTADO == GAME_LOSE){
-        draw_lose();
+    DestruirLixos();
+    ArenaDestruir(&arenaQuadro);
+    CardumeDestruir(&cardume);
+    PoolTarefasDestruir(poolTarefas);
+    LoteAABBDestruir(&loteLixeiras);
+    for (int i = 0; i < NUM_LIXEIRAS; i++) {
+        FluxoDestruir(&caminhoLixeira[i]);
     }
+    NavGradeDestruir(&navegacao);
+    EmissorDestruir(&bolhas);
+    EmissorDestruir(&respingosAcerto);
+    EmissorDestruir(&respingosErro);
 
-    EndDrawing();
-}
+    PlacarFechar(&placar);
 
-void draw_menu( void ){
-    // Fundo
-    Rectangle sourceRec = { 0, 0, (float)background.width, (float)background.height };
-    Rectangle destRec = { 0, 0, (float)GetScreenWidth(), (float)GetScreenHeight() };
-    Vector2 origin = { 0, 0 };
-    Color transparentWhite = ColorAlpha(WHITE, 0.9f);
-    DrawTexturePro(background, sourceRec, destRec, origin, 0, transparentWhite);
+    if ( !modoHeadless ) {
+        // close audio device only if your game uses sounds
+        CloseAudioDevice();
+        CloseWindow();
+    }
 
-    // Titulo
-    Vector2 tituloPos = { GetScreenWidth() / 2 - MeasureTextEx(tituloFont, "Ocean Guardians", 100, 1).x / 2, 100 };
-    DrawTextEx(tituloFont, "Ocean Guardians", tituloPos, 100, 1, WHITE);
-    // Botao start
-    Rectangle startSourceRec = { 0, 0, (float)start.width, (float)start.height};
-    Rectangle startDestRec = { GetScreenWidth()/2 - 150, 163.5, 300, 250 };
+    // tudo ja foi liberado: bytes vivos aqui sao vazamento
+    MemoriaRelatorio( stdout );
+    if ( quadrosComAlocacao > 0 ) {
+        printf( "memoria: %lld quadro(s) da partida alocaram\n", quadrosComAlocacao );
+        if ( modoHeadless ) {
+            retorno = 1;
+        }
+    }
+
+    return retorno;
+
+}
+
+void update( float delta ) {
+    // os bots decidem as teclas antes de os jogadores lerem a entrada
+    if ( modoBot && estadoJogo.atual == RODANDO ) {
+        PensarBots(delta);
+    }
+    LerEntrada();
+    EstadosAtualizar(&estadoJogo, delta);
+}
+
+void LerEntrada( void ){
+    EntradaLer(&entrada, numJogadores);
+    entrada.atual.ponteiro = TelaVirtualPonto(&tela, entrada.atual.ponteiro);
+    if (papelRede == REDE_LOCAL && !repetindoEntradas) {
+        memcpy(entradaRede, entrada.atual.jogadores, sizeof(entradaRede));
+        if (entrada.atual.tocou) {
+            entradaRede[0] |= AcaoDoToque(&jogadores[0]);
+        }
+    }
+}
+
+void PensarBots( float delta ){
+    for (int j = 0; j < numJogadores; j++) {
+        Jogador *jogador = &jogadores[j];
+        VisaoBot visao = {
+            (Rectangle){ jogador->pos.x, jogador->pos.y, jogador->dim.x, jogador->dim.y },
+            jogador->tipoLixo == NENHUM ? -1 : (int)jogador->tipoLixo,
+            &loteLixo, &loteLixeiras, &navegacao, caminhoLixeira
+        };
+        BotPensar(&bots[j], &visao, delta);
+    }
+}
+
+void EntrarMenu( int anterior ){
+    // enquanto o menu esta aberto, o streaming traz o fundo de onde a
+    // proxima partida comeca; o que ficou da partida anterior sai do cache
+    // LRU conforme esses chunks chegam
+    Camera2D inicio = camera;
+    inicio.zoom = 1.0f;
+    CentralizarCamera(&inicio, POSICAO_INICIAL_JOGADOR);
+    areaInicioPartida = AreaVisivel(inicio);
+}
+
+void AtualizarMenu( float delta ){
+
+    StreamingAtualizar(&fundoOceano, areaInicioPartida, Vector2Zero());
+
+    // quantidade de mergulhadores: teclas 1 a 4
+    for (int n = 1; n <= MAX_JOGADORES; n++) {
+        if (EntradaAtalho(&entrada, (AtalhoEntrada)(ATALHO_UM_JOGADOR + n - 1))) {
+            numJogadores = n;
+        }
+    }
+
+    // F9 continua a partida salva
+    if (EntradaAtalho(&entrada, ATALHO_CARREGAR) && CarregarPartida(ARQUIVO_QUICKSAVE)) {
+        return;
+    }
+
+    // Botao iniciar
+    if( BotaoClicado(BOTAO_INICIAR) ){
+        IniciarPartida();
+    }
+
+}
+
+void AtualizarPartida( float delta ){
+
+    // cronometro
+    if( tempoRestante > 0 ) {
+        tempoRestante -= delta;
+    } else if ( PontuacaoEquipe() < 2000 ) { // Sistema de derrota
+        tempoRestante = 0;
+        MudarEstado(GAME_LOSE);
+        RegistrarPlacar();
+        return; // a partida acabou: nada mais pode pontuar neste tick
+    }
+
+    if (gravandoEntradas) {
+        GravacaoAdicionar(&gravacao, entradaRede);
+    }
+
+    // movimentacao e animacao dos jogadores
+    for (int j = 0; j < numJogadores; j++) {
+        AtualizarJogador(&jogadores[j], entradaRede[j], delta);
+        AnimarJogador(&jogadores[j], (entradaRede[j] & REDE_MOVIMENTO) != 0, delta);
+    }
+    AtualizarCameraEquipe(delta);
+
+    EmissorAtualizar(&bolhas, delta);
+    EmissorAtualizar(&respingosAcerto, delta);
+    EmissorAtualizar(&respingosErro, delta);
+
+    // deriva do lixo: as correntes ficam ate 50% mais fortes no fim do tempo
+    float intensidadeCorrente = 1.0f + 0.5f * (1.0f - tempoRestante / 180.0f);
+    DerivaIntegrar(&derivaLixo, &campoCorrente, intensidadeCorrente, delta, poolTarefas);
+    for (int i = 0; i < numLixos; i++) {
+        if (itensLixo[i].active) {
+            // as rochas seguram o lixo: ele para onde encostou
+            Rectangle novo = { derivaLixo.x[i], derivaLixo.y[i], LIXO_WIDTH, LIXO_HEIGHT };
+            if (NavRetanguloNaRocha(&navegacao, novo)) {
+                derivaLixo.x[i] = itensLixo[i].pos.x;
+                derivaLixo.y[i] = itensLixo[i].pos.y;
+                derivaLixo.vx[i] = 0;
+                derivaLixo.vy[i] = 0;
+            }
+            itensLixo[i].pos = (Vector2){ derivaLixo.x[i], derivaLixo.y[i] };
+            GradeInserir(&gradeLixo, i, itensLixo[i].pos);
+            LoteAABBDefinir(&loteLixo, i, (Rectangle){ itensLixo[i].pos.x, itensLixo[i].pos.y, LIXO_WIDTH, LIXO_HEIGHT });
+        }
+    }
+
+    AtualizarPeixes(delta);
+
+    // Aperte E (ou o botao de pegar do jogador) para pegar o lixo
+    ResolverColetas();
+
+    // Aperte Q para descartar o lixo
+    for (int j = 0; j < numJogadores; j++) {
+        Jogador *jogador = &jogadores[j];
+        if( !(entradaRede[j] & REDE_DESCARTOU) || jogador->tipoLixo == NENHUM ){
+            continue;
+        }
+        Rectangle jogadorRec = { jogador->pos.x, jogador->pos.y, jogador->dim.x, jogador->dim.y };
+        int i;
+        if( ColisaoLoteIndices(jogadorRec, &loteLixeiras, &i, 1) == 1 ){
+            Rectangle lixeiraRec = lixeiras[i].rect;
+            Vector2 bocaLixeira = { lixeiraRec.x + lixeiraRec.width / 2, lixeiraRec.y + 10 };
+            int respingos = (int)(120 * GovernadorNivel(&governador)->particulas);
+            if (jogador->tipoLixo == lixeiras[i].type) {
+                PlaySound(somDescarteCerto);
+                EmissorEmitir(&respingosAcerto, bocaLixeira, respingos, (Vector2){ 0, -60 }, 160, 8);
+                jogador->pontuacao += 100;
+            } else {
+                PlaySound(somDescarteErrado);
+                EmissorEmitir(&respingosErro, bocaLixeira, respingos, (Vector2){ 0, -60 }, 160, 8);
+                jogador->pontuacao -= 50;
+            }
+            LogEventosRegistrar(&logEventos, EVENTO_DESCARTE, j, jogador->tipoLixo, lixeiras[i].type, jogador->pontuacao);
+            // Spawn do lixo
+            for(int i = 0; i < numLixos; i++){
+                if(!itensLixo[i].active){
+                    SpawnarLixo(i);
+                    break;
+                }
+            }
+            // Limpa o lixo da mão do jogador
+            jogador->tipoLixo = NENHUM;
+        }
+    }
+
+    // Sistema de vitoria
+    if ( PontuacaoEquipe() >= 2000 ){
+        MudarEstado(GAME_WIN);
+        RegistrarPlacar();
+        return;
+    }
+
+    // Botao "G" para ganhar automaticamente
+    if( EntradaAtalho(&entrada, ATALHO_GANHAR) ){
+        jogadores[0].pontuacao = 2000;
+    }
+
+    // Botao "P" para perder automaticamente
+    if( EntradaAtalho(&entrada, ATALHO_PERDER) ){
+        tempoRestante = 0;
+    }
+
+    // quicksave
+    if (EntradaAtalho(&entrada, ATALHO_SALVAR)) {
+        alocacaoPermitida = true;
+        SalvarPartida(ARQUIVO_QUICKSAVE);
+    } else if (EntradaAtalho(&entrada, ATALHO_CARREGAR)) {
+        alocacaoPermitida = true;
+        if (CarregarPartida(ARQUIVO_QUICKSAVE)) {
+            return; // a partida carregada comeca no proximo tick
+        }
+    }
+    if (tempoMensagemHud > 0) {
+        tempoMensagemHud -= delta;
+    }
+
+}
+
+void AtualizarFimDePartida( float delta ){
+    // Botao menu (os jogadores sao reiniciados por IniciarEquipe)
+    if( BotaoClicado(BOTAO_MENU) ){
+        RegistrarSessao();
+        MudarEstado(PARADO);
+        tempoRestante = 180.0f;
+        LimparLixos();
+    }
+}
+
+void draw( void ) {
+    BeginDrawing();
+    TelaVirtualComecar( &tela );
+    ClearBackground( WHITE );
+    DesenharTela();
+    if ( sondaLatencia != NULL && SondaLatenciaPendente( sondaLatencia ) ) {
+        DrawRectangle( 0, 0, TAMANHO_MARCA_LATENCIA, TAMANHO_MARCA_LATENCIA, WHITE );
+    }
+    TelaVirtualTerminar( &tela );
+    fimDesenho = PlataformaTempo();
+    EndDrawing();
+}
+
+void AplicarQualidade( void ) {
+
+    const NivelQualidade *nivel = GovernadorNivel( &governador );
+    TelaVirtualDefinirEscala( &tela, nivel->msaa ? 0 : nivel->escala );
+    TraceLog( LOG_INFO, "QUALIDADE: nivel %s (escala %.2f, particulas %.2f)", nivel->nome, nivel->escala, nivel->particulas );
+
+}
+
+void DesenharTela( void ) {
+    EstadosDesenhar(&estadoJogo);
+}
+
+void draw_menu( void ){
+    // Fundo
+    Rectangle sourceRec = { 0, 0, (float)background.width, (float)background.height };
+    Rectangle destRec = { 0, 0, (float)TELA_LARGURA, (float)TELA_ALTURA };
+    Vector2 origin = { 0, 0 };
+    Color transparentWhite = ColorAlpha(WHITE, 0.9f);
+    DrawTexturePro(background, sourceRec, destRec, origin, 0, transparentWhite);
+
+    // Titulo
+    Vector2 tituloPos = { TELA_LARGURA / 2 - MeasureTextEx(tituloFont, "Ocean Guardians", 100, 1).x / 2, 100 };
+    DrawTextEx(tituloFont, "Ocean Guardians", tituloPos, 100, 1, WHITE);
+    // Botao start
+    Rectangle startSourceRec = { 0, 0, (float)start.width, (float)start.height};
+    Rectangle startDestRec = { TELA_LARGURA/2 - 150, 163.5, 300, 250 };
     Vector2 startOrigin = { 0 , 0 };
     DrawTexturePro(start, startSourceRec, startDestRec, startOrigin, 0, WHITE);
     
 
     // Legenda
     Rectangle placaLegendaSourceRec = { 0, 0, (float)placaLegenda.width, (float)placaLegenda.height};
-    Rectangle placaLegendaDestRec = { GetScreenWidth() - 200, GetScreenHeight() - 360, 200, 280 };
+    Rectangle placaLegendaDestRec = { TELA_LARGURA - 200, TELA_ALTURA - 360, 200, 280 };
     Vector2 placaLegendaOrigin = { 0 , 0 };
     DrawTexturePro(placaLegenda, placaLegendaSourceRec, placaLegendaDestRec, placaLegendaOrigin, 0, WHITE);
     // Figura legenda
     Rectangle legendaSourceRec = { 0, 0, (float)legenda.width, (float)legenda.height};
-    Rectangle legendaDestRec = { GetScreenWidth() - 325, GetScreenHeight() - 335, 450, 200 };
+    Rectangle legendaDestRec = { TELA_LARGURA - 325, TELA_ALTURA - 335, 450, 200 };
     Vector2 legendaOrigin = { 0 , 0 };
     DrawTexturePro(legenda, legendaSourceRec, legendaDestRec, legendaOrigin, 0, WHITE);
 
     // Textos secundarios
     Rectangle madeiraSourceRec = { 0, 0, (float)madeira.width, (float)madeira.height};
-    Rectangle madeiraDestRec = { GetScreenWidth() - 630, GetScreenHeight() / 2 + 70 , 450, 200 };
+    Rectangle madeiraDestRec = { TELA_LARGURA - 630, TELA_ALTURA / 2 + 70 , 450, 200 };
     Vector2 madeiraOrigin = { 0 , 0 };
     DrawTexturePro(madeira, madeiraSourceRec, madeiraDestRec, madeiraOrigin, 0, WHITE);
-    DrawText("WASD para movimentacao", GetScreenWidth()/2 - 150 , 435, 20, WHITE);
-    DrawText("Aperte E para pegar o lixo", GetScreenWidth()/2 - 150 , 455, 20, WHITE);
-    DrawText("Aperte Q para descartar o lixo", GetScreenWidth()/2 - 150 , 475, 20, WHITE);
+    DrawText("WASD para movimentacao", TELA_LARGURA/2 - 150 , 435, 20, WHITE);
+    DrawText("Aperte E para pegar o lixo", TELA_LARGURA/2 - 150 , 455, 20, WHITE);
+    DrawText("Aperte Q para descartar o lixo", TELA_LARGURA/2 - 150 , 475, 20, WHITE);
+    DrawText(ArenaFormatar(&arenaQuadro, "Jogadores (teclas 1-4): %d", numJogadores), TELA_LARGURA/2 - 150 , 495, 20, WHITE);
+    DrawText("F5 salva a partida, F9 continua", TELA_LARGURA/2 - 150 , 515, 20, WHITE);
 
     Rectangle fireSourceRec = { 0, 0, (float)fire.width, (float)fire.height};
-    Rectangle fireDestRec = { 45, GetScreenHeight() / 2 - 105, 160, 160 };
+    Rectangle fireDestRec = { 45, TELA_ALTURA / 2 - 105, 160, 160 };
     Vector2 fireOrigin = { 0 , 0 };
     DrawTexturePro(fire, fireSourceRec, fireDestRec, fireOrigin, 0, WHITE);
-    DrawText("Melhor", 75, GetScreenHeight()/2 - 20, 20, WHITE);
-    DrawText("Pontuacao:", 75, GetScreenHeight()/2 - 5, 20, WHITE);
-    DrawText( TextFormat( "%03d", jogador.melhorPontuacao ) , 110, GetScreenHeight()/2 + 20, 20, WHITE);
+    DrawText("Melhor", 75, TELA_ALTURA/2 - 20, 20, WHITE);
+    DrawText("Pontuacao:", 75, TELA_ALTURA/2 - 5, 20, WHITE);
+    DrawText( ArenaFormatar( &arenaQuadro, "%03d", placar.melhorEquipe ) , 110, TELA_ALTURA/2 + 20, 20, WHITE);
+
+    // ranking individual: pontuacao e mergulhador (J1 a J4) de cada partida
+    for (int i = 0; i < placar.tamanhoRanking; i++) {
+        const RegistroPlacar *r = &placar.ranking[i];
+        DrawText(ArenaFormatar(&arenaQuadro, "%d. J%d %d", i + 1, r->jogador + 1, r->pontuacao), 60, TELA_ALTURA/2 + 70 + i * 18, 16, WHITE);
+    }
 
     DrawText("Desenvolvido por estudantes do segundo semestre de ciencia da computacao", 10, 580, 19, BLACK);
 }
 
 void draw_gameplay( void ){
-    // background
-    Rectangle sourceRecBackground = { 0, 0, (float)background.width, (float)background.height };
-    Rectangle destRecBackground = { 0, 0, (float)GetScreenWidth(), (float)GetScreenHeight() };
-    Vector2 originBackground = { 0, 0 };
-    DrawTexturePro(background, sourceRecBackground, destRecBackground, originBackground, 0, WHITE);
+    // tudo ate EndMode2D e desenhado em coordenadas do mapa
+    Rectangle visivel = AreaVisivel(camera);
+    BeginMode2D(camera);
+
+    // background: chunks do mapa ou, sem o arquivo do mapa, ladrilhos de
+    // fundo.jpg; em ambos os casos so o que aparece na camera
+    if (fundoOceano.valido) {
+        StreamingDesenhar(&fundoOceano, visivel);
+    } else {
+        Rectangle sourceRecBackground = { 0, 0, (float)background.width, (float)background.height };
+        Vector2 originBackground = { 0, 0 };
+        int tx0 = (int)(visivel.x / FUNDO_TILE_WIDTH);
+        int ty0 = (int)(visivel.y / FUNDO_TILE_HEIGHT);
+        int tx1 = (int)((visivel.x + visivel.width) / FUNDO_TILE_WIDTH);
+        int ty1 = (int)((visivel.y + visivel.height) / FUNDO_TILE_HEIGHT);
+        for (int ty = ty0; ty <= ty1; ty++) {
+            for (int tx = tx0; tx <= tx1; tx++) {
+                Rectangle destRecBackground = { tx * FUNDO_TILE_WIDTH, ty * FUNDO_TILE_HEIGHT, FUNDO_TILE_WIDTH, FUNDO_TILE_HEIGHT };
+                DrawTexturePro(background, sourceRecBackground, destRecBackground, originBackground, 0, WHITE);
+            }
+        }
+    }
+
+    NavDesenharRochas(&navegacao, visivel, (Color){ 88, 74, 66, 255 });
 
     // desenho das lixeiras
     for (int i = 0; i < NUM_LIXEIRAS; i++) {
+        if (!CheckCollisionRecs(lixeiras[i].rect, visivel)) {
+            continue;
+        }
         Rectangle source = { 0, 0, (float)lixeiras[i].sprite.width, (float)lixeiras[i].sprite.height };
         DrawTexturePro(lixeiras[i].sprite, source, lixeiras[i].rect, (Vector2){0,0}, 0, WHITE);
     }
 
-    // geracao do lixo na tela
-    for (int i = 0; i < MAX_LIXOS; i++) {
-        if (itensLixo[i].active) {
-            Rectangle source = {0, 0, (float)itensLixo[i].sprite.width,
-            (float)itensLixo[i].sprite.height };
+    // geracao do lixo na tela: a grade so devolve os lixos perto da camera
+    int *lixosVisiveis = (int*)ArenaAlocar(&arenaQuadro, sizeof(int) * numLixos);
+    int quantidadeVisiveis = GradeConsultar(&gradeLixo, visivel, lixosVisiveis, numLixos);
+    for (int k = 0; k < quantidadeVisiveis; k++) {
+        int i = lixosVisiveis[k];
+        Rectangle source = {0, 0, (float)itensLixo[i].sprite.width,
+        (float)itensLixo[i].sprite.height };
+
+        Rectangle dest = {itensLixo[i].pos.x, itensLixo[i].pos.y, LIXO_WIDTH, LIXO_HEIGHT};
+
+        Vector2 origin = {0, 0};
+
+        DrawTexturePro(itensLixo[i].sprite, source, dest, origin, 0, WHITE);
+    }
 
-            Rectangle dest = {itensLixo[i].pos.x, itensLixo[i].pos.y, LIXO_WIDTH, LIXO_HEIGHT};
+    // peixes (mesmo lote de sprites do lixo)
+    CardumeDesenhar(&cardume, spritePeixe, visivel);
 
-            Vector2 origin = {0, 0};
+    // respingos dos descartes (um lote por emissor)
+    EmissorDesenhar(&respingosAcerto, visivel);
+    EmissorDesenhar(&respingosErro, visivel);
 
-            DrawTexturePro(itensLixo[i].sprite, source, dest, origin, 0, WHITE);
+    // mergulhadores (players), todos com o mesmo sprite
+    for (int j = 0; j < numJogadores; j++) {
+        const Jogador *jogador = &jogadores[j];
+        // inverter o sprite caso o jogador esteja se movendo para a direita
+        float frameWidth = (float)jogador->frameWidth;
+        if (jogador->isFlipped) {
+            frameWidth = -frameWidth; // vira o sprite horizontalmente
         }
+        // source desenha a parte da imagem do arquivo spritesheet
+        Rectangle source = { (float)jogador->currentFrame * jogador->frameWidth, 0, frameWidth, (float)jogador->frameHeight };
+        Rectangle dest = { jogador->pos.x, jogador->pos.y, jogador->dim.x, jogador->dim.y };
+        Vector2 origin = { 0, 0 };
+        DrawTexturePro(spriteMergulhador, source, dest, origin, 0, COR_JOGADOR[j]);
+    }
+
+    EmissorDesenhar(&bolhas, visivel);
+
+    EndMode2D();
+
+    // daqui em diante o HUD e desenhado em coordenadas de tela
+
+    // pontuacao (com mais de um jogador, uma linha por mergulhador)
+    for (int j = 0; j < numJogadores; j++) {
+        const char *texto = numJogadores == 1 ? ArenaFormatar( &arenaQuadro, "%d", jogadores[j].pontuacao )
+                                              : ArenaFormatar( &arenaQuadro, "J%d: %d", j + 1, jogadores[j].pontuacao );
+        DrawText( texto, 20, 17.5 + j * 32, 30, BLACK );
     }
 
-    // pontuacao
-    DrawText( TextFormat( "%d", jogador.pontuacao ), 20, 17.5, 30, BLACK );
+    if (tempoMensagemHud > 0 && mensagemHud != NULL) {
+        DrawText(mensagemHud, TELA_LARGURA/2 - MeasureText(mensagemHud, 20)/2, 60, 20, BLACK);
+    }
 
     // cronometro
     int minutos = (int)(tempoRestante / 60);
     int segundos = (int)(tempoRestante) % 60;
-    DrawText( TextFormat( "%02d:%02d", minutos, segundos ), GetScreenWidth()/2 - 30, 15, 40, BLACK );
-
-    // item na mao (frame)
-    Rectangle frameSourceRec = { 0, 0, (float)frame.width, (float)frame.height };
-    Rectangle frameDestRec = { GetScreenWidth() - 75, 10, 55, 55 };
-    Vector2 frameOrigin = { 0, 0 };
-    DrawTexturePro(frame, frameSourceRec, frameDestRec, frameOrigin, 0, WHITE);
-
-    // item na mao (lixo)
-    if (jogador.tipoLixo != NENHUM) {
-        Texture2D itemSprite = spritesLixo[jogador.tipoLixo];
-        Rectangle itemSourceRec = { 0, 0, (float)itemSprite.width, (float)itemSprite.height };
-        Rectangle itemDestRec = { GetScreenWidth() - 60, 22, 25, 30 };
-        Vector2 itemOrigin = { 0, 0 };
-        DrawTexturePro(itemSprite, itemSourceRec, itemDestRec, itemOrigin, 0, WHITE);
-    } else {
-        Rectangle handSourceRec = { 0, 0, (float)hand.width, (float)hand.height };
-        Rectangle handDestRec = { GetScreenWidth() - 63, 23, 32, 27 };
-        Vector2 handOrigin = { 0, 0 };
-        DrawTexturePro(hand, handSourceRec, handDestRec, handOrigin, 0, WHITE);
-    }
-
-    // mergulhador(player)
-    // inverter o sprite caso o jogador esteja se movendo para a direita
-    float frameWidth = (float)jogador.frameWidth;
-    if (jogador.isFlipped) {
-        frameWidth = -frameWidth; // vira o sprite horizontalmente
+    DrawText( ArenaFormatar( &arenaQuadro, "%02d:%02d", minutos, segundos ), TELA_LARGURA/2 - 30, 15, 40, BLACK );
+
+    // item na mao de cada jogador, da direita para a esquerda
+    for (int j = 0; j < numJogadores; j++) {
+        float x = TELA_LARGURA - 75 - j * 65;
+
+        // frame
+        Rectangle frameSourceRec = { 0, 0, (float)frame.width, (float)frame.height };
+        Rectangle frameDestRec = { x, 10, 55, 55 };
+        Vector2 frameOrigin = { 0, 0 };
+        DrawTexturePro(frame, frameSourceRec, frameDestRec, frameOrigin, 0, COR_JOGADOR[j]);
+
+        // lixo ou mao vazia
+        if (jogadores[j].tipoLixo != NENHUM) {
+            Texture2D itemSprite = spritesLixo[jogadores[j].tipoLixo];
+            Rectangle itemSourceRec = { 0, 0, (float)itemSprite.width, (float)itemSprite.height };
+            Rectangle itemDestRec = { x + 15, 22, 25, 30 };
+            Vector2 itemOrigin = { 0, 0 };
+            DrawTexturePro(itemSprite, itemSourceRec, itemDestRec, itemOrigin, 0, WHITE);
+        } else {
+            Rectangle handSourceRec = { 0, 0, (float)hand.width, (float)hand.height };
+            Rectangle handDestRec = { x + 12, 23, 32, 27 };
+            Vector2 handOrigin = { 0, 0 };
+            DrawTexturePro(hand, handSourceRec, handDestRec, handOrigin, 0, WHITE);
+        }
     }
-    // source desenha a parte da imagem do arquivo spritesheet
-    Rectangle source = { (float)jogador.currentFrame * jogador.frameWidth, 0, frameWidth, (float)jogador.frameHeight };
-    Rectangle dest = { jogador.pos.x, jogador.pos.y, jogador.dim.x, jogador.dim.y };
-    Vector2 origin = { 0, 0 };
-    DrawTexturePro(jogador.sprite, source, dest, origin, 0, WHITE);
 }
 
 void draw_win( void ){
     // Fundo
     Rectangle sourceRec = { 0, 0, (float)background.width, (float)background.height };
-    Rectangle destRec = { 0, 0, (float)GetScreenWidth(), (float)GetScreenHeight() };
+    Rectangle destRec = { 0, 0, (float)TELA_LARGURA, (float)TELA_ALTURA };
     Vector2 origin = { 0, 0 };
     Color transparentWhite = ColorAlpha(WHITE, 0.9f);
     DrawTexturePro(background, sourceRec, destRec, origin, 0, transparentWhite);
 
     // Mensagem de win e botao
-    Vector2 tituloPos = { GetScreenWidth() / 2 - MeasureTextEx(tituloFont, "Vitória", 100, 1).x / 2, 100 };
+    Vector2 tituloPos = { TELA_LARGURA / 2 - MeasureTextEx(tituloFont, "Vitória", 100, 1).x / 2, 100 };
     DrawTextEx(tituloFont, "Vitoria", tituloPos, 100, 1, WHITE);
-    DrawRectangle(310, 267, 180, 50, BLUE);
+    DrawRectangleRec(BOTAO_MENU, BLUE);
     int iniciarTextWidth = MeasureText("MENU", 30);
-    DrawText("MENU", GetScreenWidth()/2 - iniciarTextWidth/2, 280, 30, WHITE);
+    DrawText("MENU", TELA_LARGURA/2 - iniciarTextWidth/2, 280, 30, WHITE);
 
     // Textos secundarios
-    DrawRectangle( (GetScreenWidth() / 2 - 250), (GetScreenHeight() / 2 + 75), 480, 70, BLUE );
-    DrawText("Sua ajuda virou o jogo contra a poluição!", GetScreenWidth()/2 - 225 , 390, 20, WHITE);
-    DrawText("Seja a mudança que você quer ver no mar!", GetScreenWidth()/2 - 225 , 410, 20, WHITE);
+    DrawRectangle( (TELA_LARGURA / 2 - 250), (TELA_ALTURA / 2 + 75), 480, 70, BLUE );
+    DrawText("Sua ajuda virou o jogo contra a poluição!", TELA_LARGURA/2 - 225 , 390, 20, WHITE);
+    DrawText("Seja a mudança que você quer ver no mar!", TELA_LARGURA/2 - 225 , 410, 20, WHITE);
 }
 
 void draw_lose( void ){
     // Fundo
     Rectangle sourceRec = { 0, 0, (float)background.width, (float)background.height };
-    Rectangle destRec = { 0, 0, (float)GetScreenWidth(), (float)GetScreenHeight() };
+    Rectangle destRec = { 0, 0, (float)TELA_LARGURA, (float)TELA_ALTURA };
     Vector2 origin = { 0, 0 };
     Color transparentWhite = ColorAlpha(WHITE, 0.9f);
     DrawTexturePro(background, sourceRec, destRec, origin, 0, transparentWhite);
 
     // Mensagem de win e botao
-    Vector2 tituloPos = { GetScreenWidth() / 2 - MeasureTextEx(tituloFont, "Vitória", 100, 1).x / 2 - 30, 100 };
+    Vector2 tituloPos = { TELA_LARGURA / 2 - MeasureTextEx(tituloFont, "Vitória", 100, 1).x / 2 - 30, 100 };
     DrawTextEx(tituloFont, "Derrota", tituloPos, 100, 1, WHITE);
-    DrawRectangle(310, 267, 180, 50, BLUE);
+    DrawRectangleRec(BOTAO_MENU, BLUE);
     int iniciarTextWidth = MeasureText("MENU", 30);
-    DrawText("MENU", GetScreenWidth()/2 - iniciarTextWidth/2, 280, 30, WHITE);
+    DrawText("MENU", TELA_LARGURA/2 - iniciarTextWidth/2, 280, 30, WHITE);
 
     // Textos secundarios
-    DrawRectangle( (GetScreenWidth() / 2 - 225), (GetScreenHeight() / 2 + 75), 420, 70, BLUE );
-    DrawText("A poluição tomou conta desta vez...", GetScreenWidth()/2 - 200 , 390, 20, WHITE);
-    DrawText("Mas você ainda pode lutar pelo mar!", GetScreenWidth()/2 - 200 , 410, 20, WHITE);
+    DrawRectangle( (TELA_LARGURA / 2 - 225), (TELA_ALTURA / 2 + 75), 420, 70, BLUE );
+    DrawText("A poluição tomou conta desta vez...", TELA_LARGURA/2 - 200 , 390, 20, WHITE);
+    DrawText("Mas você ainda pode lutar pelo mar!", TELA_LARGURA/2 - 200 , 410, 20, WHITE);
 }
 
 // Função para movimento do jogador
-void AtualizarJogador(Jogador *jogador, int teclaEsquerda, int teclaDireita, int teclaCima, int teclaBaixo, float delta){
+void AtualizarJogador(Jogador *jogador, uint8_t teclas, float delta){
+
+    Vector2 posAnterior = jogador->pos;
 
     // Movimento do jogador
-    if ( IsKeyDown( teclaEsquerda ) ) {
+    if ( teclas & REDE_ESQUERDA ) {
         jogador->pos.x -= jogador->vel * delta;
         jogador->isFlipped = false; // Vira para a esquerda (padrão)
     }
 
-    if ( IsKeyDown( teclaDireita ) ) {
+    if ( teclas & REDE_DIREITA ) {
         jogador->pos.x += jogador->vel * delta;
         jogador->isFlipped = true;  // Vira para a direita
     }
 
-    if (IsKeyDown(teclaCima)) {
+    // rochas: desfaz o eixo que entrou nelas, assim o mergulhador desliza
+    // encostado na parede
+    if ( NavRetanguloNaRocha( &navegacao, (Rectangle){ jogador->pos.x, posAnterior.y, jogador->dim.x, jogador->dim.y } ) ) {
+        jogador->pos.x = posAnterior.x;
+    }
+
+    if (teclas & REDE_CIMA) {
         jogador->pos.y -= jogador->vel * delta;
     }
 
-    if (IsKeyDown(teclaBaixo)) {
+    if (teclas & REDE_BAIXO) {
         jogador->pos.y += jogador->vel * delta;
     }
 
-    // Verificação de limites para manter o jogador na tela
+    if ( NavRetanguloNaRocha( &navegacao, (Rectangle){ jogador->pos.x, jogador->pos.y, jogador->dim.x, jogador->dim.y } ) ) {
+        jogador->pos.y = posAnterior.y;
+    }
+
+    // Verificação de limites para manter o jogador no mapa
     // Limite esquerdo
     if ( jogador->pos.x < 0 ) {
         jogador->pos.x = 0;
     }
 
     // Limite direito
-    if ( jogador->pos.x + jogador->dim.x > GetScreenWidth() ) {
-        jogador->pos.x = GetScreenWidth() - jogador->dim.x;
+    if ( jogador->pos.x + jogador->dim.x > MUNDO_WIDTH ) {
+        jogador->pos.x = MUNDO_WIDTH - jogador->dim.x;
     }
 
     // Limite superior
@@ -635,8 +1684,1453 @@ void AtualizarJogador(Jogador *jogador, int teclaEsquerda, int teclaDireita, int
     }
 
     // Limite inferior
-    if ( jogador->pos.y + jogador->dim.y > GetScreenHeight() ) {
-        jogador->pos.y = GetScreenHeight() - jogador->dim.y;
+    if ( jogador->pos.y + jogador->dim.y > MUNDO_HEIGHT ) {
+        jogador->pos.y = MUNDO_HEIGHT - jogador->dim.y;
+    }
+
+    // velocidade real (ja limitada pelas bordas), usada para o prefetch do mapa
+    if ( delta > 0 ) {
+        jogador->velocidade = Vector2Scale( Vector2Subtract( jogador->pos, posAnterior ), 1.0f / delta );
+    }
+
+}
+
+void IniciarJogador(Jogador *jogador, int i){
+    jogador->pos = (Vector2){ POSICAO_INICIAL_JOGADOR.x + i * 140, POSICAO_INICIAL_JOGADOR.y };
+    jogador->dim = (Vector2){ 120, 120 }; //tamanho do mergulhador
+    jogador->vel = 190; // velocidade do mergulhador
+    jogador->tipoLixo = NENHUM;
+    jogador->pontuacao = 0;
+    jogador->velocidade = (Vector2){ 0, 0 };
+    jogador->acumuladorBolhas = 0;
+    // Inicialização dos campos de animação
+    jogador->frameWidth = 100;
+    jogador->frameHeight = 100;
+    jogador->currentFrame = 0;
+    jogador->totalFrames = 4;
+    jogador->frameTimer = 0;
+    jogador->frameSpeed = 0.15f;
+    jogador->isMoving = false;
+    jogador->isFlipped = false;
+}
+
+void IniciarEquipe(void){
+    for (int j = 0; j < numJogadores; j++) {
+        IniciarJogador(&jogadores[j], j);
+        // o bot sempre usa o teclado; sem janela nao ha controles
+        if (!modoBot && !modoHeadless && IsGamepadAvailable(j)) {
+            entrada.controles[j] = EntradaControlesDoGamepad(j);
+        } else {
+            entrada.controles[j] = entrada.teclado[j];
+        }
+    }
+}
+
+int PontuacaoEquipe(void){
+    int total = 0;
+    for (int j = 0; j < numJogadores; j++) {
+        total += jogadores[j].pontuacao;
+    }
+    return total;
+}
+
+void AtualizarCameraEquipe(float delta){
+
+    // caixa com os centros dos mergulhadores e velocidade media (prefetch)
+    Vector2 minimo = { MUNDO_WIDTH, MUNDO_HEIGHT };
+    Vector2 maximo = { 0, 0 };
+    Vector2 velocidade = { 0, 0 };
+    for (int j = 0; j < numJogadores; j++) {
+        Vector2 centro = Vector2Add(jogadores[j].pos, Vector2Scale(jogadores[j].dim, 0.5f));
+        minimo = Vector2Min(minimo, centro);
+        maximo = Vector2Max(maximo, centro);
+        velocidade = Vector2Add(velocidade, Vector2Scale(jogadores[j].velocidade, 1.0f / numJogadores));
+    }
+
+    // zoom para caber todos com uma margem de um mergulhador, nunca
+    // aproximando alem de 1 nem afastando alem de 0.5
+    float zoomX = TELA_LARGURA / (maximo.x - minimo.x + 2 * jogadores[0].dim.x);
+    float zoomY = TELA_ALTURA / (maximo.y - minimo.y + 2 * jogadores[0].dim.y);
+    float zoom = Clamp(fminf(zoomX, zoomY), 0.5f, 1.0f);
+    camera.zoom += (zoom - camera.zoom) * (1.0f - expf(-4.0f * delta));
+
+    AtualizarCamera(&camera, Vector2Scale(Vector2Add(minimo, maximo), 0.5f), delta);
+    StreamingAtualizar(&fundoOceano, AreaVisivel(camera), velocidade);
+
+}
+
+void ResolverColetas(void){
+
+    // todos os lixos que cada jogador alcanca neste quadro
+    PedidoColeta pedidos[MAX_JOGADORES * 8];
+    int quantidade = 0;
+    for (int j = 0; j < numJogadores; j++) {
+        if (!(entradaRede[j] & REDE_PEGOU)) {
+            continue;
+        }
+        const Jogador *jogador = &jogadores[j];
+        Rectangle jogadorRec = { jogador->pos.x, jogador->pos.y, jogador->dim.x, jogador->dim.y };
+        Vector2 centro = Vector2Add(jogador->pos, Vector2Scale(jogador->dim, 0.5f));
+        int alcancados[8];
+        int n = ColisaoLoteIndices(jogadorRec, &loteLixo, alcancados, 8);
+        for (int k = 0; k < n; k++) {
+            Vector2 lixo = { itensLixo[alcancados[k]].pos.x + LIXO_WIDTH / 2.0f, itensLixo[alcancados[k]].pos.y + LIXO_HEIGHT / 2.0f };
+            pedidos[quantidade++] = (PedidoColeta){ j, alcancados[k], Vector2DistanceSqr(centro, lixo) };
+        }
+    }
+
+    // ordena por distancia (insercao: no maximo 32 pedidos); empates ficam
+    // na ordem dos jogadores, o que torna o resultado deterministico
+    for (int a = 1; a < quantidade; a++) {
+        PedidoColeta p = pedidos[a];
+        int b = a - 1;
+        while (b >= 0 && pedidos[b].distancia > p.distancia) {
+            pedidos[b + 1] = pedidos[b];
+            b--;
+        }
+        pedidos[b + 1] = p;
+    }
+
+    bool atendido[MAX_JOGADORES] = { false };
+    for (int k = 0; k < quantidade; k++) {
+        int j = pedidos[k].jogador;
+        int i = pedidos[k].lixo;
+        if (atendido[j] || !itensLixo[i].active) {
+            continue;
+        }
+        atendido[j] = true;
+        jogadores[j].tipoLixo = itensLixo[i].type;
+        LogEventosRegistrar(&logEventos, EVENTO_COLETA, j, itensLixo[i].type, 0, 0);
+        itensLixo[i].active = false;
+        GradeRemover(&gradeLixo, i);
+        LoteAABBDesativar(&loteLixo, i);
+    }
+
+}
+
+void AnimarJogador(Jogador *jogador, bool movendo, float delta){
+
+    // Lógica de animação do sprite do jogador
+    if (movendo) {
+        jogador->isMoving = true;
+        jogador->frameTimer += delta;
+        if (jogador->frameTimer >= jogador->frameSpeed) {
+            jogador->frameTimer = 0;
+            jogador->currentFrame++;
+            if (jogador->currentFrame >= jogador->totalFrames) {
+                jogador->currentFrame = 0; // Reinicia a animação
+            }
+        }
+    } else {
+        jogador->isMoving = false;
+        jogador->currentFrame = 0; // Volta para a primeira frame quando o jogador para
+    }
+
+    // bolhas saindo do capacete (mais bolhas quando o mergulhador nada)
+    jogador->acumuladorBolhas += delta * (jogador->isMoving ? 40.0f : 8.0f) * GovernadorNivel(&governador)->particulas;
+    int novasBolhas = (int)jogador->acumuladorBolhas;
+    jogador->acumuladorBolhas -= novasBolhas;
+    Vector2 capacete = {
+        jogador->pos.x + jogador->dim.x * (jogador->isFlipped ? 0.7f : 0.3f),
+        jogador->pos.y + jogador->dim.y * 0.25f
+    };
+    EmissorEmitir(&bolhas, capacete, novasBolhas, (Vector2){ 0, -40 }, 25, 10);
+
+}
+
+void AtualizarPeixes(float delta){
+    // em qualidade baixa o cardume anda so a cada alguns quadros, com o
+    // tempo acumulado
+    deltaPeixes += delta;
+    if (++quadrosPeixes < GovernadorNivel(&governador)->passoAnimacao) {
+        return;
+    }
+    delta = deltaPeixes;
+    deltaPeixes = 0;
+    quadrosPeixes = 0;
+
+    // peixes reagem ao lixo que esta no mapa agora
+    CardumeLimparPoluicao(&cardume);
+    for (int i = 0; i < numLixos; i++) {
+        if (itensLixo[i].active) {
+            CardumeAdicionarPoluicao(&cardume, itensLixo[i].pos, 1.0f);
+        }
+    }
+    CardumeAtualizar(&cardume, delta, AreaVisivel(camera), poolTarefas);
+}
+
+bool TeclaDosBots(int tecla, bool pressionada){
+    for (int j = 0; j < numJogadores; j++) {
+        if (pressionada ? BotTeclaPressionada(&bots[j], tecla) : BotTeclaSegurada(&bots[j], tecla)) {
+            return true;
+        }
+    }
+    return false;
+}
+
+uint8_t AcaoDoToque(const Jogador *jogador){
+    return jogador->tipoLixo == NENHUM ? REDE_PEGAR | REDE_PEGOU : REDE_DESCARTAR | REDE_DESCARTOU;
+}
+
+bool BotaoClicado(Rectangle botao){
+    if (papelRede == REDE_SERVIDOR) {
+        // comeca quando todos chegaram; o fim da partida fica na tela uns segundos
+        for (int j = 0; j < numJogadores; j++) {
+            if (!servidor.clientes[j].conectado) {
+                return false;
+            }
+        }
+        return servidor.tick >= servidor.tickLiberado;
+    }
+    if (modoBot) {
+        return true;
+    }
+    return entrada.atual.clicou && CheckCollisionPointRec(entrada.atual.ponteiro, botao);
+}
+
+void RegistrarSessao(void){
+    if (!modoBot && papelRede != REDE_SERVIDOR) {
+        return;
+    }
+    sessoesConcluidas++;
+    if (estadoJogo.atual == GAME_WIN) {
+        vitorias++;
+    }
+    printf("sessao %d: %s com %d pontos\n", sessoesConcluidas, estadoJogo.atual == GAME_WIN ? "vitoria" : "derrota", PontuacaoEquipe());
+}
+
+bool SalvarPartida(const char *arquivo){
+
+    double inicio = PlataformaTempo();
+    size_t tamanho = sizeof(Quicksave) + sizeof(QuicksaveLixo) * numLixos;
+    Quicksave *q = (Quicksave*)MemoriaAlocar(MEMORIA_JOGO, tamanho);
+    if (q == NULL) {
+        return false;
+    }
+    q->magica = QUICKSAVE_MAGICA;
+    q->versao = QUICKSAVE_VERSAO;
+    q->tamanho = sizeof(Quicksave);
+
+    // o estado interno do gerador da raylib nao e acessivel: a partir daqui
+    // os sorteios seguem uma semente nova, que vai no arquivo
+    q->sementeAleatoria = (uint32_t)GetRandomValue(0, 1 << 30);
+    SetRandomSeed(q->sementeAleatoria);
+
+    q->numJogadores = numJogadores;
+    q->numLixos = numLixos;
+    q->tempoRestante = tempoRestante;
+    q->camera = camera;
+    q->correntes = campoCorrente;
+    memcpy(q->jogadores, jogadores, sizeof(jogadores));
+    for (int i = 0; i < numLixos; i++) {
+        q->lixos[i] = (QuicksaveLixo){
+            derivaLixo.x[i], derivaLixo.y[i], derivaLixo.vx[i], derivaLixo.vy[i], derivaLixo.afundamento[i],
+            itensLixo[i].type, itensLixo[i].active
+        };
+    }
+    memcpy(q->peixeX, cardume.x, sizeof(q->peixeX));
+    memcpy(q->peixeY, cardume.y, sizeof(q->peixeY));
+    memcpy(q->peixeVx, cardume.vx, sizeof(q->peixeVx));
+    memcpy(q->peixeVy, cardume.vy, sizeof(q->peixeVy));
+
+    // temporario + rename: cair no meio da gravacao nao estraga o save
+    char temporario[512];
+    snprintf(temporario, sizeof(temporario), "%s.tmp", arquivo);
+    FILE *saida = fopen(temporario, "wb");
+    bool ok = saida != NULL && fwrite(q, tamanho, 1, saida) == 1 && PlataformaGravarNoDisco(saida);
+    if (saida != NULL) {
+        ok = fclose(saida) == 0 && ok;
+    }
+    ok = ok && PlataformaSubstituirArquivo(temporario, arquivo);
+    if (!ok) {
+        remove(temporario);
+    }
+    MemoriaLiberar(q);
+
+    mensagemHud = ok ? "Partida salva (F9 continua)" : "Nao foi possivel salvar a partida";
+    tempoMensagemHud = 2.0f;
+    TraceLog(ok ? LOG_INFO : LOG_WARNING, "QUICKSAVE: %s %s (%lu bytes, %.3f ms)", ok ? "gravado" : "falhou",
+             arquivo, (unsigned long)tamanho, (PlataformaTempo() - inicio) * 1000.0);
+    return ok;
+
+}
+
+bool CarregarPartida(const char *arquivo){
+
+    double inicio = PlataformaTempo();
+
+    // o arquivo inteiro em uma leitura; so substitui a partida se for valido
+    Quicksave *q = NULL;
+    long tamanho = 0;
+    FILE *entrada = fopen(arquivo, "rb");
+    if (entrada != NULL && fseek(entrada, 0, SEEK_END) == 0 && (tamanho = ftell(entrada)) >= (long)sizeof(Quicksave)) {
+        q = (Quicksave*)MemoriaAlocar(MEMORIA_JOGO, (size_t)tamanho);
+        rewind(entrada);
+    }
+    bool ok = q != NULL && fread(q, (size_t)tamanho, 1, entrada) == 1 &&
+              q->magica == QUICKSAVE_MAGICA && q->versao == QUICKSAVE_VERSAO && q->tamanho == sizeof(Quicksave) &&
+              q->numJogadores >= 1 && q->numJogadores <= MAX_JOGADORES && q->numLixos >= 1 &&
+              (size_t)tamanho == sizeof(Quicksave) + sizeof(QuicksaveLixo) * (size_t)q->numLixos;
+    if (entrada != NULL) {
+        fclose(entrada);
+    }
+    // os tipos indexam sprites e tabelas; em rede os clientes ja contam com
+    // os jogadores da sessao e o snapshot leva ate REDE_MAX_LIXOS lixos
+    for (int i = 0; ok && i < q->numLixos; i++) {
+        ok = (int)q->lixos[i].tipo >= PLASTICO && (int)q->lixos[i].tipo <= PAPEL;
+    }
+    for (int j = 0; ok && j < q->numJogadores; j++) {
+        ok = (int)q->jogadores[j].tipoLixo >= PLASTICO && (int)q->jogadores[j].tipoLixo <= NENHUM;
+    }
+    ok = ok && (papelRede == REDE_LOCAL || (q->numJogadores == numJogadores && q->numLixos <= REDE_MAX_LIXOS));
+    if (!ok) {
+        TraceLog(LOG_WARNING, "QUICKSAVE: %s nao existe, nao e desta versao do jogo ou esta corrompido", arquivo);
+        MemoriaLiberar(q);
+        return false;
+    }
+
+    if (q->numLixos != numLixos) {
+        CriarLixos(q->numLixos);
+    }
+    numJogadores = q->numJogadores;
+    IniciarEquipe(); // controles de cada jogador
+    memcpy(jogadores, q->jogadores, sizeof(jogadores));
+    tempoRestante = q->tempoRestante;
+    camera = q->camera;
+    campoCorrente = q->correntes;
+
+    // lixo: a fisica vem do arquivo, o resto e derivado dela
+    GradeLimpar(&gradeLixo);
+    for (int i = 0; i < numLixos; i++) {
+        const QuicksaveLixo *l = &q->lixos[i];
+        derivaLixo.x[i] = l->x;
+        derivaLixo.y[i] = l->y;
+        derivaLixo.vx[i] = l->vx;
+        derivaLixo.vy[i] = l->vy;
+        derivaLixo.afundamento[i] = l->afundamento;
+        itensLixo[i].type = l->tipo;
+        itensLixo[i].sprite = spritesLixo[l->tipo];
+        itensLixo[i].active = l->ativo;
+        itensLixo[i].pos = (Vector2){ l->x, l->y };
+        if (itensLixo[i].active) {
+            GradeInserir(&gradeLixo, i, itensLixo[i].pos);
+            LoteAABBDefinir(&loteLixo, i, (Rectangle){ itensLixo[i].pos.x, itensLixo[i].pos.y, LIXO_WIDTH, LIXO_HEIGHT });
+        } else {
+            LoteAABBDesativar(&loteLixo, i);
+        }
+    }
+
+    memcpy(cardume.x, q->peixeX, sizeof(q->peixeX));
+    memcpy(cardume.y, q->peixeY, sizeof(q->peixeY));
+    memcpy(cardume.vx, q->peixeVx, sizeof(q->peixeVx));
+    memcpy(cardume.vy, q->peixeVy, sizeof(q->peixeVy));
+
+    bolhas.quantidade = 0;
+    respingosAcerto.quantidade = 0;
+    respingosErro.quantidade = 0;
+    SetRandomSeed(q->sementeAleatoria);
+    MemoriaLiberar(q);
+    MudarEstado(RODANDO);
+
+    mensagemHud = "Partida restaurada";
+    tempoMensagemHud = 2.0f;
+    TraceLog(LOG_INFO, "QUICKSAVE: %s carregado em %.3f ms", arquivo, (PlataformaTempo() - inicio) * 1000.0);
+    return true;
+
+}
+
+void ConferirAlocacoes(int estadoNoInicio){
+
+    int porSubsistema[NUM_SUBSISTEMAS_MEMORIA];
+    bool emPartida = estadoNoInicio == RODANDO && estadoJogo.atual == RODANDO && !alocacaoPermitida;
+    int alocacoes = MemoriaFimDoQuadro(emPartida, porSubsistema);
+    alocacaoPermitida = false;
+    if (!emPartida || alocacoes == 0) {
+        return;
+    }
+
+    quadrosComAlocacao++;
+    if (quadrosComAlocacao <= AVISOS_ALOCACAO) {
+        char detalhe[256] = "";
+        size_t usado = 0;
+        for (int i = 0; i < NUM_SUBSISTEMAS_MEMORIA && usado < sizeof(detalhe); i++) {
+            if (porSubsistema[i] > 0) {
+                usado += snprintf(detalhe + usado, sizeof(detalhe) - usado, " %s=%d",
+                                  MemoriaNomeSubsistema((SubsistemaMemoria)i), porSubsistema[i]);
+            }
+        }
+        TraceLog(LOG_WARNING, "MEMORIA: %d alocacao(oes) em um quadro da partida:%s", alocacoes, detalhe);
+    }
+
+}
+
+void MudarEstado(int novo){
+    // sem isto, F9 na partida gravaria RODANDO -> RODANDO e as ferramentas
+    // contariam uma partida nova
+    if (novo == estadoJogo.atual) {
+        return;
+    }
+    LogEventosRegistrar(&logEventos, EVENTO_ESTADO, 0, estadoJogo.atual, novo, PontuacaoEquipe());
+    EstadosTrocar(&estadoJogo, novo);
+}
+
+void SairPartida( int proximo ){
+    // a gravacao das entradas termina com a primeira partida
+    if (gravandoEntradas) {
+        gravandoEntradas = false;
+        bool ok = GravacaoSalvar(&gravacao, arquivoGravacao);
+        TraceLog(ok ? LOG_INFO : LOG_WARNING, "ENTRADAS: %d passos de %d jogador(es) %s %s", gravacao.passos,
+                 gravacao.numJogadores, ok ? "gravados em" : "nao gravados em", arquivoGravacao);
+        GravacaoDestruir(&gravacao);
+    }
+}
+
+void RegistrarPlacar(void){
+    RegistroPlacar registros[MAX_JOGADORES];
+    for (int j = 0; j < numJogadores; j++) {
+        registros[j] = (RegistroPlacar){
+            jogadores[j].pontuacao, PontuacaoEquipe(), (uint32_t)time(NULL),
+            (uint8_t)j, (uint8_t)numJogadores, estadoJogo.atual == GAME_WIN, 0
+        };
+    }
+    if (!PlacarRegistrar(&placar, registros, numJogadores)) {
+        TraceLog(LOG_WARNING, "PLACAR: partida nao registrada");
+    }
+}
+
+void IniciarPartida(void){
+    MudarEstado(RODANDO);
+    IniciarEquipe();
+    if (arquivoGravacao != NULL && gravacao.passos == 0) {
+        GravacaoCriar(&gravacao, numJogadores);
+        gravandoEntradas = true;
+    }
+    // Spawn dos lixos espalhados pelo mapa
+    for (int i = 0; i < numLixos; i++) {
+        SpawnarLixo(i);
+    }
+    bolhas.quantidade = 0;
+    respingosAcerto.quantidade = 0;
+    respingosErro.quantidade = 0;
+    camera.zoom = 1.0f;
+    CentralizarCamera(&camera, Vector2Add(jogadores[0].pos, Vector2Scale(jogadores[0].dim, 0.5f)));
+}
+
+static void escreverResumoJson(FILE *json, const char *nome, ResumoTempos r){
+    fprintf(json, "\"%s\": { \"media\": %.4f, \"p50\": %.4f, \"p90\": %.4f, \"p99\": %.4f, \"max\": %.4f }",
+            nome, r.media, r.p50, r.p90, r.p99, r.maximo);
+}
+
+bool RodarBenchmark(const char *arquivoJson, const char *filtro, const char *arquivoEntradas){
+
+    GravacaoEntradas partida;
+    if (!GravacaoCarregar(&partida, arquivoEntradas)) {
+        printf("benchmark: %s nao existe ou nao e uma gravacao de entradas (--gravar-entradas)\n", arquivoEntradas);
+        return false;
+    }
+    FILE *json = fopen(arquivoJson, "w");
+    if (json == NULL) {
+        printf("benchmark: nao foi possivel criar %s\n", arquivoJson);
+        GravacaoDestruir(&partida);
+        return false;
+    }
+
+    fprintf(json, "{\n  \"versao\": 1,\n  \"janela\": %s,\n  \"nucleos\": %d,\n  \"passos_gravados\": %d,\n  \"cenarios\": [",
+            modoHeadless ? "false" : "true", PlataformaNucleos(), partida.passos);
+    printf("%-13s %7s %7s %9s %9s %9s %12s %10s %11s %9s\n", "cenario", "lixos", "quadros", "p50 (ms)", "p99 (ms)",
+           "max (ms)", "update (ms)", "draw (ms)", "heap (KiB)", "alocacoes");
+
+    int rodados = 0;
+    bool semAlocacao = true;
+    for (int c = 0; c < NUM_CENARIOS; c++) {
+        if (filtro == NULL || strcmp(filtro, CENARIOS[c].nome) == 0) {
+            semAlocacao = RodarCenario(&CENARIOS[c], &partida, json, rodados == 0) && semAlocacao;
+            rodados++;
+        }
+    }
+    fprintf(json, "\n  ]\n}\n");
+    bool ok = fclose(json) == 0 && semAlocacao;
+    if (!semAlocacao) {
+        printf("benchmark: a partida alocou memoria nos quadros medidos\n");
+    }
+
+    GravacaoDestruir(&partida);
+    if (rodados == 0) {
+        printf("benchmark: cenario %s nao existe\n", filtro);
+        return false;
+    }
+    return ok;
+
+}
+
+bool RodarCenario(const Cenario *cenario, const GravacaoEntradas *partida, FILE *json, bool primeiro){
+
+    // sempre o mesmo comeco: semente, lixos e mergulhadores
+    SetRandomSeed(SEMENTE_BENCHMARK);
+    CriarLixos(cenario->lixos);
+    tempoRestante = 180.0f;
+    MudarEstado(PARADO);
+    numJogadores = cenario->tipo == CENARIO_MENU ? 1 : cenario->tipo == CENARIO_TEMPESTADE ? MAX_JOGADORES : partida->numJogadores;
+    int partidas = 0;
+    if (cenario->tipo != CENARIO_MENU) {
+        IniciarPartida();
+        partidas++;
+    }
+    repetindoEntradas = true;
+    memset(entradaRede, 0, sizeof(entradaRede));
+
+    // na tempestade cada mergulhador fica parado sobre uma lixeira
+    if (cenario->tipo == CENARIO_TEMPESTADE) {
+        for (int j = 0; j < numJogadores; j++) {
+            Rectangle r = lixeiras[j % NUM_LIXEIRAS].rect;
+            jogadores[j].pos = (Vector2){ r.x + r.width / 2 - jogadores[j].dim.x / 2, r.y + r.height - jogadores[j].dim.y };
+        }
     }
 
-}
\ No newline at end of file
+    float *amostrasUpdate = (float*)MemoriaAlocar(MEMORIA_JOGO, sizeof(float) * cenario->quadros);
+    float *amostrasDraw = (float*)MemoriaAlocar(MEMORIA_JOGO, sizeof(float) * cenario->quadros);
+    float *amostrasQuadro = (float*)MemoriaAlocar(MEMORIA_JOGO, sizeof(float) * cenario->quadros);
+    size_t heapInicial = PlataformaMemoriaHeap();
+    size_t heapMaximo = heapInicial;
+    size_t memoriaInicial = PlataformaMemoriaResidente();
+    size_t memoriaMaxima = memoriaInicial;
+    int proximoLixo = 0;
+    long long alocacoes = 0;
+    int quadrosComAlocacaoCenario = 0;
+
+    for (int q = -QUADROS_AQUECIMENTO; q < cenario->quadros; q++) {
+
+        double inicio = PlataformaTempo();
+        ArenaResetar(&arenaQuadro);
+
+        // entradas e eventos do cenario contam como update
+        long long passo = q + QUADROS_AQUECIMENTO;
+        if (cenario->tipo == CENARIO_PARTIDA || cenario->tipo == CENARIO_RAJADAS) {
+            RepetirEntradas(partida, passo);
+        }
+        if (cenario->tipo == CENARIO_RAJADAS && passo % 30 == 0) {
+            int inicioRajada = (int)(passo / 30 % 2) * (numLixos / 2);
+            for (int i = 0; i < numLixos / 2; i++) {
+                SpawnarLixo(inicioRajada + i);
+            }
+        }
+        if (cenario->tipo == CENARIO_TEMPESTADE) {
+            // quadros pares: um lixo embaixo de cada um e todos pegam;
+            // impares: todos descartam
+            bool pegar = passo % 2 == 0;
+            for (int j = 0; j < numJogadores; j++) {
+                if (pegar) {
+                    Vector2 centro = Vector2Add(jogadores[j].pos, Vector2Scale(jogadores[j].dim, 0.5f));
+                    ColocarLixo(proximoLixo, centro, (TipoDoLixo)GetRandomValue(0, 3));
+                    proximoLixo = (proximoLixo + 1) % numLixos;
+                }
+                entradaRede[j] = pegar ? REDE_PEGAR | REDE_PEGOU : REDE_DESCARTAR | REDE_DESCARTOU;
+            }
+        }
+        update(1.0f / 60.0f);
+
+        // partida acabou: outra, com os mesmos lixos
+        bool reiniciou = cenario->tipo != CENARIO_MENU && estadoJogo.atual != RODANDO;
+        if (reiniciou) {
+            tempoRestante = 180.0f;
+            MudarEstado(PARADO);
+            IniciarPartida();
+            partidas++;
+        }
+
+        double meio = PlataformaTempo();
+        if (!modoHeadless) {
+            draw();
+        }
+        double fim = PlataformaTempo();
+
+        LogEventosFimDoQuadro(&logEventos, (float)((fim - inicio) * 1000.0));
+        bool emPartida = cenario->tipo != CENARIO_MENU && !reiniciou;
+        int alocacoesQuadro = MemoriaFimDoQuadro(emPartida && q >= 0, NULL);
+        if (q >= 0) {
+            alocacoes += alocacoesQuadro;
+            quadrosComAlocacaoCenario += emPartida && alocacoesQuadro > 0;
+            amostrasUpdate[q] = (float)((meio - inicio) * 1000.0);
+            amostrasDraw[q] = (float)((fim - meio) * 1000.0);
+            amostrasQuadro[q] = (float)((fim - inicio) * 1000.0);
+        }
+        // percorrer o heap custa caro: uma amostra por segundo, fora do tempo
+        if (passo % 60 == 0) {
+            size_t heap = PlataformaMemoriaHeap();
+            size_t memoria = PlataformaMemoriaResidente();
+            heapMaximo = heap > heapMaximo ? heap : heapMaximo;
+            memoriaMaxima = memoria > memoriaMaxima ? memoria : memoriaMaxima;
+        }
+
+    }
+
+    size_t heapFinal = PlataformaMemoriaHeap();
+    size_t memoriaFinal = PlataformaMemoriaResidente();
+    heapMaximo = heapFinal > heapMaximo ? heapFinal : heapMaximo;
+    memoriaMaxima = memoriaFinal > memoriaMaxima ? memoriaFinal : memoriaMaxima;
+    repetindoEntradas = false;
+
+    ResumoTempos update = MedidorResumir(amostrasUpdate, cenario->quadros);
+    ResumoTempos desenho = MedidorResumir(amostrasDraw, cenario->quadros);
+    ResumoTempos quadro = MedidorResumir(amostrasQuadro, cenario->quadros);
+    MemoriaLiberar(amostrasUpdate);
+    MemoriaLiberar(amostrasDraw);
+    MemoriaLiberar(amostrasQuadro);
+
+    fprintf(json, "%s\n    {\n      \"nome\": \"%s\",\n      \"lixos\": %d,\n      \"jogadores\": %d,\n"
+                  "      \"quadros\": %d,\n      \"partidas\": %d,\n      ",
+            primeiro ? "" : ",", cenario->nome, numLixos, numJogadores, cenario->quadros, partidas);
+    escreverResumoJson(json, "quadro_ms", quadro);
+    fprintf(json, ",\n      ");
+    escreverResumoJson(json, "update_ms", update);
+    fprintf(json, ",\n      ");
+    if (modoHeadless) {
+        fprintf(json, "\"draw_ms\": null");
+    } else {
+        escreverResumoJson(json, "draw_ms", desenho);
+    }
+    fprintf(json, ",\n      \"heap_kb\": { \"inicio\": %lu, \"fim\": %lu, \"max\": %lu },\n"
+                  "      \"memoria_kb\": { \"inicio\": %lu, \"fim\": %lu, \"max\": %lu },\n"
+                  "      \"alocacoes\": %lld,\n      \"quadros_com_alocacao\": %d\n    }",
+            (unsigned long)(heapInicial / 1024), (unsigned long)(heapFinal / 1024), (unsigned long)(heapMaximo / 1024),
+            (unsigned long)(memoriaInicial / 1024), (unsigned long)(memoriaFinal / 1024), (unsigned long)(memoriaMaxima / 1024),
+            alocacoes, quadrosComAlocacaoCenario);
+    fflush(json);
+
+    printf("%-13s %7d %7d %9.3f %9.3f %9.3f %12.3f %10.3f %+11ld %9lld\n", cenario->nome, numLixos, cenario->quadros,
+           quadro.p50, quadro.p99, quadro.maximo, update.media, desenho.media,
+           (long)heapFinal / 1024 - (long)heapInicial / 1024, alocacoes);
+    return quadrosComAlocacaoCenario == 0;
+
+}
+
+void RepetirEntradas(const GravacaoEntradas *gravacao, long long passo){
+    const uint8_t *entradas = GravacaoPasso(gravacao, passo);
+    for (int j = 0; j < numJogadores; j++) {
+        entradaRede[j] = j < gravacao->numJogadores ? entradas[j] : 0;
+    }
+}
+
+bool PrepararTela(int i, const GravacaoEntradas *partida, const char *snapshot){
+
+    const TelaRender *tela = &TELAS_RENDER[i];
+    SetRandomSeed(SEMENTE_BENCHMARK);
+    CriarLixos(tela->lixos);
+    tempoRestante = 180.0f;
+    tempoMensagemHud = 0;
+    MudarEstado(PARADO);
+    numJogadores = partida->numJogadores;
+    if (tela->tipo == TELA_MENU) {
+        return true;
+    }
+
+    if (snapshot == NULL || !FileExists(snapshot)) {
+        // alguns segundos de partida: mergulhadores espalhados, bolhas e lixo
+        // a deriva
+        IniciarPartida();
+        repetindoEntradas = true;
+        for (int passo = 0; passo < PASSOS_TELA; passo++) {
+            RepetirEntradas(partida, passo);
+            update(1.0f / 60.0f);
+        }
+        repetindoEntradas = false;
+        if (snapshot != NULL && !SalvarPartida(snapshot)) {
+            return false;
+        }
+    }
+    // a tela sai sempre do snapshot carregado (sem bolhas nem respingos),
+    // tambem na execucao que o grava
+    if (snapshot != NULL && !CarregarPartida(snapshot)) {
+        return false;
+    }
+    tempoMensagemHud = 0;
+
+    if (tela->tipo == TELA_PARTIDA && estadoJogo.atual != RODANDO) {
+        MudarEstado(RODANDO);
+    } else if (tela->tipo == TELA_VITORIA) {
+        MudarEstado(GAME_WIN);
+    } else if (tela->tipo == TELA_DERROTA) {
+        MudarEstado(GAME_LOSE);
+    }
+    if (!StreamingAguardar(&fundoOceano, AreaVisivel(camera), 5.0)) {
+        TraceLog(LOG_WARNING, "STREAMING: tela %s desenhada com chunks faltando", tela->nome);
+    }
+    return true;
+
+}
+
+Image MedirTela(RenderTexture2D alvo, int quadros, float *amostras, double *msQuadro){
+
+    // o primeiro quadro sobe texturas e compila shaders: fica de fora
+    ArenaResetar(&arenaQuadro);
+    BeginTextureMode(alvo);
+    ClearBackground(WHITE);
+    DesenharTela();
+    EndTextureMode();
+    Image imagem = LoadImageFromTexture(alvo.texture);
+    UnloadImage(imagem);
+
+    // EndTextureMode so entrega o lote ao driver; o tempo com a GPU sai
+    // da leitura da imagem, que espera todos os quadros terminarem
+    double inicio = PlataformaTempo();
+    for (int q = 0; q < quadros; q++) {
+        double t0 = PlataformaTempo();
+        ArenaResetar(&arenaQuadro);
+        BeginTextureMode(alvo);
+        ClearBackground(WHITE);
+        DesenharTela();
+        EndTextureMode();
+        amostras[q] = (float)((PlataformaTempo() - t0) * 1000.0);
+    }
+    imagem = LoadImageFromTexture(alvo.texture);
+    *msQuadro = (PlataformaTempo() - inicio) * 1000.0 / quadros;
+
+    // a RenderTexture e de baixo para cima
+    ImageFlipVertical(&imagem);
+    return imagem;
+
+}
+
+bool RodarRender(const char *arquivoJson, int quadros, const char *pastaPng, const char *arquivoEntradas){
+
+    GravacaoEntradas partida;
+    if (!GravacaoCarregar(&partida, arquivoEntradas)) {
+        printf("render: %s nao existe ou nao e uma gravacao de entradas (--gravar-entradas)\n", arquivoEntradas);
+        return false;
+    }
+    FILE *json = fopen(arquivoJson, "w");
+    if (json == NULL) {
+        printf("render: nao foi possivel criar %s\n", arquivoJson);
+        GravacaoDestruir(&partida);
+        return false;
+    }
+    if (pastaPng != NULL) {
+        MakeDirectory(pastaPng);
+    }
+
+    // as telas desenham na tela virtual, sem escala
+    RenderTexture2D alvo = LoadRenderTexture(TELA_LARGURA, TELA_ALTURA);
+    float *amostras = (float*)MemoriaAlocar(MEMORIA_JOGO, sizeof(float) * quadros);
+    bool ok = alvo.id != 0;
+
+    fprintf(json, "{\n  \"versao\": 1,\n  \"largura\": %d,\n  \"altura\": %d,\n  \"quadros\": %d,\n  \"software\": %s,\n  \"telas\": [",
+            alvo.texture.width, alvo.texture.height, quadros, getenv("LIBGL_ALWAYS_SOFTWARE") != NULL ? "true" : "false");
+    printf("%-11s %12s %12s %12s %14s\n", "tela", "cpu p50 (ms)", "cpu p99 (ms)", "cpu max (ms)", "com GPU (ms)");
+
+    for (int i = 0; i < NUM_TELAS_RENDER && ok; i++) {
+
+        PrepararTela(i, &partida, NULL);
+        double total;
+        Image imagem = MedirTela(alvo, quadros, amostras, &total);
+
+        char png[512];
+        snprintf(png, sizeof(png), "%s/%s.png", pastaPng != NULL ? pastaPng : ".", TELAS_RENDER[i].nome);
+        if (pastaPng != NULL && !ExportImage(imagem, png)) {
+            printf("render: nao foi possivel gravar %s\n", png);
+            ok = false;
+        }
+        UnloadImage(imagem);
+
+        ResumoTempos cpu = MedidorResumir(amostras, quadros);
+        fprintf(json, "%s\n    { \"nome\": \"%s\", \"lixos\": %d, ", i == 0 ? "" : ",", TELAS_RENDER[i].nome, numLixos);
+        escreverResumoJson(json, "cpu_ms", cpu);
+        fprintf(json, ", \"quadro_ms\": %.4f }", total);
+        printf("%-11s %12.3f %12.3f %12.3f %14.3f\n", TELAS_RENDER[i].nome, cpu.p50, cpu.p99, cpu.maximo, total);
+
+    }
+    fprintf(json, "\n  ]\n}\n");
+    ok = fclose(json) == 0 && ok;
+
+    MemoriaLiberar(amostras);
+    UnloadRenderTexture(alvo);
+    GravacaoDestruir(&partida);
+    return ok;
+
+}
+
+bool RodarGolden(const char *pasta, int quadros, const char *pastaSaida, float tolerancia, bool atualizar,
+                 const char *arquivoEntradas){
+
+    GravacaoEntradas partida;
+    if (!GravacaoCarregar(&partida, arquivoEntradas)) {
+        printf("golden: %s nao existe ou nao e uma gravacao de entradas (--gravar-entradas)\n", arquivoEntradas);
+        return false;
+    }
+    char snapshot[512];
+    snprintf(snapshot, sizeof(snapshot), "%s/%s", pasta, ARQUIVO_SNAPSHOT_GOLDEN);
+    // sem as referencias a comparacao passaria sem comparar nada: gravar e
+    // sempre pedido
+    if (!atualizar && !FileExists(snapshot)) {
+        printf("golden: %s nao existe; grave as referencias com --atualizar-golden\n", snapshot);
+        GravacaoDestruir(&partida);
+        return false;
+    }
+    if (atualizar) {
+        MakeDirectory(pasta);
+    }
+    if (pastaSaida != NULL) {
+        MakeDirectory(pastaSaida);
+    }
+
+    RenderTexture2D alvo = LoadRenderTexture(TELA_LARGURA, TELA_ALTURA);
+    float *amostras = (float*)MemoriaAlocar(MEMORIA_JOGO, sizeof(float) * quadros);
+    uint8_t *mapa = (uint8_t*)MemoriaAlocar(MEMORIA_JOGO, (size_t)TELA_LARGURA * TELA_ALTURA * 4);
+    bool ok = alvo.id != 0;
+    int diferentes = 0;
+    int faltando = 0;
+
+    printf("%-9s %12s %11s %-10s %12s %14s\n", "tela", "pixels (%)", "maior delta", "resultado", "cpu p50 (ms)", "com GPU (ms)");
+    for (int i = 0; i < NUM_TELAS_RENDER && ok; i++) {
+
+        const TelaRender *tela = &TELAS_RENDER[i];
+        if (!tela->golden) {
+            continue;
+        }
+        if (!PrepararTela(i, &partida, snapshot)) {
+            printf("golden: %s nao e um quicksave desta versao do jogo; apague para gravar outro "
+                   "(e refaca as referencias com --atualizar-golden)\n", snapshot);
+            ok = false;
+            break;
+        }
+        double total;
+        Image imagem = MedirTela(alvo, quadros, amostras, &total);
+        ImageFormat(&imagem, PIXELFORMAT_UNCOMPRESSED_R8G8B8A8);
+        ResumoTempos cpu = MedidorResumir(amostras, quadros);
+
+        char referencia[512];
+        snprintf(referencia, sizeof(referencia), "%s/%s.png", pasta, tela->nome);
+        ResultadoComparacao comparacao = { 0 };
+        const char *resultado;
+        if (atualizar) {
+            ok = ExportImage(imagem, referencia);
+            resultado = ok ? "gravada" : "ERRO";
+        } else if (!FileExists(referencia)) {
+            faltando++;
+            resultado = "FALTANDO";
+        } else {
+            Image esperada = LoadImage(referencia);
+            ImageFormat(&esperada, PIXELFORMAT_UNCOMPRESSED_R8G8B8A8);
+            if (esperada.data == NULL || esperada.width != imagem.width || esperada.height != imagem.height) {
+                comparacao.fracao = 1;
+                resultado = "TAMANHO";
+            } else {
+                comparacao = CompararImagens((const uint8_t*)esperada.data, (const uint8_t*)imagem.data,
+                                             imagem.width, imagem.height, COMPARACAO_LIMIAR_PADRAO, mapa);
+                resultado = comparacao.fracao <= tolerancia ? "ok" : "DIFERENTE";
+            }
+            if (comparacao.fracao > tolerancia) {
+                diferentes++;
+                if (pastaSaida != NULL) {
+                    char png[512];
+                    snprintf(png, sizeof(png), "%s/%s.png", pastaSaida, tela->nome);
+                    ExportImage(imagem, png);
+                    if (comparacao.diferentes > 0) {
+                        Image diferenca = { mapa, imagem.width, imagem.height, 1, PIXELFORMAT_UNCOMPRESSED_R8G8B8A8 };
+                        snprintf(png, sizeof(png), "%s/%s_diferenca.png", pastaSaida, tela->nome);
+                        ExportImage(diferenca, png);
+                    }
+                }
+            }
+            UnloadImage(esperada);
+        }
+        UnloadImage(imagem);
+
+        printf("%-9s %12.3f %11.3f %-10s %12.3f %14.3f\n", tela->nome, comparacao.fracao * 100.0f,
+               comparacao.maiorDelta, resultado, cpu.p50, total);
+
+    }
+    if (faltando > 0) {
+        printf("golden: %d referencia(s) faltando em %s; grave com --atualizar-golden\n", faltando, pasta);
+    }
+    if (diferentes > 0) {
+        printf("golden: %d tela(s) passaram de %.3f%% de pixels diferentes%s%s\n", diferentes, tolerancia * 100.0f,
+               pastaSaida != NULL ? "; imagens e diferencas em " : "", pastaSaida != NULL ? pastaSaida : "");
+    }
+
+    MemoriaLiberar(mapa);
+    MemoriaLiberar(amostras);
+    UnloadRenderTexture(alvo);
+    GravacaoDestruir(&partida);
+    return ok && diferentes == 0 && faltando == 0;
+
+}
+
+void ServidorTick(void){
+
+    ServidorReceber();
+
+    // uma entrada de cada cliente por tick; sem entrada nova, o jogador
+    // continua segurando as mesmas teclas
+    for (int j = 0; j < numJogadores; j++) {
+        ClienteRemoto *c = &servidor.clientes[j];
+
+        // fila longa (cliente adiantado ou rajada de pacotes) vira latencia:
+        // descarta as mais velhas, mas sem perder apertos
+        while (c->tamanhoFila > 4) {
+            uint8_t velha = c->fila[c->inicioFila];
+            c->inicioFila = (c->inicioFila + 1) % REDE_HISTORICO;
+            c->tamanhoFila--;
+            c->ultimaAplicada++;
+            c->fila[c->inicioFila] |= velha & (REDE_PEGOU | REDE_DESCARTOU);
+        }
+
+        if (c->tamanhoFila > 0) {
+            c->entrada = c->fila[c->inicioFila];
+            c->inicioFila = (c->inicioFila + 1) % REDE_HISTORICO;
+            c->tamanhoFila--;
+            c->ultimaAplicada++;
+        } else {
+            c->entrada &= ~(REDE_PEGOU | REDE_DESCARTOU);
+            if (c->conectado && estadoJogo.atual == RODANDO) {
+                c->ticksSemEntrada++;
+            }
+        }
+        entradaRede[j] = c->entrada;
+    }
+
+    int estadoAnterior = estadoJogo.atual;
+    update(1.0f / 60.0f);
+    if (estadoAnterior == RODANDO && estadoJogo.atual != RODANDO) {
+        servidor.tickLiberado = servidor.tick + 3 * taxaRede;
+    }
+    servidor.tick++;
+
+    SnapshotRede *snapshot = &servidor.historico[servidor.tick % REDE_HISTORICO];
+    MontarSnapshot(snapshot);
+    snapshot->jogo.tick = servidor.tick;
+
+    // delta contra o ultimo snapshot que cada cliente confirmou, se ainda
+    // estiver no historico
+    uint8_t pacote[REDE_TAMANHO_PACOTE];
+    for (int j = 0; j < numJogadores; j++) {
+        ClienteRemoto *c = &servidor.clientes[j];
+        if (!c->conectado) {
+            continue;
+        }
+        const SnapshotRede *base = &servidor.historico[c->ackSnapshot % REDE_HISTORICO];
+        if (c->ackSnapshot == 0 || base->jogo.tick != c->ackSnapshot || servidor.tick - c->ackSnapshot >= REDE_HISTORICO) {
+            base = NULL;
+        }
+        snapshot->jogo.ultimaEntrada = c->ultimaAplicada;
+        int tamanho = RedeEscreverSnapshot(pacote, snapshot, base);
+        RedeEnviar(socketRede, c->endereco, pacote, tamanho);
+        c->bytesEnviados += tamanho;
+    }
+
+}
+
+void ServidorReceber(void){
+
+    uint8_t pacote[REDE_TAMANHO_PACOTE];
+    RedeEndereco origem;
+    int tamanho;
+    double agora = PlataformaTempo();
+
+    while ((tamanho = RedeReceber(socketRede, pacote, sizeof(pacote), &origem)) > 0) {
+
+        int j = 0;
+        while (j < numJogadores && !(servidor.clientes[j].conectado && RedeMesmoEndereco(servidor.clientes[j].endereco, origem))) {
+            j++;
+        }
+
+        if (pacote[0] == PACOTE_CONECTAR) {
+            // cliente novo fica com a primeira vaga; repetido so recebe a
+            // resposta de novo (a anterior pode ter se perdido)
+            if (j == numJogadores) {
+                j = 0;
+                while (j < numJogadores && servidor.clientes[j].conectado) {
+                    j++;
+                }
+                if (j == numJogadores) {
+                    continue;
+                }
+                servidor.clientes[j] = (ClienteRemoto){ .conectado = true, .endereco = origem };
+                printf("rede: jogador %d conectado\n", j + 1);
+            }
+            uint8_t resposta[8];
+            int n = RedeEscreverBoasVindas(resposta, j, numJogadores, taxaRede);
+            RedeEnviar(socketRede, origem, resposta, n);
+            servidor.clientes[j].bytesEnviados += n;
+        }
+        if (j == numJogadores) {
+            continue; // nao conectado
+        }
+
+        ClienteRemoto *c = &servidor.clientes[j];
+        c->bytesRecebidos += tamanho;
+        c->ultimoPacote = agora;
+
+        uint32_t sequencia;
+        uint32_t ack;
+        uint8_t entradas[REDE_ENTRADAS_POR_PACOTE];
+        int quantidade;
+        if (!RedeLerEntrada(pacote, tamanho, &sequencia, entradas, &quantidade, &ack) || quantidade == 0) {
+            continue;
+        }
+        if (ack > c->ackSnapshot && ack <= servidor.tick) {
+            c->ackSnapshot = ack;
+        }
+
+        // enfileira as entradas que ainda nao chegaram; um buraco maior que
+        // a redundancia do pacote e preenchido com a entrada mais velha
+        uint32_t proxima = c->ultimaAplicada + (uint32_t)c->tamanhoFila + 1;
+        if (sequencia >= proxima + REDE_HISTORICO) {
+            proxima = sequencia - REDE_ENTRADAS_POR_PACOTE + 1; // muito atrasado: recomeca
+            c->ultimaAplicada = proxima - 1;
+            c->tamanhoFila = 0;
+        }
+        for (uint32_t seq = proxima; seq <= sequencia && c->tamanhoFila < REDE_HISTORICO; seq++) {
+            uint32_t idade = sequencia - seq;
+            uint8_t e = idade < (uint32_t)quantidade ? entradas[idade] : (uint8_t)(entradas[quantidade - 1] & ~(REDE_PEGOU | REDE_DESCARTOU));
+            c->fila[(c->inicioFila + c->tamanhoFila) % REDE_HISTORICO] = e;
+            c->tamanhoFila++;
+        }
+
+    }
+
+    // sem noticias ha 10 s: libera a vaga
+    for (int j = 0; j < numJogadores; j++) {
+        if (servidor.clientes[j].conectado && agora - servidor.clientes[j].ultimoPacote > 10.0 && servidor.clientes[j].ultimoPacote > 0) {
+            servidor.clientes[j].conectado = false;
+            printf("rede: jogador %d desconectado\n", j + 1);
+        }
+    }
+
+}
+
+void MontarSnapshot(SnapshotRede *snapshot){
+    snapshot->jogo.estado = estadoJogo.atual;
+    snapshot->jogo.tempoRestante = tempoRestante;
+    snapshot->jogo.numJogadores = numJogadores;
+    for (int j = 0; j < numJogadores; j++) {
+        const Jogador *jogador = &jogadores[j];
+        snapshot->jogo.jogadores[j] = (SnapshotJogador){
+            jogador->pos.x, jogador->pos.y, jogador->pontuacao, (int)jogador->tipoLixo,
+            jogador->currentFrame, jogador->isFlipped, jogador->isMoving
+        };
+    }
+    snapshot->jogo.numLixeiras = NUM_LIXEIRAS;
+    for (int i = 0; i < NUM_LIXEIRAS; i++) {
+        Rectangle r = lixeiras[i].rect;
+        snapshot->jogo.lixeiras[i] = (SnapshotLixeira){ r.x, r.y, r.width, r.height, (int)lixeiras[i].type };
+    }
+    snapshot->jogo.numLixos = numLixos;
+    for (int i = 0; i < numLixos; i++) {
+        snapshot->lixos[i] = (SnapshotLixo){ itensLixo[i].pos.x, itensLixo[i].pos.y, (int)itensLixo[i].type, itensLixo[i].active };
+    }
+}
+
+void AtualizarCliente(float delta){
+
+    const float passo = 1.0f / 60.0f;
+    double agora = PlataformaTempo();
+    uint8_t pacote[REDE_TAMANHO_PACOTE];
+
+    ClienteReceber();
+
+    if (cliente.jogadorLocal < 0) {
+        // ainda sem resposta do servidor: tenta de novo a cada 250 ms
+        if (agora - cliente.ultimaTentativa > 0.25) {
+            pacote[0] = PACOTE_CONECTAR;
+            RedeEnviar(socketRede, cliente.servidor, pacote, 1);
+            cliente.bytesEnviados++;
+            cliente.ultimaTentativa = agora;
+        }
+        if (agora - cliente.inicio > 10.0) {
+            printf("rede: o servidor nao respondeu\n");
+            cliente.encerrado = true;
+        }
+        return;
+    }
+    if (agora - cliente.ultimoPacote > 5.0) {
+        printf("rede: conexao perdida\n");
+        cliente.encerrado = true;
+        return;
+    }
+
+    Jogador *local = &jogadores[cliente.jogadorLocal];
+    if (modoBot && estadoJogo.atual == RODANDO) {
+        VisaoBot visao = {
+            (Rectangle){ local->pos.x, local->pos.y, local->dim.x, local->dim.y },
+            local->tipoLixo == NENHUM ? -1 : (int)local->tipoLixo,
+            &loteLixo, &loteLixeiras, &navegacao, caminhoLixeira
+        };
+        BotPensar(&bots[0], &visao, delta);
+    }
+    EntradaLer(&entrada, 1);
+    entrada.atual.ponteiro = TelaVirtualPonto(&tela, entrada.atual.ponteiro);
+    uint8_t teclas = entrada.atual.jogadores[0];
+    if (entrada.atual.tocou) {
+        teclas |= AcaoDoToque(local);
+    }
+    cliente.apertos |= teclas & (REDE_PEGOU | REDE_DESCARTOU);
+
+    // previsao: o mesmo AtualizarJogador do servidor, com o mesmo passo
+    cliente.acumulador += delta;
+    while (cliente.acumulador >= passo) {
+        cliente.acumulador -= passo;
+        cliente.sequencia++;
+        uint8_t e = (uint8_t)((teclas & ~(REDE_PEGOU | REDE_DESCARTOU)) | cliente.apertos);
+        cliente.apertos = 0;
+        cliente.entradas[cliente.sequencia % REDE_HISTORICO] = e;
+        cliente.envio[cliente.sequencia % REDE_HISTORICO] = agora;
+        if (estadoJogo.atual == RODANDO) {
+            entradaRede[cliente.jogadorLocal] = e;
+            AtualizarJogador(local, e, passo);
+        }
+
+        uint8_t ultimas[REDE_ENTRADAS_POR_PACOTE];
+        int quantidade = 0;
+        while (quantidade < REDE_ENTRADAS_POR_PACOTE && (uint32_t)quantidade < cliente.sequencia) {
+            ultimas[quantidade] = cliente.entradas[(cliente.sequencia - quantidade) % REDE_HISTORICO];
+            quantidade++;
+        }
+        int tamanho = RedeEscreverEntrada(pacote, cliente.sequencia, ultimas, quantidade, cliente.ultimoTick);
+        RedeEnviar(socketRede, cliente.servidor, pacote, tamanho);
+        cliente.bytesEnviados += tamanho;
+    }
+
+    // o resto e so visual: animacao, bolhas, peixes e camera no mergulhador local
+    if (estadoJogo.atual == RODANDO) {
+        for (int j = 0; j < numJogadores; j++) {
+            bool movendo = j == cliente.jogadorLocal ? (teclas & REDE_MOVIMENTO) != 0 : jogadores[j].isMoving;
+            AnimarJogador(&jogadores[j], movendo, delta);
+        }
+        EmissorAtualizar(&bolhas, delta);
+        EmissorAtualizar(&respingosAcerto, delta);
+        EmissorAtualizar(&respingosErro, delta);
+        AtualizarPeixes(delta);
+        camera.zoom = 1.0f;
+        AtualizarCamera(&camera, Vector2Add(local->pos, Vector2Scale(local->dim, 0.5f)), delta);
+        StreamingAtualizar(&fundoOceano, AreaVisivel(camera), local->velocidade);
+    }
+
+}
+
+void ClienteReceber(void){
+
+    uint8_t pacote[REDE_TAMANHO_PACOTE];
+    RedeEndereco origem;
+    int tamanho;
+
+    while ((tamanho = RedeReceber(socketRede, pacote, sizeof(pacote), &origem)) > 0) {
+
+        if (!RedeMesmoEndereco(origem, cliente.servidor)) {
+            continue;
+        }
+        cliente.bytesRecebidos += tamanho;
+        cliente.ultimoPacote = PlataformaTempo();
+
+        if (pacote[0] == PACOTE_FIM) {
+            cliente.encerrado = true;
+        } else if (pacote[0] == PACOTE_BOAS_VINDAS && cliente.jogadorLocal < 0) {
+            // os globais so mudam com um pacote valido: numJogadores limita
+            // os lacos sobre jogadores[] e taxaRede divide o passo
+            int jogador, jogadoresPartida, taxa;
+            if (RedeLerBoasVindas(pacote, tamanho, &jogador, &jogadoresPartida, &taxa)) {
+                cliente.jogadorLocal = jogador;
+                numJogadores = jogadoresPartida;
+                taxaRede = taxa;
+                printf("rede: conectado como jogador %d de %d\n", cliente.jogadorLocal + 1, numJogadores);
+            }
+        } else if (pacote[0] == PACOTE_SNAPSHOT && cliente.jogadorLocal >= 0) {
+            // sem a base no historico nao da para decodificar: o proximo
+            // pacote vem contra um snapshot mais novo que confirmamos
+            uint32_t tickBase = RedeBaseSnapshot(pacote, tamanho);
+            const SnapshotRede *base = NULL;
+            if (tickBase != 0) {
+                base = &cliente.recebidos[tickBase % REDE_HISTORICO];
+                if (base->jogo.tick != tickBase) {
+                    continue;
+                }
+            }
+            SnapshotRede snapshot;
+            // sem o mergulhador local o snapshot nao serve: a previsao dele
+            // pararia de ser corrigida e a entrada seguiria sendo enviada
+            if (!RedeLerSnapshot(pacote, tamanho, base, &snapshot) || snapshot.jogo.tick <= cliente.ultimoTick ||
+                snapshot.jogo.numJogadores <= cliente.jogadorLocal) {
+                continue; // invalido, repetido ou fora de ordem
+            }
+            if (cliente.ultimoTick != 0) {
+                cliente.snapshotsPerdidos += (int)(snapshot.jogo.tick - cliente.ultimoTick - 1);
+            }
+            cliente.snapshots++;
+            cliente.ultimoTick = snapshot.jogo.tick;
+            cliente.recebidos[snapshot.jogo.tick % REDE_HISTORICO] = snapshot;
+            AplicarSnapshot(&snapshot);
+        }
+
+    }
+
+}
+
+void AplicarSnapshot(const SnapshotRede *snapshot){
+
+    int estadoAnterior = estadoJogo.atual;
+    if (snapshot->jogo.estado != estadoAnterior) {
+        MudarEstado(snapshot->jogo.estado);
+    }
+    tempoRestante = snapshot->jogo.tempoRestante;
+    numJogadores = snapshot->jogo.numJogadores;
+
+    for (int j = 0; j < numJogadores; j++) {
+        Jogador *jogador = &jogadores[j];
+        const SnapshotJogador *e = &snapshot->jogo.jogadores[j];
+
+        // descarte feito no servidor: som e respingos na lixeira em que o
+        // mergulhador esta encostado
+        if (estadoJogo.atual == RODANDO && e->pontuacao != jogador->pontuacao && estadoAnterior == RODANDO) {
+            Rectangle jogadorRec = { e->x, e->y, jogador->dim.x, jogador->dim.y };
+            int i;
+            if (ColisaoLoteIndices(jogadorRec, &loteLixeiras, &i, 1) == 1) {
+                Vector2 bocaLixeira = { lixeiras[i].rect.x + lixeiras[i].rect.width / 2, lixeiras[i].rect.y + 10 };
+                int respingos = (int)(120 * GovernadorNivel(&governador)->particulas);
+                bool acerto = e->pontuacao > jogador->pontuacao;
+                PlaySound(acerto ? somDescarteCerto : somDescarteErrado);
+                EmissorEmitir(acerto ? &respingosAcerto : &respingosErro, bocaLixeira, respingos, (Vector2){ 0, -60 }, 160, 8);
+            }
+        }
+        jogador->pontuacao = e->pontuacao;
+        jogador->tipoLixo = (TipoDoLixo)e->tipoLixo;
+
+        if (j != cliente.jogadorLocal) {
+            jogador->pos = (Vector2){ e->x, e->y };
+            jogador->currentFrame = e->quadro;
+            jogador->isFlipped = e->virado;
+            jogador->isMoving = e->movendo;
+            continue;
+        }
+
+        // reconciliacao: parte da posicao do servidor e reaplica as entradas
+        // que ele ainda nao tinha processado
+        Vector2 previsto = jogador->pos;
+        jogador->pos = (Vector2){ e->x, e->y };
+        if (estadoJogo.atual == RODANDO) {
+            uint32_t primeira = snapshot->jogo.ultimaEntrada + 1;
+            if (cliente.sequencia - snapshot->jogo.ultimaEntrada >= REDE_HISTORICO) {
+                primeira = cliente.sequencia - REDE_HISTORICO + 1;
+            }
+            for (uint32_t seq = primeira; seq <= cliente.sequencia; seq++) {
+                entradaRede[j] = cliente.entradas[seq % REDE_HISTORICO];
+                AtualizarJogador(jogador, entradaRede[j], 1.0f / 60.0f);
+            }
+            if (estadoAnterior == RODANDO) {
+                cliente.somaCorrecao += Vector2Distance(previsto, jogador->pos);
+                cliente.correcoes++;
+            }
+        }
+
+        // latencia: do envio da entrada ate o snapshot que ja a inclui
+        if (snapshot->jogo.ultimaEntrada > cliente.ultimaConfirmada && cliente.sequencia - snapshot->jogo.ultimaEntrada < REDE_HISTORICO) {
+            cliente.ultimaConfirmada = snapshot->jogo.ultimaEntrada;
+            if (cliente.quantidadeLatencias < (int)(sizeof(cliente.latencias) / sizeof(cliente.latencias[0]))) {
+                cliente.latencias[cliente.quantidadeLatencias++] = (float)((PlataformaTempo() - cliente.envio[snapshot->jogo.ultimaEntrada % REDE_HISTORICO]) * 1000.0);
+            }
+        }
+    }
+
+    // lixeiras: o servidor manda de novo so se mudarem
+    for (int i = 0; i < snapshot->jogo.numLixeiras && i < NUM_LIXEIRAS; i++) {
+        const SnapshotLixeira *e = &snapshot->jogo.lixeiras[i];
+        lixeiras[i].rect = (Rectangle){ e->x, e->y, e->largura, e->altura };
+        LoteAABBDefinir(&loteLixeiras, i, lixeiras[i].rect);
+    }
+
+    // lixos: grade e lote de colisao acompanham o servidor (o bot usa)
+    for (int i = 0; i < snapshot->jogo.numLixos && i < numLixos; i++) {
+        const SnapshotLixo *e = &snapshot->lixos[i];
+        if (e->ativo) {
+            itensLixo[i].active = true;
+            itensLixo[i].type = (TipoDoLixo)e->tipo;
+            itensLixo[i].sprite = spritesLixo[e->tipo];
+            itensLixo[i].pos = (Vector2){ e->x, e->y };
+            GradeInserir(&gradeLixo, i, itensLixo[i].pos);
+            LoteAABBDefinir(&loteLixo, i, (Rectangle){ e->x, e->y, LIXO_WIDTH, LIXO_HEIGHT });
+        } else if (itensLixo[i].active) {
+            itensLixo[i].active = false;
+            GradeRemover(&gradeLixo, i);
+            LoteAABBDesativar(&loteLixo, i);
+        }
+    }
+
+    if (estadoAnterior == RODANDO && estadoJogo.atual != RODANDO) {
+        RegistrarSessao();
+    }
+    if (estadoAnterior != RODANDO && estadoJogo.atual == RODANDO) {
+        bolhas.quantidade = 0;
+        respingosAcerto.quantidade = 0;
+        respingosErro.quantidade = 0;
+        CentralizarCamera(&camera, Vector2Add(jogadores[cliente.jogadorLocal].pos, Vector2Scale(jogadores[cliente.jogadorLocal].dim, 0.5f)));
+    }
+
+}
+
+static int compararLatencias(const void *a, const void *b){
+    float x = *(const float*)a;
+    float y = *(const float*)b;
+    return (x > y) - (x < y);
+}
+
+void RelatorioRede(void){
+
+    if (papelRede == REDE_SERVIDOR) {
+        double segundos = servidor.tick > 0 ? (double)servidor.tick / taxaRede : 1.0;
+        printf("rede: %u ticks a %d/s\n", (unsigned)servidor.tick, taxaRede);
+        for (int j = 0; j < numJogadores; j++) {
+            const ClienteRemoto *c = &servidor.clientes[j];
+            printf("rede: jogador %d: enviados %.1f KiB (%.1f kbit/s), recebidos %.1f KiB (%.1f kbit/s), ticks sem entrada %d\n",
+                   j + 1, c->bytesEnviados / 1024.0, c->bytesEnviados * 8 / 1000.0 / segundos,
+                   c->bytesRecebidos / 1024.0, c->bytesRecebidos * 8 / 1000.0 / segundos, c->ticksSemEntrada);
+        }
+        return;
+    }
+
+    double segundos = PlataformaTempo() - cliente.inicio;
+    printf("rede: enviados %.1f KiB (%.1f kbit/s), recebidos %.1f KiB (%.1f kbit/s)\n",
+           cliente.bytesEnviados / 1024.0, cliente.bytesEnviados * 8 / 1000.0 / segundos,
+           cliente.bytesRecebidos / 1024.0, cliente.bytesRecebidos * 8 / 1000.0 / segundos);
+    printf("rede: snapshots %d (perdidos %d), %.1f bytes por snapshot\n", cliente.snapshots, cliente.snapshotsPerdidos,
+           cliente.snapshots > 0 ? (double)cliente.bytesRecebidos / cliente.snapshots : 0.0);
+    if (cliente.quantidadeLatencias > 0) {
+        int n = cliente.quantidadeLatencias;
+        double soma = 0;
+        for (int k = 0; k < n; k++) {
+            soma += cliente.latencias[k];
+        }
+        qsort(cliente.latencias, n, sizeof(float), compararLatencias);
+        printf("rede: entrada ate o snapshot (ms): media %.2f, p50 %.2f, p99 %.2f, max %.2f\n",
+               soma / n, cliente.latencias[n / 2], cliente.latencias[(int)(n * 0.99)], cliente.latencias[n - 1]);
+    }
+    printf("rede: correcao media da previsao %.3f px em %d snapshots\n",
+           cliente.correcoes > 0 ? cliente.somaCorrecao / cliente.correcoes : 0.0, cliente.correcoes);
+
+}
+
+void SpawnarLixo(int i){
+    // sorteia de novo se cair dentro de uma rocha
+    Vector2 pos = { 0, 0 };
+    for (int tentativa = 0; tentativa < 16; tentativa++) {
+        pos.x = GetRandomValue(30, MUNDO_WIDTH - 30 - LIXO_WIDTH);
+        pos.y = GetRandomValue(60, MUNDO_HEIGHT - 150);
+        if (!NavRetanguloNaRocha(&navegacao, (Rectangle){ pos.x, pos.y, LIXO_WIDTH, LIXO_HEIGHT })) {
+            break;
+        }
+    }
+
+    ColocarLixo(i, pos, (TipoDoLixo)GetRandomValue(0, 3));
+}
+
+void ColocarLixo(int i, Vector2 pos, TipoDoLixo tipo){
+    itensLixo[i].active = true;
+    itensLixo[i].pos = pos;
+    itensLixo[i].type = tipo;
+    itensLixo[i].sprite = spritesLixo[tipo];
+
+    GradeInserir(&gradeLixo, i, pos);
+    LoteAABBDefinir(&loteLixo, i, (Rectangle){ pos.x, pos.y, LIXO_WIDTH, LIXO_HEIGHT });
+    DerivaDefinir(&derivaLixo, i, pos, TAXA_AFUNDAMENTO[tipo]);
+}
+
+void LimparLixos(void){
+    for (int i = 0; i < numLixos; i++) {
+        itensLixo[i].active = false;
+        LoteAABBDesativar(&loteLixo, i);
+    }
+    GradeLimpar(&gradeLixo);
+}
+
+void CriarLixos(int quantidade){
+    if (itensLixo != NULL) {
+        DestruirLixos();
+    }
+    numLixos = quantidade;
+    itensLixo = (Lixo*)MemoriaZerada(MEMORIA_JOGO, quantidade, sizeof(Lixo));
+    ArenaReservar(&arenaQuadro, ARENA_QUADRO_BASE + sizeof(int) * quantidade);
+    GradeCriar(&gradeLixo, quantidade);
+    LoteAABBCriar(&loteLixo, quantidade);
+    DerivaCriar(&derivaLixo, quantidade, MUNDO_WIDTH - LIXO_WIDTH, MUNDO_HEIGHT - 40 - LIXO_HEIGHT);
+    LimparLixos();
+}
+
+void DestruirLixos(void){
+    GradeDestruir(&gradeLixo);
+    LoteAABBDestruir(&loteLixo);
+    DerivaDestruir(&derivaLixo);
+    MemoriaLiberar(itensLixo);
+    itensLixo = NULL;
+}
+
+void CarregarRecursos(void){
+    // Load all game resources here
+    background = LoadTexture( "resources/images/fundo.jpg" );
+    fire = LoadTexture( "resources/images/fire.png" );
+    legenda = LoadTexture( "resources/images/legenda.png" );
+    placaLegenda = LoadTexture( "resources/images/placa_legenda.png" );
+    madeira = LoadTexture( "resources/images/madeira.png" );
+    start = LoadTexture( "resources/images/start_button.png" );
+    tituloFont = LoadFont("resources/font/Asimovian-Regular.ttf");
+    papelLixo = LoadTexture("resources/images/paperGarbage.png");
+    vidroLixo = LoadTexture("resources/images/glassGarbage.png");
+    plasticoLixo = LoadTexture("resources/images/plasticGarbage.png");
+    metalLixo = LoadTexture("resources/images/metalGarbage.png");
+    spriteMergulhador = LoadTexture("resources/images/player_spritesheet.png");
+    lixeiraPlastico = LoadTexture("resources/images/lixeira_plastico.png");
+    lixeiraVidro = LoadTexture("resources/images/lixeira_vidro.png");
+    lixeiraMetal = LoadTexture("resources/images/lixeira_metal.png");
+    lixeiraPapel = LoadTexture("resources/images/lixeira_papel.png");
+    frame = LoadTexture("resources/images/frame.png");
+    hand = LoadTexture("resources/images/hand.png");
+    StreamingCarregar(&fundoOceano, "resources/mapa/oceano.txt", MUNDO_WIDTH, MUNDO_HEIGHT);
+
+    Image imagemBolha = GenImageGradientRadial(32, 32, 0.3f, WHITE, BLANK);
+    texturaBolha = LoadTextureFromImage(imagemBolha);
+    UnloadImage(imagemBolha);
+
+    // peixinho virado para a direita (angulo 0 = nadando para +x)
+    Image imagemPeixe = GenImageColor(24, 12, BLANK);
+    ImageDrawTriangle(&imagemPeixe, (Vector2){ 0, 1 }, (Vector2){ 0, 11 }, (Vector2){ 8, 6 }, (Color){ 255, 170, 60, 255 });
+    ImageDrawCircle(&imagemPeixe, 15, 6, 5, (Color){ 255, 190, 80, 255 });
+    ImageDrawCircle(&imagemPeixe, 11, 6, 4, (Color){ 255, 190, 80, 255 });
+    ImageDrawPixel(&imagemPeixe, 18, 5, BLACK);
+    spritePeixe = LoadTextureFromImage(imagemPeixe);
+    UnloadImage(imagemPeixe);
+
+    musica = LoadMusicStream("resources/sounds/fundo.wav");
+    somDescarteCerto = LoadSound("resources/sounds/acerto.mp3");
+    somDescarteErrado = LoadSound("resources/sounds/erro.wav");
+    // configura o volume da musica de fundo
+    SetMusicVolume(musica, 0.2f);
+
+    // Inicia a reprodução da música de fundo
+    PlayMusicStream(musica);
+}
+
+void DescarregarRecursos(void){
+    UnloadTexture(background);
+    UnloadFont(tituloFont);
+    UnloadTexture(fire);
+    UnloadTexture(legenda);
+    UnloadTexture(placaLegenda);
+    UnloadTexture(madeira);
+    UnloadTexture(start);
+    UnloadTexture(papelLixo);
+    UnloadTexture(vidroLixo);
+    UnloadTexture(plasticoLixo);
+    UnloadTexture(metalLixo);
+    UnloadTexture(lixeiraPlastico);
+    UnloadTexture(lixeiraVidro);
+    UnloadTexture(lixeiraMetal);
+    UnloadTexture(lixeiraPapel);
+    UnloadTexture(frame);
+    UnloadTexture(hand);
+    UnloadTexture(spritePeixe);
+    UnloadTexture(texturaBolha);
+    StreamingDescarregar(&fundoOceano);
+
+    UnloadMusicStream(musica);
+    UnloadSound(somDescarteCerto);
+    UnloadSound(somDescarteErrado);
+
+    //Liberação da textura do mergulhador
+    UnloadTexture(spriteMergulhador);
+}
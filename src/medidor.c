@@ -0,0 +1,120 @@
+/**
+ * @file medidor.c
+ * @brief Janelas de tempo de quadro com percentis e memória residente.
+ * @copyright Copyright (c) 2025
+ */
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "medidor.h"
+#include "plataforma.h"
+
+static int compararFloat( const void *a, const void *b ) {
+    float fa = *(const float*)a;
+    float fb = *(const float*)b;
+    return ( fa > fb ) - ( fa < fb );
+}
+
+static void fecharJanela( MedidorQuadros *medidor ) {
+
+    if ( medidor->quantidade == 0 ) {
+        return;
+    }
+
+    int n = medidor->quantidade;
+    ResumoTempos resumo = MedidorResumir( medidor->amostras, n );
+
+    size_t memoria = PlataformaMemoriaResidente();
+    if ( memoria > medidor->memoriaMaxima ) {
+        medidor->memoriaMaxima = memoria;
+    }
+
+    fprintf( medidor->saida, "%.1f,%d,%.3f,%.3f,%.3f,%.3f,%lu\n",
+             PlataformaTempo() - medidor->inicio, n, resumo.media,
+             resumo.p50, resumo.p99, resumo.maximo, (unsigned long)( memoria / 1024 ) );
+    fflush( medidor->saida );
+
+    medidor->quantidade = 0;
+    medidor->inicioJanela = PlataformaTempo();
+
+}
+
+bool MedidorCriar( MedidorQuadros *medidor, const char *arquivo, double intervalo ) {
+
+    medidor->saida = arquivo != NULL ? fopen( arquivo, "w" ) : stdout;
+    if ( medidor->saida == NULL ) {
+        return false;
+    }
+
+    medidor->quantidade = 0;
+    medidor->intervalo = intervalo;
+    medidor->inicio = PlataformaTempo();
+    medidor->inicioJanela = medidor->inicio;
+    medidor->quadros = 0;
+    medidor->somaMs = 0;
+    medidor->maximoMs = 0;
+    medidor->memoriaInicial = PlataformaMemoriaResidente();
+    medidor->memoriaMaxima = medidor->memoriaInicial;
+
+    fprintf( medidor->saida, "tempo_s,quadros,ms_medio,ms_p50,ms_p99,ms_max,memoria_kb\n" );
+    return true;
+
+}
+
+void MedidorDestruir( MedidorQuadros *medidor ) {
+
+    fecharJanela( medidor );
+
+    size_t memoriaFinal = PlataformaMemoriaResidente();
+    printf( "quadros: %lld, ms medio: %.3f, ms maximo: %.3f\n",
+            medidor->quadros, medidor->quadros > 0 ? medidor->somaMs / medidor->quadros : 0.0,
+            medidor->maximoMs );
+    printf( "memoria (KiB): inicial %lu, maxima %lu, final %lu\n",
+            (unsigned long)( medidor->memoriaInicial / 1024 ), (unsigned long)( medidor->memoriaMaxima / 1024 ),
+            (unsigned long)( memoriaFinal / 1024 ) );
+
+    if ( medidor->saida != stdout ) {
+        fclose( medidor->saida );
+    }
+    medidor->saida = NULL;
+
+}
+
+void MedidorRegistrar( MedidorQuadros *medidor, float ms ) {
+
+    medidor->amostras[medidor->quantidade++] = ms;
+    medidor->quadros++;
+    medidor->somaMs += ms;
+    if ( ms > medidor->maximoMs ) {
+        medidor->maximoMs = ms;
+    }
+
+    if ( medidor->quantidade == MEDIDOR_AMOSTRAS ||
+         PlataformaTempo() - medidor->inicioJanela >= medidor->intervalo ) {
+        fecharJanela( medidor );
+    }
+
+}
+
+ResumoTempos MedidorResumir( float *amostras, int quantidade ) {
+
+    ResumoTempos resumo = { 0, 0, 0, 0, 0 };
+    if ( quantidade == 0 ) {
+        return resumo;
+    }
+
+    double soma = 0;
+    for ( int i = 0; i < quantidade; i++ ) {
+        soma += amostras[i];
+    }
+    qsort( amostras, quantidade, sizeof(float), compararFloat );
+
+    resumo.media = (float)( soma / quantidade );
+    resumo.p50 = amostras[quantidade / 2];
+    resumo.p90 = amostras[(int)( quantidade * 0.90f )];
+    resumo.p99 = amostras[(int)( quantidade * 0.99f )];
+    resumo.maximo = amostras[quantidade - 1];
+    return resumo;
+
+}
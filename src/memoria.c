@@ -0,0 +1,222 @@
+/**
+ * @file memoria.c
+ * @brief Contadores do alocador e, com MEMORIA_CONTAR_RAYLIB, os wrappers de
+ * malloc/free usados pelo ligador.
+ * @copyright Copyright (c) 2025
+ */
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "memoria.h"
+
+#if defined(MEMORIA_CONTAR_RAYLIB)
+// com --wrap, malloc aqui dentro seria contado de novo como da raylib
+void *__real_malloc( size_t tamanho );
+void *__real_calloc( size_t quantidade, size_t tamanho );
+void *__real_realloc( void *bloco, size_t tamanho );
+void __real_free( void *bloco );
+#define ALOCAR_REAL __real_malloc
+#define REALOCAR_REAL __real_realloc
+#define LIBERAR_REAL __real_free
+#else
+#define ALOCAR_REAL malloc
+#define REALOCAR_REAL realloc
+#define LIBERAR_REAL free
+#endif
+
+// totais atualizados por várias threads
+#define SOMAR( variavel, valor ) __atomic_fetch_add( &( variavel ), ( valor ), __ATOMIC_RELAXED )
+#define LER( variavel ) __atomic_load_n( &( variavel ), __ATOMIC_RELAXED )
+
+// antes de cada bloco: tamanho e dono; 16 bytes mantêm o alinhamento do malloc
+typedef union Cabecalho {
+    struct {
+        size_t tamanho;
+        int subsistema;
+    } info;
+    double alinhamento[2];
+} Cabecalho;
+
+static const char *NOMES[NUM_SUBSISTEMAS_MEMORIA] = {
+    [MEMORIA_JOGO]       = "jogo",
+    [MEMORIA_MUNDO]      = "mundo",
+    [MEMORIA_COLISAO]    = "colisao",
+    [MEMORIA_CORRENTES]  = "correntes",
+    [MEMORIA_PARTICULAS] = "particulas",
+    [MEMORIA_CARDUME]    = "cardume",
+    [MEMORIA_NAVEGACAO]  = "navegacao",
+    [MEMORIA_STREAMING]  = "streaming",
+    [MEMORIA_REDE]       = "rede",
+    [MEMORIA_EVENTOS]    = "eventos",
+    [MEMORIA_PLACAR]     = "placar",
+    [MEMORIA_GRAVACAO]   = "gravacao",
+    [MEMORIA_TAREFAS]    = "tarefas",
+    [MEMORIA_PLATAFORMA] = "plataforma",
+    [MEMORIA_ARENA]      = "arena",
+    [MEMORIA_RAYLIB]     = "raylib"
+};
+
+static EstatisticaMemoria estatisticas[NUM_SUBSISTEMAS_MEMORIA];
+
+// quadro atual: só a thread principal escreve
+static __thread bool threadPrincipal;
+static int alocacoesQuadro[NUM_SUBSISTEMAS_MEMORIA];
+
+static void contarAlocacao( int subsistema, long long bytes ) {
+
+    EstatisticaMemoria *e = &estatisticas[subsistema];
+    SOMAR( e->alocacoes, 1 );
+    long long vivos = SOMAR( e->bytesVivos, bytes ) + bytes;
+    long long pico = LER( e->picoBytes );
+    while ( vivos > pico &&
+            !__atomic_compare_exchange_n( &e->picoBytes, &pico, vivos, true, __ATOMIC_RELAXED, __ATOMIC_RELAXED ) ) {
+    }
+
+    if ( threadPrincipal ) {
+        alocacoesQuadro[subsistema]++;
+    }
+
+}
+
+static void contarLiberacao( int subsistema, long long bytes ) {
+    SOMAR( estatisticas[subsistema].liberacoes, 1 );
+    SOMAR( estatisticas[subsistema].bytesVivos, -bytes );
+}
+
+static void *embrulhar( Cabecalho *cabecalho, SubsistemaMemoria subsistema, size_t tamanho ) {
+    cabecalho->info.tamanho = tamanho;
+    cabecalho->info.subsistema = (int)subsistema;
+    contarAlocacao( subsistema, (long long)tamanho );
+    return cabecalho + 1;
+}
+
+void *MemoriaAlocar( SubsistemaMemoria subsistema, size_t tamanho ) {
+    Cabecalho *cabecalho = (Cabecalho*)ALOCAR_REAL( sizeof(Cabecalho) + tamanho );
+    return cabecalho != NULL ? embrulhar( cabecalho, subsistema, tamanho ) : NULL;
+}
+
+void *MemoriaZerada( SubsistemaMemoria subsistema, size_t quantidade, size_t tamanho ) {
+
+    if ( tamanho != 0 && quantidade > ( SIZE_MAX - sizeof(Cabecalho) ) / tamanho ) {
+        return NULL;
+    }
+
+    size_t total = quantidade * tamanho;
+    void *bloco = MemoriaAlocar( subsistema, total );
+    if ( bloco != NULL ) {
+        memset( bloco, 0, total );
+    }
+    return bloco;
+
+}
+
+void *MemoriaRealocar( SubsistemaMemoria subsistema, void *bloco, size_t tamanho ) {
+
+    if ( bloco == NULL ) {
+        return MemoriaAlocar( subsistema, tamanho );
+    }
+
+    // conta como liberar o bloco antigo e alocar o novo
+    Cabecalho *antigo = (Cabecalho*)bloco - 1;
+    size_t tamanhoAntigo = antigo->info.tamanho;
+    int dono = antigo->info.subsistema;
+    Cabecalho *novo = (Cabecalho*)REALOCAR_REAL( antigo, sizeof(Cabecalho) + tamanho );
+    if ( novo == NULL ) {
+        return NULL;
+    }
+    contarLiberacao( dono, (long long)tamanhoAntigo );
+    return embrulhar( novo, subsistema, tamanho );
+
+}
+
+void MemoriaLiberar( void *bloco ) {
+    if ( bloco != NULL ) {
+        Cabecalho *cabecalho = (Cabecalho*)bloco - 1;
+        contarLiberacao( cabecalho->info.subsistema, (long long)cabecalho->info.tamanho );
+        LIBERAR_REAL( cabecalho );
+    }
+}
+
+void MemoriaThreadPrincipal( void ) {
+    threadPrincipal = true;
+}
+
+int MemoriaFimDoQuadro( bool emPartida, int *porSubsistema ) {
+
+    int total = 0;
+    for ( int i = 0; i < NUM_SUBSISTEMAS_MEMORIA; i++ ) {
+        total += alocacoesQuadro[i];
+        if ( emPartida ) {
+            SOMAR( estatisticas[i].alocacoesEmPartida, alocacoesQuadro[i] );
+        }
+        if ( porSubsistema != NULL ) {
+            porSubsistema[i] = alocacoesQuadro[i];
+        }
+        alocacoesQuadro[i] = 0;
+    }
+    return total;
+
+}
+
+EstatisticaMemoria MemoriaEstatistica( SubsistemaMemoria subsistema ) {
+    const EstatisticaMemoria *e = &estatisticas[subsistema];
+    EstatisticaMemoria copia = {
+        LER( e->alocacoes ), LER( e->liberacoes ), LER( e->bytesVivos ), LER( e->picoBytes ), LER( e->alocacoesEmPartida )
+    };
+    return copia;
+}
+
+const char *MemoriaNomeSubsistema( SubsistemaMemoria subsistema ) {
+    return NOMES[subsistema];
+}
+
+void MemoriaRelatorio( FILE *saida ) {
+
+    fprintf( saida, "%-11s %10s %10s %11s %10s %11s\n", "memoria", "alocacoes", "liberacoes",
+             "vivos (KiB)", "pico (KiB)", "em partida" );
+    for ( int i = 0; i < NUM_SUBSISTEMAS_MEMORIA; i++ ) {
+        EstatisticaMemoria e = MemoriaEstatistica( (SubsistemaMemoria)i );
+        if ( e.alocacoes == 0 && e.liberacoes == 0 ) {
+            continue;
+        }
+        if ( i == MEMORIA_RAYLIB ) {
+            // pelo wrapper só se sabe o número de chamadas
+            fprintf( saida, "%-11s %10lld %10lld %11s %10s %11lld\n", NOMES[i], e.alocacoes, e.liberacoes,
+                     "-", "-", e.alocacoesEmPartida );
+        } else {
+            fprintf( saida, "%-11s %10lld %10lld %11.1f %10.1f %11lld\n", NOMES[i], e.alocacoes, e.liberacoes,
+                     e.bytesVivos / 1024.0, e.picoBytes / 1024.0, e.alocacoesEmPartida );
+        }
+    }
+
+}
+
+#if defined(MEMORIA_CONTAR_RAYLIB)
+
+void *__wrap_malloc( size_t tamanho ) {
+    contarAlocacao( MEMORIA_RAYLIB, 0 );
+    return __real_malloc( tamanho );
+}
+
+void *__wrap_calloc( size_t quantidade, size_t tamanho ) {
+    contarAlocacao( MEMORIA_RAYLIB, 0 );
+    return __real_calloc( quantidade, tamanho );
+}
+
+void *__wrap_realloc( void *bloco, size_t tamanho ) {
+    if ( bloco != NULL ) {
+        contarLiberacao( MEMORIA_RAYLIB, 0 );
+    }
+    contarAlocacao( MEMORIA_RAYLIB, 0 );
+    return __real_realloc( bloco, tamanho );
+}
+
+void __wrap_free( void *bloco ) {
+    if ( bloco != NULL ) {
+        contarLiberacao( MEMORIA_RAYLIB, 0 );
+    }
+    __real_free( bloco );
+}
+
+#endif
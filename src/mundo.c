@@ -0,0 +1,151 @@
+/**
+ * @file mundo.c
+ * @brief Câmera do mapa e grade espacial para o culling dos itens.
+ * @copyright Copyright (c) 2025
+ */
+#include <stdlib.h>
+#include <math.h>
+
+#include "raylib/raylib.h"
+#include "raylib/raymath.h"
+
+#include "mundo.h"
+#include "memoria.h"
+
+// quão rápido a câmera alcança o mergulhador (maior = mais rígida)
+#define CAMERA_SUAVIZACAO 8.0f
+
+static int celulaDaPosicao( Vector2 pos ) {
+    int cx = (int)floorf( pos.x / GRADE_CELULA );
+    int cy = (int)floorf( pos.y / GRADE_CELULA );
+    if ( cx < 0 || cy < 0 || cx >= GRADE_COLUNAS || cy >= GRADE_LINHAS ) {
+        return -1;
+    }
+    return cy * GRADE_COLUNAS + cx;
+}
+
+void GradeCriar( GradeEspacial *grade, int capacidade ) {
+    grade->capacidade = capacidade;
+    grade->proximo = (int*)MemoriaAlocar( MEMORIA_MUNDO, sizeof(int) * capacidade );
+    grade->celula = (int*)MemoriaAlocar( MEMORIA_MUNDO, sizeof(int) * capacidade );
+    GradeLimpar( grade );
+}
+
+void GradeDestruir( GradeEspacial *grade ) {
+    MemoriaLiberar( grade->proximo );
+    MemoriaLiberar( grade->celula );
+    grade->proximo = NULL;
+    grade->celula = NULL;
+    grade->capacidade = 0;
+}
+
+void GradeLimpar( GradeEspacial *grade ) {
+    for ( int i = 0; i < GRADE_COLUNAS * GRADE_LINHAS; i++ ) {
+        grade->cabeca[i] = -1;
+    }
+    for ( int i = 0; i < grade->capacidade; i++ ) {
+        grade->proximo[i] = -1;
+        grade->celula[i] = -1;
+    }
+}
+
+void GradeRemover( GradeEspacial *grade, int indice ) {
+
+    int c = grade->celula[indice];
+    if ( c < 0 ) {
+        return;
+    }
+
+    // as listas são curtas, então basta procurar o anterior
+    int *elo = &grade->cabeca[c];
+    while ( *elo != -1 && *elo != indice ) {
+        elo = &grade->proximo[*elo];
+    }
+    if ( *elo == indice ) {
+        *elo = grade->proximo[indice];
+    }
+
+    grade->proximo[indice] = -1;
+    grade->celula[indice] = -1;
+
+}
+
+void GradeInserir( GradeEspacial *grade, int indice, Vector2 pos ) {
+
+    int c = celulaDaPosicao( pos );
+    if ( c == grade->celula[indice] ) {
+        return;
+    }
+
+    GradeRemover( grade, indice );
+    if ( c < 0 ) {
+        return;
+    }
+
+    grade->proximo[indice] = grade->cabeca[c];
+    grade->cabeca[c] = indice;
+    grade->celula[indice] = c;
+
+}
+
+int GradeConsultar( const GradeEspacial *grade, Rectangle area, int *resultado, int maxResultado ) {
+
+    // um item pode começar na célula à esquerda/acima e invadir a área,
+    // por isso a busca começa uma célula antes
+    int cx0 = (int)floorf( area.x / GRADE_CELULA ) - 1;
+    int cy0 = (int)floorf( area.y / GRADE_CELULA ) - 1;
+    int cx1 = (int)floorf( ( area.x + area.width ) / GRADE_CELULA );
+    int cy1 = (int)floorf( ( area.y + area.height ) / GRADE_CELULA );
+
+    if ( cx0 < 0 ) cx0 = 0;
+    if ( cy0 < 0 ) cy0 = 0;
+    if ( cx1 >= GRADE_COLUNAS ) cx1 = GRADE_COLUNAS - 1;
+    if ( cy1 >= GRADE_LINHAS ) cy1 = GRADE_LINHAS - 1;
+
+    int n = 0;
+    for ( int cy = cy0; cy <= cy1; cy++ ) {
+        for ( int cx = cx0; cx <= cx1; cx++ ) {
+            for ( int i = grade->cabeca[cy * GRADE_COLUNAS + cx]; i != -1; i = grade->proximo[i] ) {
+                if ( n == maxResultado ) {
+                    return n;
+                }
+                resultado[n++] = i;
+            }
+        }
+    }
+
+    return n;
+
+}
+
+static Vector2 limitarAlvo( Camera2D camera, Vector2 alvo ) {
+
+    float meiaLargura = camera.offset.x / camera.zoom;
+    float meiaAltura = camera.offset.y / camera.zoom;
+
+    alvo.x = Clamp( alvo.x, meiaLargura, MUNDO_WIDTH - meiaLargura );
+    alvo.y = Clamp( alvo.y, meiaAltura, MUNDO_HEIGHT - meiaAltura );
+
+    return alvo;
+
+}
+
+void AtualizarCamera( Camera2D *camera, Vector2 alvo, float delta ) {
+    camera->offset = (Vector2){ TELA_LARGURA / 2.0f, TELA_ALTURA / 2.0f };
+    float t = 1.0f - expf( -CAMERA_SUAVIZACAO * delta );
+    camera->target = limitarAlvo( *camera, Vector2Lerp( camera->target, alvo, t ) );
+}
+
+void CentralizarCamera( Camera2D *camera, Vector2 alvo ) {
+    camera->offset = (Vector2){ TELA_LARGURA / 2.0f, TELA_ALTURA / 2.0f };
+    camera->target = limitarAlvo( *camera, alvo );
+}
+
+Rectangle AreaVisivel( Camera2D camera ) {
+    return (Rectangle){
+        camera.target.x - camera.offset.x / camera.zoom,
+        camera.target.y - camera.offset.y / camera.zoom,
+        TELA_LARGURA / camera.zoom,
+        TELA_ALTURA / camera.zoom
+    };
+}
@@ -0,0 +1,567 @@
+/**
+ * @file navegacao.c
+ * @brief Grade de rochas, Dijkstra com heap binário a partir do objetivo e
+ * atualização incremental dos campos de fluxo.
+ * @copyright Copyright (c) 2025
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+
+#include "raylib/raylib.h"
+
+#include "navegacao.h"
+#include "memoria.h"
+
+static const int VIZINHO_X[8] = { 1, -1, 0, 0, 1, 1, -1, -1 };
+static const int VIZINHO_Y[8] = { 0, 0, 1, -1, 1, -1, 1, -1 };
+
+/*---------------------------------------------
+ * Grade.
+ *-------------------------------------------*/
+static bool dentro( const NavGrade *nav, int cx, int cy ) {
+    return cx >= 0 && cy >= 0 && cx < nav->colunas && cy < nav->linhas;
+}
+
+static void registrarAlteracao( NavGrade *nav, int c ) {
+    if ( nav->quantidadeAlteradas == nav->capacidadeAlteradas ) {
+        nav->capacidadeAlteradas = nav->capacidadeAlteradas * 2 + 64;
+        nav->alteradas = (int*)MemoriaRealocar( MEMORIA_NAVEGACAO, nav->alteradas, sizeof(int) * nav->capacidadeAlteradas );
+    }
+    nav->alteradas[nav->quantidadeAlteradas++] = c;
+}
+
+/**
+ * @brief Refaz bloqueada na vizinhança (folga) de (cx, cy).
+ */
+static void inflarAoRedor( NavGrade *nav, int cx, int cy, bool registrar ) {
+
+    for ( int y = cy - nav->folga; y <= cy + nav->folga; y++ ) {
+        for ( int x = cx - nav->folga; x <= cx + nav->folga; x++ ) {
+
+            if ( !dentro( nav, x, y ) ) {
+                continue;
+            }
+
+            unsigned char bloqueada = 0;
+            for ( int ry = y - nav->folga; ry <= y + nav->folga && !bloqueada; ry++ ) {
+                for ( int rx = x - nav->folga; rx <= x + nav->folga && !bloqueada; rx++ ) {
+                    bloqueada = dentro( nav, rx, ry ) && nav->rocha[ry * nav->colunas + rx];
+                }
+            }
+
+            int c = y * nav->colunas + x;
+            if ( nav->bloqueada[c] != bloqueada ) {
+                nav->bloqueada[c] = bloqueada;
+                if ( registrar ) {
+                    registrarAlteracao( nav, c );
+                }
+            }
+
+        }
+    }
+
+}
+
+void NavGradeCriar( NavGrade *nav, int colunas, int linhas, int celula, int folga ) {
+    nav->colunas = colunas;
+    nav->linhas = linhas;
+    nav->celula = celula;
+    nav->folga = folga;
+    nav->rocha = (unsigned char*)MemoriaZerada( MEMORIA_NAVEGACAO, colunas * linhas, 1 );
+    nav->bloqueada = (unsigned char*)MemoriaZerada( MEMORIA_NAVEGACAO, colunas * linhas, 1 );
+    nav->alteradas = NULL;
+    nav->quantidadeAlteradas = 0;
+    nav->capacidadeAlteradas = 0;
+}
+
+bool NavGradeCarregar( NavGrade *nav, const char *arquivo, int largura, int altura, int folga ) {
+
+    FILE *entrada = fopen( arquivo, "r" );
+    if ( entrada == NULL ) {
+        TraceLog( LOG_WARNING, "NAVEGACAO: rochas %s nao encontradas", arquivo );
+        NavGradeCriar( nav, largura / NAV_CELULA_PADRAO, altura / NAV_CELULA_PADRAO, NAV_CELULA_PADRAO, folga );
+        return false;
+    }
+
+    char linha[1024];
+    int versao = 0;
+    int celula = 0;
+    int colunas = 0;
+    int linhas = 0;
+    int linhaAtual = 0;
+    bool valido = true;
+    nav->rocha = NULL;
+
+    while ( fgets( linha, sizeof(linha), entrada ) != NULL ) {
+
+        if ( linha[0] == '#' || linha[0] == '\n' || linha[0] == '\r' ) {
+            continue;
+        }
+        if ( sscanf( linha, "OGNAV %d", &versao ) == 1 ) {
+            continue;
+        }
+        if ( sscanf( linha, "celula %d", &celula ) == 1 ) {
+            continue;
+        }
+        if ( sscanf( linha, "tamanho %d %d", &colunas, &linhas ) == 2 ) {
+            // so um tamanho: um segundo criaria outra grade por cima da primeira
+            valido = nav->rocha == NULL && versao == 1 && celula > 0 && colunas * celula == largura && linhas * celula == altura;
+            if ( !valido ) {
+                break;
+            }
+            NavGradeCriar( nav, colunas, linhas, celula, folga );
+            continue;
+        }
+
+        // linha da grade: '.' livre, 'R' rocha
+        if ( nav->rocha == NULL || linhaAtual >= linhas ) {
+            valido = false;
+            break;
+        }
+        for ( int x = 0; x < colunas && linha[x] != '\0'; x++ ) {
+            nav->rocha[linhaAtual * colunas + x] = linha[x] == 'R';
+        }
+        linhaAtual++;
+
+    }
+
+    fclose( entrada );
+
+    if ( !valido || nav->rocha == NULL || linhaAtual != linhas ) {
+        TraceLog( LOG_WARNING, "NAVEGACAO: rochas %s invalidas", arquivo );
+        if ( nav->rocha != NULL ) {
+            NavGradeDestruir( nav );
+        }
+        NavGradeCriar( nav, largura / NAV_CELULA_PADRAO, altura / NAV_CELULA_PADRAO, NAV_CELULA_PADRAO, folga );
+        return false;
+    }
+
+    for ( int cy = 0; cy < linhas; cy++ ) {
+        for ( int cx = 0; cx < colunas; cx++ ) {
+            if ( nav->rocha[cy * colunas + cx] ) {
+                inflarAoRedor( nav, cx, cy, false );
+            }
+        }
+    }
+
+    return true;
+
+}
+
+void NavGradeDestruir( NavGrade *nav ) {
+    MemoriaLiberar( nav->rocha );
+    MemoriaLiberar( nav->bloqueada );
+    MemoriaLiberar( nav->alteradas );
+    nav->rocha = NULL;
+    nav->bloqueada = NULL;
+    nav->alteradas = NULL;
+    nav->quantidadeAlteradas = 0;
+    nav->capacidadeAlteradas = 0;
+}
+
+void NavDefinirRocha( NavGrade *nav, int cx, int cy, bool rocha ) {
+    if ( !dentro( nav, cx, cy ) || nav->rocha[cy * nav->colunas + cx] == rocha ) {
+        return;
+    }
+    nav->rocha[cy * nav->colunas + cx] = rocha;
+    inflarAoRedor( nav, cx, cy, true );
+}
+
+void NavLimparAlteracoes( NavGrade *nav ) {
+    nav->quantidadeAlteradas = 0;
+}
+
+int NavCelula( const NavGrade *nav, Vector2 pos ) {
+    int cx = (int)floorf( pos.x / nav->celula );
+    int cy = (int)floorf( pos.y / nav->celula );
+    if ( cx < 0 ) cx = 0;
+    if ( cy < 0 ) cy = 0;
+    if ( cx >= nav->colunas ) cx = nav->colunas - 1;
+    if ( cy >= nav->linhas ) cy = nav->linhas - 1;
+    return cy * nav->colunas + cx;
+}
+
+bool NavRetanguloNaRocha( const NavGrade *nav, Rectangle rec ) {
+
+    int cx0 = (int)floorf( rec.x / nav->celula );
+    int cy0 = (int)floorf( rec.y / nav->celula );
+    int cx1 = (int)floorf( ( rec.x + rec.width - 0.01f ) / nav->celula );
+    int cy1 = (int)floorf( ( rec.y + rec.height - 0.01f ) / nav->celula );
+
+    for ( int cy = cy0; cy <= cy1; cy++ ) {
+        for ( int cx = cx0; cx <= cx1; cx++ ) {
+            if ( dentro( nav, cx, cy ) && nav->rocha[cy * nav->colunas + cx] ) {
+                return true;
+            }
+        }
+    }
+
+    return false;
+
+}
+
+void NavDesenharRochas( const NavGrade *nav, Rectangle visivel, Color cor ) {
+
+    int cx0 = (int)floorf( visivel.x / nav->celula );
+    int cy0 = (int)floorf( visivel.y / nav->celula );
+    int cx1 = (int)floorf( ( visivel.x + visivel.width ) / nav->celula );
+    int cy1 = (int)floorf( ( visivel.y + visivel.height ) / nav->celula );
+
+    for ( int cy = cy0; cy <= cy1; cy++ ) {
+        for ( int cx = cx0; cx <= cx1; cx++ ) {
+            if ( dentro( nav, cx, cy ) && nav->rocha[cy * nav->colunas + cx] ) {
+                // um pouco de variação de tom para as rochas não parecerem um bloco só
+                float tom = 0.85f + 0.15f * (float)( ( cx * 7 + cy * 13 ) % 5 ) / 4.0f;
+                Color c = { (unsigned char)( cor.r * tom ), (unsigned char)( cor.g * tom ),
+                            (unsigned char)( cor.b * tom ), cor.a };
+                DrawRectangle( cx * nav->celula, cy * nav->celula, nav->celula, nav->celula, c );
+            }
+        }
+    }
+
+}
+
+/*---------------------------------------------
+ * Campos de fluxo.
+ *-------------------------------------------*/
+/**
+ * @brief Um passo entre células vizinhas é válido se o destino está livre
+ * e, na diagonal, se ele não corta a quina de uma célula bloqueada.
+ */
+static bool passoValido( const NavGrade *nav, int de, int para ) {
+
+    if ( nav->bloqueada[para] ) {
+        return false;
+    }
+
+    int dx = para % nav->colunas - de % nav->colunas;
+    int dy = para / nav->colunas - de / nav->colunas;
+    if ( dx != 0 && dy != 0 ) {
+        return !nav->bloqueada[de + dx] && !nav->bloqueada[de + dy * nav->colunas];
+    }
+
+    return true;
+
+}
+
+static void empurrar( CampoFluxo *campo, int distancia, int c ) {
+
+    if ( campo->quantidadeHeap == campo->capacidadeHeap ) {
+        campo->capacidadeHeap *= 2;
+        campo->heap = (long long*)MemoriaRealocar( MEMORIA_NAVEGACAO, campo->heap, sizeof(long long) * campo->capacidadeHeap );
+    }
+
+    // chave = distância nos 32 bits altos, célula nos baixos
+    long long chave = ( (long long)distancia << 32 ) | (unsigned int)c;
+    int i = campo->quantidadeHeap++;
+    while ( i > 0 && campo->heap[( i - 1 ) / 2] > chave ) {
+        campo->heap[i] = campo->heap[( i - 1 ) / 2];
+        i = ( i - 1 ) / 2;
+    }
+    campo->heap[i] = chave;
+
+}
+
+static long long retirar( CampoFluxo *campo ) {
+
+    long long topo = campo->heap[0];
+    long long ultimo = campo->heap[--campo->quantidadeHeap];
+    int n = campo->quantidadeHeap;
+    int i = 0;
+
+    while ( true ) {
+        int filho = 2 * i + 1;
+        if ( filho >= n ) {
+            break;
+        }
+        if ( filho + 1 < n && campo->heap[filho + 1] < campo->heap[filho] ) {
+            filho++;
+        }
+        if ( campo->heap[filho] >= ultimo ) {
+            break;
+        }
+        campo->heap[i] = campo->heap[filho];
+        i = filho;
+    }
+    if ( n > 0 ) {
+        campo->heap[i] = ultimo;
+    }
+
+    return topo;
+
+}
+
+static void invalidarCelula( CampoFluxo *campo, int c ) {
+    campo->distancia[c] = NAV_INALCANCAVEL;
+    campo->proximo[c] = -1;
+    campo->direcaoX[c] = 0;
+    campo->direcaoY[c] = 0;
+}
+
+/**
+ * @brief Dijkstra a partir do que está no heap. Só diminui distâncias.
+ */
+static void propagar( CampoFluxo *campo, const NavGrade *nav ) {
+
+    while ( campo->quantidadeHeap > 0 ) {
+
+        long long chave = retirar( campo );
+        int d = (int)( chave >> 32 );
+        int c = (int)( chave & 0xffffffff );
+        if ( d != campo->distancia[c] ) {
+            continue; // entrada velha
+        }
+
+        int cx = c % nav->colunas;
+        int cy = c / nav->colunas;
+        for ( int k = 0; k < 8; k++ ) {
+
+            int nx = cx + VIZINHO_X[k];
+            int ny = cy + VIZINHO_Y[k];
+            if ( !dentro( nav, nx, ny ) ) {
+                continue;
+            }
+            int n = ny * nav->colunas + nx;
+            if ( nav->bloqueada[n] || !passoValido( nav, n, c ) ) {
+                continue;
+            }
+
+            int nd = d + ( k < 4 ? NAV_CUSTO_RETO : NAV_CUSTO_DIAGONAL );
+            if ( nd < campo->distancia[n] ) {
+                campo->distancia[n] = nd;
+                campo->proximo[n] = c;
+                float inverso = k < 4 ? 1.0f : 0.70710678f;
+                campo->direcaoX[n] = -VIZINHO_X[k] * inverso;
+                campo->direcaoY[n] = -VIZINHO_Y[k] * inverso;
+                empurrar( campo, nd, n );
+            }
+
+        }
+
+    }
+
+}
+
+/**
+ * @brief Célula livre mais próxima de c (em anéis quadrados crescentes).
+ */
+static int celulaLivreProxima( const NavGrade *nav, int c ) {
+
+    int cx = c % nav->colunas;
+    int cy = c / nav->colunas;
+    int maiorLado = nav->colunas > nav->linhas ? nav->colunas : nav->linhas;
+
+    for ( int raio = 0; raio < maiorLado; raio++ ) {
+        for ( int y = cy - raio; y <= cy + raio; y++ ) {
+            for ( int x = cx - raio; x <= cx + raio; x++ ) {
+                bool borda = y == cy - raio || y == cy + raio || x == cx - raio || x == cx + raio;
+                if ( borda && dentro( nav, x, y ) && !nav->bloqueada[y * nav->colunas + x] ) {
+                    return y * nav->colunas + x;
+                }
+            }
+        }
+    }
+
+    return c;
+
+}
+
+void FluxoCriar( CampoFluxo *campo, const NavGrade *nav, Vector2 destino ) {
+
+    int celulas = nav->colunas * nav->linhas;
+    campo->destino = NavCelula( nav, destino );
+    campo->distancia = (int*)MemoriaAlocar( MEMORIA_NAVEGACAO, sizeof(int) * celulas );
+    campo->proximo = (int*)MemoriaAlocar( MEMORIA_NAVEGACAO, sizeof(int) * celulas );
+    campo->direcaoX = (float*)MemoriaAlocar( MEMORIA_NAVEGACAO, sizeof(float) * celulas );
+    campo->direcaoY = (float*)MemoriaAlocar( MEMORIA_NAVEGACAO, sizeof(float) * celulas );
+    campo->capacidadeHeap = celulas * 2 + 64;
+    campo->heap = (long long*)MemoriaAlocar( MEMORIA_NAVEGACAO, sizeof(long long) * campo->capacidadeHeap );
+    campo->quantidadeHeap = 0;
+    campo->regiao = (int*)MemoriaAlocar( MEMORIA_NAVEGACAO, sizeof(int) * celulas );
+
+    FluxoRecalcular( campo, nav );
+
+}
+
+void FluxoDestruir( CampoFluxo *campo ) {
+    MemoriaLiberar( campo->distancia );
+    MemoriaLiberar( campo->proximo );
+    MemoriaLiberar( campo->direcaoX );
+    MemoriaLiberar( campo->direcaoY );
+    MemoriaLiberar( campo->heap );
+    MemoriaLiberar( campo->regiao );
+    memset( campo, 0, sizeof(CampoFluxo) );
+}
+
+void FluxoRecalcular( CampoFluxo *campo, const NavGrade *nav ) {
+
+    for ( int c = 0; c < nav->colunas * nav->linhas; c++ ) {
+        invalidarCelula( campo, c );
+    }
+
+    campo->objetivo = celulaLivreProxima( nav, campo->destino );
+    campo->quantidadeHeap = 0;
+    if ( !nav->bloqueada[campo->objetivo] ) {
+        campo->distancia[campo->objetivo] = 0;
+        empurrar( campo, 0, campo->objetivo );
+    }
+    propagar( campo, nav );
+
+}
+
+void FluxoDefinirDestino( CampoFluxo *campo, const NavGrade *nav, Vector2 destino ) {
+    int celula = NavCelula( nav, destino );
+    if ( celula != campo->destino ) {
+        campo->destino = celula;
+        FluxoRecalcular( campo, nav );
+    }
+}
+
+/**
+ * @brief Invalida c e todas as células cujo caminho passa por c,
+ * acrescentando-as em regiao.
+ */
+static int invalidarSubarvore( CampoFluxo *campo, const NavGrade *nav, int c, int tamanho ) {
+
+    if ( campo->distancia[c] == NAV_INALCANCAVEL ) {
+        return tamanho;
+    }
+
+    int inicio = tamanho;
+    invalidarCelula( campo, c );
+    campo->regiao[tamanho++] = c;
+
+    // busca em largura usando a própria região como fila
+    for ( int i = inicio; i < tamanho; i++ ) {
+        int atual = campo->regiao[i];
+        int ax = atual % nav->colunas;
+        int ay = atual / nav->colunas;
+        for ( int k = 0; k < 8; k++ ) {
+            int nx = ax + VIZINHO_X[k];
+            int ny = ay + VIZINHO_Y[k];
+            if ( !dentro( nav, nx, ny ) ) {
+                continue;
+            }
+            int n = ny * nav->colunas + nx;
+            if ( campo->proximo[n] == atual ) {
+                invalidarCelula( campo, n );
+                campo->regiao[tamanho++] = n;
+            }
+        }
+    }
+
+    return tamanho;
+
+}
+
+/**
+ * @brief Coloca no heap os vizinhos válidos de c, que voltam a propagar
+ * suas distâncias para dentro da região invalidada.
+ */
+static void semearAoRedor( CampoFluxo *campo, const NavGrade *nav, int c ) {
+    int cx = c % nav->colunas;
+    int cy = c / nav->colunas;
+    for ( int k = 0; k < 8; k++ ) {
+        int nx = cx + VIZINHO_X[k];
+        int ny = cy + VIZINHO_Y[k];
+        if ( dentro( nav, nx, ny ) ) {
+            int n = ny * nav->colunas + nx;
+            if ( campo->distancia[n] != NAV_INALCANCAVEL ) {
+                empurrar( campo, campo->distancia[n], n );
+            }
+        }
+    }
+}
+
+void FluxoAtualizar( CampoFluxo *campo, const NavGrade *nav ) {
+
+    if ( nav->quantidadeAlteradas == 0 ) {
+        return;
+    }
+
+    // o próprio objetivo mudou (fechou, ou o destino pedido abriu): o campo
+    // inteiro muda de raiz
+    if ( nav->bloqueada[campo->objetivo] ||
+         ( campo->objetivo != campo->destino && !nav->bloqueada[campo->destino] ) ) {
+        FluxoRecalcular( campo, nav );
+        return;
+    }
+
+    // 1) células que fecharam levam junto quem passava por elas, inclusive
+    // os vizinhos que cortavam a quina na diagonal
+    int tamanho = 0;
+    for ( int a = 0; a < nav->quantidadeAlteradas; a++ ) {
+
+        int c = nav->alteradas[a];
+        if ( !nav->bloqueada[c] ) {
+            continue;
+        }
+        tamanho = invalidarSubarvore( campo, nav, c, tamanho );
+
+        int cx = c % nav->colunas;
+        int cy = c / nav->colunas;
+        for ( int k = 0; k < 8; k++ ) {
+            int nx = cx + VIZINHO_X[k];
+            int ny = cy + VIZINHO_Y[k];
+            if ( !dentro( nav, nx, ny ) ) {
+                continue;
+            }
+            int n = ny * nav->colunas + nx;
+            if ( campo->proximo[n] >= 0 && !passoValido( nav, n, campo->proximo[n] ) ) {
+                tamanho = invalidarSubarvore( campo, nav, n, tamanho );
+            }
+        }
+
+    }
+
+    // 2) a borda da região invalidada e das células alteradas volta para o
+    // heap; células que abriram podem encurtar caminhos vizinhos
+    campo->quantidadeHeap = 0;
+    for ( int i = 0; i < tamanho; i++ ) {
+        semearAoRedor( campo, nav, campo->regiao[i] );
+    }
+    for ( int a = 0; a < nav->quantidadeAlteradas; a++ ) {
+        semearAoRedor( campo, nav, nav->alteradas[a] );
+    }
+    propagar( campo, nav );
+
+}
+
+Vector2 FluxoDirecao( const CampoFluxo *campo, const NavGrade *nav, Vector2 pos ) {
+
+    int c = NavCelula( nav, pos );
+    if ( campo->distancia[c] != NAV_INALCANCAVEL ) {
+        return (Vector2){ campo->direcaoX[c], campo->direcaoY[c] };
+    }
+
+    // fora do campo (dentro da folga de uma rocha): sai pelo vizinho mais
+    // próximo do objetivo
+    int melhor = -1;
+    int cx = c % nav->colunas;
+    int cy = c / nav->colunas;
+    for ( int k = 0; k < 8; k++ ) {
+        int nx = cx + VIZINHO_X[k];
+        int ny = cy + VIZINHO_Y[k];
+        if ( dentro( nav, nx, ny ) ) {
+            int n = ny * nav->colunas + nx;
+            if ( campo->distancia[n] != NAV_INALCANCAVEL &&
+                 ( melhor < 0 || campo->distancia[n] < campo->distancia[melhor] ) ) {
+                melhor = n;
+            }
+        }
+    }
+    if ( melhor < 0 ) {
+        return (Vector2){ 0, 0 };
+    }
+
+    float dx = ( melhor % nav->colunas + 0.5f ) * nav->celula - pos.x;
+    float dy = ( melhor / nav->colunas + 0.5f ) * nav->celula - pos.y;
+    float comprimento = sqrtf( dx * dx + dy * dy );
+    if ( comprimento < 0.001f ) {
+        return (Vector2){ 0, 0 };
+    }
+    return (Vector2){ dx / comprimento, dy / comprimento };
+
+}
@@ -0,0 +1,185 @@
+/**
+ * @file particulas.c
+ * @brief Integração vetorizada e desenho em lote das partículas.
+ * @copyright Copyright (c) 2025
+ */
+#include <stdlib.h>
+
+#if defined(__SSE2__) || defined(_M_X64)
+#define PARTICULAS_SSE2
+#include <emmintrin.h>
+#endif
+
+#include "raylib/raylib.h"
+#include "raylib/rlgl.h"
+
+#include "particulas.h"
+#include "memoria.h"
+
+#define CAMPOS_POR_PARTICULA 6
+
+// gerador xorshift próprio: rápido e não mexe na semente da raylib
+static unsigned int sementeParticulas = 2463534242u;
+
+static float aleatorioSimetrico( void ) {
+    sementeParticulas ^= sementeParticulas << 13;
+    sementeParticulas ^= sementeParticulas >> 17;
+    sementeParticulas ^= sementeParticulas << 5;
+    return ( sementeParticulas & 0xFFFF ) / 32767.5f - 1.0f;
+}
+
+void EmissorCriar( Emissor *emissor, int capacidade, Texture2D textura, Vector2 aceleracao, float arrasto, float vidaMaxima, Color cor ) {
+
+    capacidade = ( capacidade + 3 ) & ~3;
+
+    // um bloco só para todos os campos
+    float *bloco = (float*)MemoriaZerada( MEMORIA_PARTICULAS, (size_t)capacidade * CAMPOS_POR_PARTICULA, sizeof(float) );
+
+    emissor->x = bloco;
+    emissor->y = bloco + capacidade;
+    emissor->vx = bloco + capacidade * 2;
+    emissor->vy = bloco + capacidade * 3;
+    emissor->vida = bloco + capacidade * 4;
+    emissor->tamanho = bloco + capacidade * 5;
+    emissor->quantidade = 0;
+    emissor->capacidade = capacidade;
+
+    emissor->aceleracao = aceleracao;
+    emissor->arrasto = arrasto;
+    emissor->vidaMaxima = vidaMaxima;
+    emissor->cor = cor;
+    emissor->textura = textura;
+
+}
+
+void EmissorDestruir( Emissor *emissor ) {
+    MemoriaLiberar( emissor->x );
+    emissor->x = NULL;
+    emissor->quantidade = 0;
+    emissor->capacidade = 0;
+}
+
+void EmissorEmitir( Emissor *emissor, Vector2 pos, int quantidade, Vector2 velocidade, float espalhamento, float tamanho ) {
+
+    int livres = emissor->capacidade - emissor->quantidade;
+    if ( quantidade > livres ) {
+        quantidade = livres;
+    }
+
+    for ( int k = 0; k < quantidade; k++ ) {
+        int i = emissor->quantidade++;
+        emissor->x[i] = pos.x;
+        emissor->y[i] = pos.y;
+        emissor->vx[i] = velocidade.x + aleatorioSimetrico() * espalhamento;
+        emissor->vy[i] = velocidade.y + aleatorioSimetrico() * espalhamento;
+        emissor->vida[i] = emissor->vidaMaxima * ( 0.75f + 0.25f * aleatorioSimetrico() );
+        emissor->tamanho[i] = tamanho * ( 0.75f + 0.25f * aleatorioSimetrico() );
+    }
+
+}
+
+void EmissorAtualizar( Emissor *emissor, float delta ) {
+
+    float amortecimento = 1.0f - emissor->arrasto * delta;
+    if ( amortecimento < 0 ) {
+        amortecimento = 0;
+    }
+    float ax = emissor->aceleracao.x * delta;
+    float ay = emissor->aceleracao.y * delta;
+
+    int n = emissor->quantidade;
+    int i = 0;
+
+#ifdef PARTICULAS_SSE2
+    // os campos além de quantidade existem (capacidade múltipla de 4), então
+    // o último bloco pode ser processado inteiro
+    __m128 vAmortecimento = _mm_set1_ps( amortecimento );
+    __m128 vAx = _mm_set1_ps( ax );
+    __m128 vAy = _mm_set1_ps( ay );
+    __m128 vDelta = _mm_set1_ps( delta );
+    for ( ; i < n; i += 4 ) {
+        __m128 vx = _mm_add_ps( _mm_mul_ps( _mm_loadu_ps( emissor->vx + i ), vAmortecimento ), vAx );
+        __m128 vy = _mm_add_ps( _mm_mul_ps( _mm_loadu_ps( emissor->vy + i ), vAmortecimento ), vAy );
+        _mm_storeu_ps( emissor->vx + i, vx );
+        _mm_storeu_ps( emissor->vy + i, vy );
+        _mm_storeu_ps( emissor->x + i, _mm_add_ps( _mm_loadu_ps( emissor->x + i ), _mm_mul_ps( vx, vDelta ) ) );
+        _mm_storeu_ps( emissor->y + i, _mm_add_ps( _mm_loadu_ps( emissor->y + i ), _mm_mul_ps( vy, vDelta ) ) );
+        _mm_storeu_ps( emissor->vida + i, _mm_sub_ps( _mm_loadu_ps( emissor->vida + i ), vDelta ) );
+    }
+#else
+    for ( ; i < n; i++ ) {
+        emissor->vx[i] = emissor->vx[i] * amortecimento + ax;
+        emissor->vy[i] = emissor->vy[i] * amortecimento + ay;
+        emissor->x[i] += emissor->vx[i] * delta;
+        emissor->y[i] += emissor->vy[i] * delta;
+        emissor->vida[i] -= delta;
+    }
+#endif
+
+    // remove as mortas trocando pela última viva
+    i = 0;
+    while ( i < n ) {
+        if ( emissor->vida[i] > 0 ) {
+            i++;
+            continue;
+        }
+        n--;
+        emissor->x[i] = emissor->x[n];
+        emissor->y[i] = emissor->y[n];
+        emissor->vx[i] = emissor->vx[n];
+        emissor->vy[i] = emissor->vy[n];
+        emissor->vida[i] = emissor->vida[n];
+        emissor->tamanho[i] = emissor->tamanho[n];
+    }
+    emissor->quantidade = n;
+
+}
+
+void EmissorDesenhar( const Emissor *emissor, Rectangle visivel ) {
+
+    if ( emissor->quantidade == 0 ) {
+        return;
+    }
+
+    float xMax = visivel.x + visivel.width;
+    float yMax = visivel.y + visivel.height;
+    float alfaPorVida = emissor->cor.a / emissor->vidaMaxima;
+
+    // um único lote com a textura do emissor; o rlgl só faz flush quando o
+    // buffer de vértices enche
+    rlSetTexture( emissor->textura.id );
+    rlBegin( RL_QUADS );
+    rlNormal3f( 0.0f, 0.0f, 1.0f );
+
+    for ( int i = 0; i < emissor->quantidade; i++ ) {
+
+        float metade = emissor->tamanho[i] * 0.5f;
+        float x0 = emissor->x[i] - metade;
+        float y0 = emissor->y[i] - metade;
+        float x1 = emissor->x[i] + metade;
+        float y1 = emissor->y[i] + metade;
+        if ( x1 < visivel.x || y1 < visivel.y || x0 > xMax || y0 > yMax ) {
+            continue;
+        }
+
+        float alfa = emissor->vida[i] * alfaPorVida;
+        if ( alfa > emissor->cor.a ) {
+            alfa = emissor->cor.a;
+        }
+        rlColor4ub( emissor->cor.r, emissor->cor.g, emissor->cor.b, (unsigned char)alfa );
+
+        rlTexCoord2f( 0.0f, 0.0f );
+        rlVertex2f( x0, y0 );
+        rlTexCoord2f( 0.0f, 1.0f );
+        rlVertex2f( x0, y1 );
+        rlTexCoord2f( 1.0f, 1.0f );
+        rlVertex2f( x1, y1 );
+        rlTexCoord2f( 1.0f, 0.0f );
+        rlVertex2f( x1, y0 );
+
+    }
+
+    rlEnd();
+    rlSetTexture( 0 );
+
+}
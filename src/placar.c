@@ -0,0 +1,268 @@
+/**
+ * @file placar.c
+ * @brief Carga, ranking e gravação em segundo plano do placar.
+ * @copyright Copyright (c) 2025
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "placar.h"
+#include "memoria.h"
+
+#define PLACAR_MAGICA 0x4C50474Fu // "OGPL"
+
+typedef struct CabecalhoPlacar {
+    uint32_t magica;
+    uint32_t versao;
+    uint32_t quantidade;
+    uint32_t soma; // dos registros, para detectar arquivo truncado ou corrompido
+} CabecalhoPlacar;
+
+// o formato do arquivo depende deste tamanho
+typedef char RegistroPlacarTem16Bytes[sizeof(RegistroPlacar) == 16 ? 1 : -1];
+
+// FNV-1a por palavra de 32 bits: bem mais rápido que byte a byte
+static uint32_t somar( const RegistroPlacar *registros, int quantidade ) {
+    const uint8_t *bytes = (const uint8_t*)registros;
+    size_t palavras = (size_t)quantidade * sizeof(RegistroPlacar) / 4;
+    uint32_t soma = 2166136261u;
+    for ( size_t i = 0; i < palavras; i++ ) {
+        uint32_t palavra;
+        memcpy( &palavra, bytes + i * 4, 4 );
+        soma = ( soma ^ palavra ) * 16777619u;
+    }
+    return soma;
+}
+
+// ranking em ordem decrescente; no empate fica o registro mais antigo
+static void classificar( Placar *placar, const RegistroPlacar *registro ) {
+
+    if ( registro->jogador < PLACAR_MAX_JOGADORES && registro->pontuacao > placar->melhorJogador[registro->jogador] ) {
+        placar->melhorJogador[registro->jogador] = registro->pontuacao;
+    }
+    if ( registro->equipe > placar->melhorEquipe ) {
+        placar->melhorEquipe = registro->equipe;
+    }
+
+    int i = placar->tamanhoRanking;
+    if ( i == PLACAR_RANKING ) {
+        if ( registro->pontuacao <= placar->ranking[i - 1].pontuacao ) {
+            return;
+        }
+        i--;
+    } else {
+        placar->tamanhoRanking++;
+    }
+    while ( i > 0 && placar->ranking[i - 1].pontuacao < registro->pontuacao ) {
+        placar->ranking[i] = placar->ranking[i - 1];
+        i--;
+    }
+    placar->ranking[i] = *registro;
+
+}
+
+// descarta os PLACAR_DESCARTE registros mais antigos, menos um registro
+// por posição do ranking e por recorde: recalculados na carga, eles saem
+// iguais. Os que ficam mantêm a ordem, então os empates também
+static void compactar( Placar *placar ) {
+
+    bool guardouRanking[PLACAR_RANKING] = { false };
+    bool guardouJogador[PLACAR_MAX_JOGADORES] = { false };
+    bool guardouEquipe = false;
+    int destino = 0;
+
+    for ( int i = 0; i < PLACAR_DESCARTE; i++ ) {
+        const RegistroPlacar *registro = &placar->registros[i];
+        bool manter = false;
+        for ( int k = 0; k < placar->tamanhoRanking; k++ ) {
+            if ( !guardouRanking[k] && memcmp( registro, &placar->ranking[k], sizeof(RegistroPlacar) ) == 0 ) {
+                guardouRanking[k] = true;
+                manter = true;
+                break;
+            }
+        }
+        if ( registro->jogador < PLACAR_MAX_JOGADORES && !guardouJogador[registro->jogador] &&
+             registro->pontuacao == placar->melhorJogador[registro->jogador] ) {
+            guardouJogador[registro->jogador] = true;
+            manter = true;
+        }
+        if ( !guardouEquipe && registro->equipe == placar->melhorEquipe ) {
+            guardouEquipe = true;
+            manter = true;
+        }
+        if ( manter ) {
+            placar->registros[destino++] = *registro;
+        }
+    }
+
+    memmove( &placar->registros[destino], &placar->registros[PLACAR_DESCARTE],
+             sizeof(RegistroPlacar) * ( placar->quantidade - PLACAR_DESCARTE ) );
+    placar->quantidade -= PLACAR_DESCARTE - destino;
+
+}
+
+static bool carregar( Placar *placar, const char *caminho ) {
+
+    FILE *entrada = fopen( caminho, "rb" );
+    if ( entrada == NULL ) {
+        return false;
+    }
+
+    CabecalhoPlacar cabecalho;
+    bool ok = fread( &cabecalho, sizeof(cabecalho), 1, entrada ) == 1 &&
+              cabecalho.magica == PLACAR_MAGICA && cabecalho.versao == PLACAR_VERSAO &&
+              cabecalho.quantidade <= PLACAR_MAX_REGISTROS &&
+              fread( placar->registros, sizeof(RegistroPlacar), cabecalho.quantidade, entrada ) == cabecalho.quantidade &&
+              somar( placar->registros, (int)cabecalho.quantidade ) == cabecalho.soma;
+    fclose( entrada );
+
+    placar->quantidade = ok ? (int)cabecalho.quantidade : 0;
+    return ok;
+
+}
+
+static bool gravarArquivo( Placar *placar, int quantidade ) {
+
+    FILE *saida = fopen( placar->temporario, "wb" );
+    if ( saida == NULL ) {
+        return false;
+    }
+
+    CabecalhoPlacar cabecalho = { PLACAR_MAGICA, PLACAR_VERSAO, (uint32_t)quantidade, somar( placar->registros, quantidade ) };
+    bool ok = fwrite( &cabecalho, sizeof(cabecalho), 1, saida ) == 1 &&
+              fwrite( placar->registros, sizeof(RegistroPlacar), quantidade, saida ) == (size_t)quantidade &&
+              PlataformaGravarNoDisco( saida );
+    ok = fclose( saida ) == 0 && ok;
+
+    // só um arquivo completo e no disco substitui o placar
+    if ( !ok || !PlataformaSubstituirArquivo( placar->temporario, placar->arquivo ) ) {
+        remove( placar->temporario );
+        return false;
+    }
+    return true;
+
+}
+
+// a thread grava os registros [0, publicados), que o jogo não altera mais;
+// o mutex nunca fica travado durante a escrita
+static void executarGravacao( void *dados ) {
+
+    Placar *placar = (Placar*)dados;
+
+    MutexTravar( placar->mutex );
+    while ( true ) {
+        while ( !placar->encerrar && placar->publicados == placar->gravados ) {
+            CondEsperar( placar->cond, placar->mutex );
+        }
+        if ( placar->publicados == placar->gravados ) {
+            break;
+        }
+        int quantidade = placar->publicados;
+        placar->gravando = true;
+        MutexDestravar( placar->mutex );
+
+        bool ok = gravarArquivo( placar, quantidade );
+
+        MutexTravar( placar->mutex );
+        placar->gravados = quantidade;
+        placar->falhou = !ok;
+        placar->gravando = false;
+        CondSinalizar( placar->cond ); // compactar pode estar esperando
+    }
+    MutexDestravar( placar->mutex );
+
+}
+
+bool PlacarAbrir( Placar *placar, const char *arquivo ) {
+
+    memset( placar, 0, sizeof(Placar) );
+    placar->registros = (RegistroPlacar*)MemoriaAlocar( MEMORIA_PLACAR, sizeof(RegistroPlacar) * PLACAR_MAX_REGISTROS );
+    if ( placar->registros == NULL ) {
+        return false;
+    }
+    if ( arquivo == NULL || strlen( arquivo ) >= sizeof(placar->arquivo) ) {
+        return true;
+    }
+
+    strcpy( placar->arquivo, arquivo );
+    sprintf( placar->temporario, "%s.tmp", arquivo );
+
+    // sem o placar, o temporário só existe se a gravação caiu entre o
+    // fechamento e o rename; ele então já está completo e vira o placar
+    if ( carregar( placar, placar->arquivo ) ) {
+        placar->gravados = placar->quantidade;
+    } else if ( carregar( placar, placar->temporario ) ) {
+        placar->gravados = 0;
+    }
+    placar->publicados = placar->quantidade;
+    for ( int i = 0; i < placar->quantidade; i++ ) {
+        classificar( placar, &placar->registros[i] );
+    }
+
+    placar->mutex = MutexCriar();
+    placar->cond = CondCriar();
+    placar->thread = ThreadCriar( executarGravacao, placar );
+    if ( placar->thread == NULL ) {
+        CondDestruir( placar->cond );
+        MutexDestruir( placar->mutex );
+        placar->cond = NULL;
+        placar->mutex = NULL;
+    }
+    return true;
+
+}
+
+void PlacarFechar( Placar *placar ) {
+
+    if ( placar->thread != NULL ) {
+        MutexTravar( placar->mutex );
+        placar->encerrar = true;
+        CondSinalizar( placar->cond );
+        MutexDestravar( placar->mutex );
+        ThreadAguardar( placar->thread );
+        CondDestruir( placar->cond );
+        MutexDestruir( placar->mutex );
+    }
+    MemoriaLiberar( placar->registros );
+    memset( placar, 0, sizeof(Placar) );
+
+}
+
+bool PlacarRegistrar( Placar *placar, const RegistroPlacar *registros, int quantidade ) {
+
+    if ( placar->quantidade + quantidade > PLACAR_MAX_REGISTROS ) {
+        if ( placar->thread == NULL ) {
+            compactar( placar );
+        } else {
+            // a compactação mexe nos registros que a thread lê: espera a
+            // gravação em andamento e compacta com o mutex travado
+            MutexTravar( placar->mutex );
+            while ( placar->gravando ) {
+                CondEsperar( placar->cond, placar->mutex );
+            }
+            compactar( placar );
+            placar->publicados = placar->quantidade;
+            placar->gravados = 0; // o arquivo no disco ficou com os descartados
+            MutexDestravar( placar->mutex );
+        }
+        if ( placar->quantidade + quantidade > PLACAR_MAX_REGISTROS ) {
+            return false;
+        }
+    }
+
+    // acima de publicados a thread não lê: dá para escrever sem o mutex
+    for ( int i = 0; i < quantidade; i++ ) {
+        placar->registros[placar->quantidade++] = registros[i];
+        classificar( placar, &registros[i] );
+    }
+
+    if ( placar->thread != NULL ) {
+        MutexTravar( placar->mutex );
+        placar->publicados = placar->quantidade;
+        CondSinalizar( placar->cond );
+        MutexDestravar( placar->mutex );
+    }
+    return true;
+
+}
@@ -0,0 +1,403 @@
+/**
+ * @file plataforma.c
+ * @brief Implementação das primitivas de concorrência e do relógio para
+ * Linux e Windows.
+ * @copyright Copyright (c) 2025
+ */
+#if !defined(_WIN32) && !defined(_POSIX_C_SOURCE)
+#define _POSIX_C_SOURCE 200809L
+#endif
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#if defined(_WIN32)
+#define WIN32_LEAN_AND_MEAN
+#define PSAPI_VERSION 2 // K32GetProcessMemoryInfo, sem linkar psapi
+#include <windows.h>
+#include <psapi.h>
+#include <io.h>
+#include <malloc.h>
+#else
+#include <pthread.h>
+#include <time.h>
+#include <unistd.h>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#if defined(__GLIBC__)
+#include <malloc.h>
+#endif
+#endif
+
+#include "plataforma.h"
+#include "memoria.h"
+
+// da biblioteca do OpenGL que a raylib ja usa (opengl32 ou libGL)
+#if defined(_WIN32)
+void WINAPI glFinish( void );
+#else
+void glFinish( void );
+#endif
+
+#if defined(_WIN32)
+
+struct PlataformaThread {
+    HANDLE handle;
+    PlataformaFuncaoThread funcao;
+    void *dados;
+};
+
+struct PlataformaMutex {
+    CRITICAL_SECTION cs;
+};
+
+struct PlataformaCond {
+    CONDITION_VARIABLE cv;
+};
+
+static DWORD WINAPI executarThread( LPVOID parametro ) {
+    PlataformaThread *thread = (PlataformaThread*)parametro;
+    thread->funcao( thread->dados );
+    return 0;
+}
+
+PlataformaThread *ThreadCriar( PlataformaFuncaoThread funcao, void *dados ) {
+    PlataformaThread *thread = (PlataformaThread*)MemoriaAlocar( MEMORIA_PLATAFORMA, sizeof(PlataformaThread) );
+    thread->funcao = funcao;
+    thread->dados = dados;
+    thread->handle = CreateThread( NULL, 0, executarThread, thread, 0, NULL );
+    if ( thread->handle == NULL ) {
+        MemoriaLiberar( thread );
+        return NULL;
+    }
+    return thread;
+}
+
+void ThreadAguardar( PlataformaThread *thread ) {
+    WaitForSingleObject( thread->handle, INFINITE );
+    CloseHandle( thread->handle );
+    MemoriaLiberar( thread );
+}
+
+PlataformaMutex *MutexCriar( void ) {
+    PlataformaMutex *mutex = (PlataformaMutex*)MemoriaAlocar( MEMORIA_PLATAFORMA, sizeof(PlataformaMutex) );
+    InitializeCriticalSection( &mutex->cs );
+    return mutex;
+}
+
+void MutexDestruir( PlataformaMutex *mutex ) {
+    DeleteCriticalSection( &mutex->cs );
+    MemoriaLiberar( mutex );
+}
+
+void MutexTravar( PlataformaMutex *mutex ) {
+    EnterCriticalSection( &mutex->cs );
+}
+
+void MutexDestravar( PlataformaMutex *mutex ) {
+    LeaveCriticalSection( &mutex->cs );
+}
+
+PlataformaCond *CondCriar( void ) {
+    PlataformaCond *cond = (PlataformaCond*)MemoriaAlocar( MEMORIA_PLATAFORMA, sizeof(PlataformaCond) );
+    InitializeConditionVariable( &cond->cv );
+    return cond;
+}
+
+void CondDestruir( PlataformaCond *cond ) {
+    MemoriaLiberar( cond );
+}
+
+void CondEsperar( PlataformaCond *cond, PlataformaMutex *mutex ) {
+    SleepConditionVariableCS( &cond->cv, &mutex->cs, INFINITE );
+}
+
+void CondSinalizar( PlataformaCond *cond ) {
+    WakeConditionVariable( &cond->cv );
+}
+
+void CondSinalizarTodos( PlataformaCond *cond ) {
+    WakeAllConditionVariable( &cond->cv );
+}
+
+double PlataformaTempo( void ) {
+    static LARGE_INTEGER frequencia;
+    LARGE_INTEGER agora;
+    if ( frequencia.QuadPart == 0 ) {
+        QueryPerformanceFrequency( &frequencia );
+    }
+    QueryPerformanceCounter( &agora );
+    return (double)agora.QuadPart / (double)frequencia.QuadPart;
+}
+
+void PlataformaDormir( double segundos ) {
+    Sleep( segundos > 0 ? (DWORD)( segundos * 1000.0 ) : 0 );
+}
+
+bool PlataformaGravarNoDisco( FILE *arquivo ) {
+    return fflush( arquivo ) == 0 && _commit( _fileno( arquivo ) ) == 0;
+}
+
+bool PlataformaSubstituirArquivo( const char *origem, const char *destino ) {
+    // rename() do Windows falha se o destino existe
+    return MoveFileExA( origem, destino, MOVEFILE_REPLACE_EXISTING | MOVEFILE_WRITE_THROUGH ) != 0;
+}
+
+bool PlataformaTruncarArquivo( const char *caminho, size_t tamanho ) {
+
+    HANDLE arquivo = CreateFileA( caminho, GENERIC_WRITE, 0, NULL, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, NULL );
+    LARGE_INTEGER posicao;
+    if ( arquivo == INVALID_HANDLE_VALUE ) {
+        return false;
+    }
+    posicao.QuadPart = (LONGLONG)tamanho;
+    bool ok = SetFilePointerEx( arquivo, posicao, NULL, FILE_BEGIN ) && SetEndOfFile( arquivo );
+    CloseHandle( arquivo );
+    return ok;
+
+}
+
+const uint8_t *PlataformaMapearArquivo( const char *caminho, size_t *tamanho ) {
+
+    HANDLE arquivo = CreateFileA( caminho, GENERIC_READ, FILE_SHARE_READ, NULL, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, NULL );
+    LARGE_INTEGER bytes;
+    if ( arquivo == INVALID_HANDLE_VALUE ) {
+        return NULL;
+    }
+    if ( !GetFileSizeEx( arquivo, &bytes ) || bytes.QuadPart == 0 ) {
+        CloseHandle( arquivo );
+        return NULL;
+    }
+
+    // a visão continua válida depois de fechar os handles
+    HANDLE mapa = CreateFileMappingA( arquivo, NULL, PAGE_READONLY, 0, 0, NULL );
+    const uint8_t *dados = mapa != NULL ? (const uint8_t*)MapViewOfFile( mapa, FILE_MAP_READ, 0, 0, 0 ) : NULL;
+    if ( mapa != NULL ) {
+        CloseHandle( mapa );
+    }
+    CloseHandle( arquivo );
+
+    *tamanho = (size_t)bytes.QuadPart;
+    return dados;
+
+}
+
+void PlataformaDesmapearArquivo( const uint8_t *dados, size_t tamanho ) {
+    if ( dados != NULL ) {
+        UnmapViewOfFile( dados );
+    }
+}
+
+int PlataformaNucleos( void ) {
+    SYSTEM_INFO info;
+    GetSystemInfo( &info );
+    return info.dwNumberOfProcessors > 0 ? (int)info.dwNumberOfProcessors : 1;
+}
+
+size_t PlataformaMemoriaResidente( void ) {
+    PROCESS_MEMORY_COUNTERS contadores;
+    if ( !K32GetProcessMemoryInfo( GetCurrentProcess(), &contadores, sizeof(contadores) ) ) {
+        return 0;
+    }
+    return contadores.WorkingSetSize;
+}
+
+size_t PlataformaMemoriaHeap( void ) {
+    _HEAPINFO bloco;
+    size_t total = 0;
+    bloco._pentry = NULL;
+    while ( _heapwalk( &bloco ) == _HEAPOK ) {
+        if ( bloco._useflag == _USEDENTRY ) {
+            total += bloco._size;
+        }
+    }
+    return total;
+}
+
+#else
+
+struct PlataformaThread {
+    pthread_t id;
+    PlataformaFuncaoThread funcao;
+    void *dados;
+};
+
+struct PlataformaMutex {
+    pthread_mutex_t m;
+};
+
+struct PlataformaCond {
+    pthread_cond_t c;
+};
+
+static void *executarThread( void *parametro ) {
+    PlataformaThread *thread = (PlataformaThread*)parametro;
+    thread->funcao( thread->dados );
+    return NULL;
+}
+
+PlataformaThread *ThreadCriar( PlataformaFuncaoThread funcao, void *dados ) {
+    PlataformaThread *thread = (PlataformaThread*)MemoriaAlocar( MEMORIA_PLATAFORMA, sizeof(PlataformaThread) );
+    thread->funcao = funcao;
+    thread->dados = dados;
+    if ( pthread_create( &thread->id, NULL, executarThread, thread ) != 0 ) {
+        MemoriaLiberar( thread );
+        return NULL;
+    }
+    return thread;
+}
+
+void ThreadAguardar( PlataformaThread *thread ) {
+    pthread_join( thread->id, NULL );
+    MemoriaLiberar( thread );
+}
+
+PlataformaMutex *MutexCriar( void ) {
+    PlataformaMutex *mutex = (PlataformaMutex*)MemoriaAlocar( MEMORIA_PLATAFORMA, sizeof(PlataformaMutex) );
+    pthread_mutex_init( &mutex->m, NULL );
+    return mutex;
+}
+
+void MutexDestruir( PlataformaMutex *mutex ) {
+    pthread_mutex_destroy( &mutex->m );
+    MemoriaLiberar( mutex );
+}
+
+void MutexTravar( PlataformaMutex *mutex ) {
+    pthread_mutex_lock( &mutex->m );
+}
+
+void MutexDestravar( PlataformaMutex *mutex ) {
+    pthread_mutex_unlock( &mutex->m );
+}
+
+PlataformaCond *CondCriar( void ) {
+    PlataformaCond *cond = (PlataformaCond*)MemoriaAlocar( MEMORIA_PLATAFORMA, sizeof(PlataformaCond) );
+    pthread_cond_init( &cond->c, NULL );
+    return cond;
+}
+
+void CondDestruir( PlataformaCond *cond ) {
+    pthread_cond_destroy( &cond->c );
+    MemoriaLiberar( cond );
+}
+
+void CondEsperar( PlataformaCond *cond, PlataformaMutex *mutex ) {
+    pthread_cond_wait( &cond->c, &mutex->m );
+}
+
+void CondSinalizar( PlataformaCond *cond ) {
+    pthread_cond_signal( &cond->c );
+}
+
+void CondSinalizarTodos( PlataformaCond *cond ) {
+    pthread_cond_broadcast( &cond->c );
+}
+
+double PlataformaTempo( void ) {
+    struct timespec agora;
+    clock_gettime( CLOCK_MONOTONIC, &agora );
+    return agora.tv_sec + agora.tv_nsec / 1e9;
+}
+
+void PlataformaDormir( double segundos ) {
+    struct timespec espera;
+    if ( segundos <= 0 ) {
+        return;
+    }
+    espera.tv_sec = (time_t)segundos;
+    espera.tv_nsec = (long)( ( segundos - (double)espera.tv_sec ) * 1e9 );
+    nanosleep( &espera, NULL );
+}
+
+bool PlataformaGravarNoDisco( FILE *arquivo ) {
+    return fflush( arquivo ) == 0 && fsync( fileno( arquivo ) ) == 0;
+}
+
+bool PlataformaSubstituirArquivo( const char *origem, const char *destino ) {
+    return rename( origem, destino ) == 0;
+}
+
+bool PlataformaTruncarArquivo( const char *caminho, size_t tamanho ) {
+    return truncate( caminho, (off_t)tamanho ) == 0;
+}
+
+const uint8_t *PlataformaMapearArquivo( const char *caminho, size_t *tamanho ) {
+
+    int arquivo = open( caminho, O_RDONLY );
+    struct stat info;
+    if ( arquivo < 0 ) {
+        return NULL;
+    }
+    if ( fstat( arquivo, &info ) != 0 || info.st_size == 0 ) {
+        close( arquivo );
+        return NULL;
+    }
+
+    // o mapeamento continua válido depois de fechar o descritor
+    void *dados = mmap( NULL, (size_t)info.st_size, PROT_READ, MAP_PRIVATE, arquivo, 0 );
+    close( arquivo );
+    if ( dados == MAP_FAILED ) {
+        return NULL;
+    }
+    posix_madvise( dados, (size_t)info.st_size, POSIX_MADV_WILLNEED );
+
+    *tamanho = (size_t)info.st_size;
+    return (const uint8_t*)dados;
+
+}
+
+void PlataformaDesmapearArquivo( const uint8_t *dados, size_t tamanho ) {
+    if ( dados != NULL ) {
+        munmap( (void*)dados, tamanho );
+    }
+}
+
+int PlataformaNucleos( void ) {
+    long nucleos = sysconf( _SC_NPROCESSORS_ONLN );
+    return nucleos > 0 ? (int)nucleos : 1;
+}
+
+size_t PlataformaMemoriaResidente( void ) {
+
+    // /proc/self/statm: tamanho total e páginas residentes
+    FILE *statm = fopen( "/proc/self/statm", "r" );
+    unsigned long total = 0;
+    unsigned long residentes = 0;
+    if ( statm == NULL ) {
+        return 0;
+    }
+    if ( fscanf( statm, "%lu %lu", &total, &residentes ) != 2 ) {
+        residentes = 0;
+    }
+    fclose( statm );
+
+    return (size_t)residentes * (size_t)sysconf( _SC_PAGESIZE );
+
+}
+
+size_t PlataformaMemoriaHeap( void ) {
+#if defined(__GLIBC__) && ( __GLIBC__ > 2 || __GLIBC_MINOR__ >= 33 )
+    struct mallinfo2 info = mallinfo2();
+    return info.uordblks + info.hblkhd; // arenas + blocos grandes (mmap)
+#else
+    return 0;
+#endif
+}
+
+#endif
+
+void PlataformaDormirAte( double tempo ) {
+    // o sono do sistema pode passar do ponto em ~1 ms: o fim e espera ativa
+    double resto = tempo - PlataformaTempo();
+    if ( resto > 0.002 ) {
+        PlataformaDormir( resto - 0.002 );
+    }
+    while ( PlataformaTempo() < tempo ) {
+    }
+}
+
+void PlataformaEsperarGpu( void ) {
+    glFinish();
+}
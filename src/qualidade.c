@@ -0,0 +1,107 @@
+/**
+ * @file qualidade.c
+ * @brief Níveis de qualidade e histerese do governador.
+ * @copyright Copyright (c) 2025
+ */
+#include <string.h>
+
+#include "qualidade.h"
+
+// do mais bonito ao mais barato; cada nível corta o que pesa menos na tela
+static const NivelQualidade NIVEIS[NUM_NIVEIS_QUALIDADE] = {
+    [QUALIDADE_ALTA]   = { "alta",   true,  1.00f, 1.00f, 1 },
+    [QUALIDADE_MEDIA]  = { "media",  false, 1.00f, 0.50f, 1 },
+    [QUALIDADE_BAIXA]  = { "baixa",  false, 0.75f, 0.50f, 2 },
+    [QUALIDADE_MINIMA] = { "minima", false, 0.50f, 0.25f, 3 }
+};
+
+static int limitarNivel( int nivel ) {
+    return nivel < 0 ? 0 : nivel >= NUM_NIVEIS_QUALIDADE ? NUM_NIVEIS_QUALIDADE - 1 : nivel;
+}
+
+static void trocarNivel( GovernadorQualidade *governador, int nivel ) {
+
+    if ( nivel > governador->nivel ) {
+        // desceu logo depois de subir: a subida foi cedo demais
+        if ( governador->janelasDesdeSubida >= 0 && governador->janelasDesdeSubida < QUALIDADE_SUBIDA_RECENTE ) {
+            governador->folgaExigida *= 2;
+            if ( governador->folgaExigida > QUALIDADE_JANELAS_FOLGA_MAXIMO ) {
+                governador->folgaExigida = QUALIDADE_JANELAS_FOLGA_MAXIMO;
+            }
+        }
+        governador->janelasDesdeSubida = -1;
+        governador->descidas++;
+    } else {
+        governador->janelasDesdeSubida = 0;
+        governador->subidas++;
+    }
+
+    governador->nivel = nivel;
+    governador->janelasRuins = 0;
+    governador->janelasFolga = 0;
+    governador->ignorarJanela = true;
+
+}
+
+void GovernadorCriar( GovernadorQualidade *governador, bool automatico, int nivel, float orcamentoMs ) {
+    memset( governador, 0, sizeof(GovernadorQualidade) );
+    governador->automatico = automatico;
+    governador->nivel = limitarNivel( nivel );
+    governador->orcamentoMs = orcamentoMs;
+    governador->folgaExigida = QUALIDADE_JANELAS_FOLGA;
+    governador->janelasDesdeSubida = -1;
+}
+
+bool GovernadorRegistrar( GovernadorQualidade *governador, float intervaloMs, float custoMs ) {
+
+    if ( !governador->automatico ) {
+        return false;
+    }
+
+    governador->somaIntervalos += intervaloMs;
+    governador->somaCustos += custoMs;
+    if ( ++governador->quadros < QUALIDADE_JANELA ) {
+        return false;
+    }
+
+    float intervalo = (float)( governador->somaIntervalos / governador->quadros );
+    float custo = (float)( governador->somaCustos / governador->quadros );
+    governador->somaIntervalos = 0;
+    governador->somaCustos = 0;
+    governador->quadros = 0;
+
+    if ( governador->ignorarJanela ) {
+        governador->ignorarJanela = false;
+        return false;
+    }
+    if ( governador->janelasDesdeSubida >= 0 ) {
+        governador->janelasDesdeSubida++;
+    }
+
+    // entre as duas faixas a janela não conta para nenhum lado
+    bool ruim = intervalo > governador->orcamentoMs * QUALIDADE_LIMITE_RUIM;
+    bool folga = !ruim && custo < governador->orcamentoMs * QUALIDADE_LIMITE_FOLGA;
+    governador->janelasRuins = ruim ? governador->janelasRuins + 1 : 0;
+    governador->janelasFolga = folga ? governador->janelasFolga + 1 : 0;
+
+    if ( governador->janelasRuins >= QUALIDADE_JANELAS_RUINS && governador->nivel < NUM_NIVEIS_QUALIDADE - 1 ) {
+        trocarNivel( governador, governador->nivel + 1 );
+        return true;
+    }
+    if ( governador->janelasFolga >= governador->folgaExigida && governador->nivel > 0 ) {
+        trocarNivel( governador, governador->nivel - 1 );
+        return true;
+    }
+    return false;
+
+}
+
+const NivelQualidade *GovernadorNivel( const GovernadorQualidade *governador ) {
+    return &NIVEIS[governador->nivel];
+}
+
+void GovernadorRelatorio( const GovernadorQualidade *governador, FILE *saida ) {
+    fprintf( saida, "qualidade: %s (%s), %lld descidas, %lld subidas, subida exige %d janelas de folga\n",
+             GovernadorNivel( governador )->nome, governador->automatico ? "automatica" : "fixa",
+             governador->descidas, governador->subidas, governador->folgaExigida );
+}
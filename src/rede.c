@@ -0,0 +1,284 @@
+/**
+ * @file rede.c
+ * @brief Sockets UDP (BSD e Winsock) e formato dos pacotes do multiplayer
+ * em rede. Os campos são gravados em little endian, byte a byte; o corpo
+ * dos snapshots é do codec de snapshot.c.
+ * @copyright Copyright (c) 2025
+ */
+#if !defined(_WIN32) && !defined(_POSIX_C_SOURCE)
+#define _POSIX_C_SOURCE 200809L
+#endif
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#if defined(_WIN32)
+#define WIN32_LEAN_AND_MEAN
+#include <winsock2.h>
+#include <ws2tcpip.h>
+#else
+#include <sys/types.h>
+#include <sys/socket.h>
+#include <netinet/in.h>
+#include <arpa/inet.h>
+#include <netdb.h>
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+#include "rede.h"
+#include "memoria.h"
+
+#if defined(_WIN32)
+typedef SOCKET SocketNativo;
+#define SOCKET_INVALIDO INVALID_SOCKET
+#define fecharSocket closesocket
+#else
+typedef int SocketNativo;
+#define SOCKET_INVALIDO -1
+#define fecharSocket close
+#endif
+
+struct RedeSocket {
+    SocketNativo s;
+};
+
+// escrita e leitura sequencial de um pacote
+typedef struct Leitor {
+    const uint8_t *dados;
+    int tamanho;
+    int pos;
+    bool erro;
+} Leitor;
+
+static uint8_t *escrever8( uint8_t *p, uint32_t v ) {
+    *p++ = (uint8_t)v;
+    return p;
+}
+
+static uint8_t *escrever16( uint8_t *p, uint32_t v ) {
+    *p++ = (uint8_t)v;
+    *p++ = (uint8_t)( v >> 8 );
+    return p;
+}
+
+static uint8_t *escrever32( uint8_t *p, uint32_t v ) {
+    p = escrever16( p, v & 0xFFFF );
+    return escrever16( p, v >> 16 );
+}
+
+static uint32_t ler8( Leitor *l ) {
+    if ( l->pos + 1 > l->tamanho ) {
+        l->erro = true;
+        return 0;
+    }
+    return l->dados[l->pos++];
+}
+
+static uint32_t ler16( Leitor *l ) {
+    uint32_t v = ler8( l );
+    return v | ( ler8( l ) << 8 );
+}
+
+static uint32_t ler32( Leitor *l ) {
+    uint32_t v = ler16( l );
+    return v | ( ler16( l ) << 16 );
+}
+
+// o codec recebe os lixos pelo ponteiro; o snapshot guardado tem o array
+static Snapshot visao( const SnapshotRede *snapshot ) {
+    Snapshot v = snapshot->jogo;
+    v.lixos = (SnapshotLixo*)snapshot->lixos;
+    v.capacidadeLixos = REDE_MAX_LIXOS;
+    return v;
+}
+
+RedeSocket *RedeAbrir( int porta ) {
+
+#if defined(_WIN32)
+    static bool iniciado = false;
+    if ( !iniciado ) {
+        WSADATA wsa;
+        if ( WSAStartup( MAKEWORD( 2, 2 ), &wsa ) != 0 ) {
+            return NULL;
+        }
+        iniciado = true;
+    }
+#endif
+
+    SocketNativo s = socket( AF_INET, SOCK_DGRAM, IPPROTO_UDP );
+    if ( s == SOCKET_INVALIDO ) {
+        return NULL;
+    }
+
+    struct sockaddr_in local;
+    memset( &local, 0, sizeof(local) );
+    local.sin_family = AF_INET;
+    local.sin_addr.s_addr = htonl( INADDR_ANY );
+    local.sin_port = htons( (uint16_t)porta );
+    if ( bind( s, (struct sockaddr*)&local, sizeof(local) ) != 0 ) {
+        fecharSocket( s );
+        return NULL;
+    }
+
+#if defined(_WIN32)
+    u_long naoBloqueante = 1;
+    ioctlsocket( s, FIONBIO, &naoBloqueante );
+#else
+    fcntl( s, F_SETFL, fcntl( s, F_GETFL, 0 ) | O_NONBLOCK );
+#endif
+
+    RedeSocket *aberto = (RedeSocket*)MemoriaAlocar( MEMORIA_REDE, sizeof(RedeSocket) );
+    aberto->s = s;
+    return aberto;
+
+}
+
+void RedeFechar( RedeSocket *socket ) {
+    if ( socket != NULL ) {
+        fecharSocket( socket->s );
+        MemoriaLiberar( socket );
+    }
+}
+
+bool RedeResolver( const char *texto, RedeEndereco *endereco ) {
+
+    char host[256];
+    const char *doisPontos = strrchr( texto, ':' );
+    if ( doisPontos == NULL || doisPontos - texto >= (long)sizeof(host) ) {
+        return false;
+    }
+    memcpy( host, texto, doisPontos - texto );
+    host[doisPontos - texto] = '\0';
+
+    struct addrinfo dica;
+    struct addrinfo *resultado = NULL;
+    memset( &dica, 0, sizeof(dica) );
+    dica.ai_family = AF_INET;
+    dica.ai_socktype = SOCK_DGRAM;
+    if ( getaddrinfo( host, NULL, &dica, &resultado ) != 0 || resultado == NULL ) {
+        return false;
+    }
+    endereco->ip = ntohl( ( (struct sockaddr_in*)resultado->ai_addr )->sin_addr.s_addr );
+    endereco->porta = (uint16_t)atoi( doisPontos + 1 );
+    freeaddrinfo( resultado );
+
+    return endereco->porta != 0;
+
+}
+
+bool RedeEnviar( RedeSocket *socket, RedeEndereco destino, const uint8_t *dados, int tamanho ) {
+    struct sockaddr_in para;
+    memset( &para, 0, sizeof(para) );
+    para.sin_family = AF_INET;
+    para.sin_addr.s_addr = htonl( destino.ip );
+    para.sin_port = htons( destino.porta );
+    return sendto( socket->s, (const char*)dados, tamanho, 0, (struct sockaddr*)&para, sizeof(para) ) == tamanho;
+}
+
+int RedeReceber( RedeSocket *socket, uint8_t *dados, int capacidade, RedeEndereco *origem ) {
+    struct sockaddr_in de;
+    socklen_t tamanhoDe = sizeof(de);
+    int n = (int)recvfrom( socket->s, (char*)dados, capacidade, 0, (struct sockaddr*)&de, &tamanhoDe );
+    if ( n <= 0 ) {
+        return 0; // nada esperando (EWOULDBLOCK) ou erro
+    }
+    origem->ip = ntohl( de.sin_addr.s_addr );
+    origem->porta = ntohs( de.sin_port );
+    return n;
+}
+
+bool RedeMesmoEndereco( RedeEndereco a, RedeEndereco b ) {
+    return a.ip == b.ip && a.porta == b.porta;
+}
+
+int RedeEscreverBoasVindas( uint8_t *dados, int jogador, int numJogadores, int taxa ) {
+    uint8_t *p = dados;
+    p = escrever8( p, PACOTE_BOAS_VINDAS );
+    p = escrever8( p, (uint32_t)jogador );
+    p = escrever8( p, (uint32_t)numJogadores );
+    p = escrever16( p, (uint32_t)taxa );
+    return (int)( p - dados );
+}
+
+bool RedeLerBoasVindas( const uint8_t *dados, int tamanho, int *jogador, int *numJogadores, int *taxa ) {
+    Leitor l = { dados, tamanho, 0, false };
+    if ( ler8( &l ) != PACOTE_BOAS_VINDAS ) {
+        return false;
+    }
+    int lidoJogador = (int)ler8( &l );
+    int lidoNumJogadores = (int)ler8( &l );
+    int lidoTaxa = (int)ler16( &l );
+    if ( l.erro || lidoNumJogadores < 1 || lidoNumJogadores > REDE_MAX_JOGADORES || lidoJogador >= lidoNumJogadores ||
+         lidoTaxa < 1 || lidoTaxa > REDE_TAXA_MAXIMA ) {
+        return false;
+    }
+    *jogador = lidoJogador;
+    *numJogadores = lidoNumJogadores;
+    *taxa = lidoTaxa;
+    return true;
+}
+
+int RedeEscreverEntrada( uint8_t *dados, uint32_t sequencia, const uint8_t *entradas, int quantidade, uint32_t ackSnapshot ) {
+    uint8_t *p = dados;
+    p = escrever8( p, PACOTE_ENTRADA );
+    p = escrever32( p, sequencia );
+    p = escrever32( p, ackSnapshot );
+    p = escrever8( p, (uint32_t)quantidade );
+    for ( int i = 0; i < quantidade; i++ ) {
+        p = escrever8( p, entradas[i] );
+    }
+    return (int)( p - dados );
+}
+
+bool RedeLerEntrada( const uint8_t *dados, int tamanho, uint32_t *sequencia, uint8_t *entradas, int *quantidade, uint32_t *ackSnapshot ) {
+    Leitor l = { dados, tamanho, 0, false };
+    if ( ler8( &l ) != PACOTE_ENTRADA ) {
+        return false;
+    }
+    *sequencia = ler32( &l );
+    *ackSnapshot = ler32( &l );
+    *quantidade = (int)ler8( &l );
+    if ( *quantidade > REDE_ENTRADAS_POR_PACOTE ) {
+        return false;
+    }
+    for ( int i = 0; i < *quantidade; i++ ) {
+        entradas[i] = (uint8_t)ler8( &l );
+    }
+    return !l.erro;
+}
+
+int RedeEscreverSnapshot( uint8_t *dados, const SnapshotRede *snapshot, const SnapshotRede *base ) {
+    Snapshot atual = visao( snapshot );
+    Snapshot anterior;
+    if ( base != NULL ) {
+        anterior = visao( base );
+    }
+    dados[0] = PACOTE_SNAPSHOT;
+    int tamanho = SnapshotEscrever( dados + 1, REDE_TAMANHO_PACOTE - 1, &atual, base != NULL ? &anterior : NULL );
+    return tamanho < 0 ? 0 : tamanho + 1;
+}
+
+uint32_t RedeBaseSnapshot( const uint8_t *dados, int tamanho ) {
+    return tamanho > 1 ? SnapshotTickBase( dados + 1, tamanho - 1 ) : 0;
+}
+
+bool RedeLerSnapshot( const uint8_t *dados, int tamanho, const SnapshotRede *base, SnapshotRede *snapshot ) {
+    Snapshot anterior;
+    Snapshot lido;
+    if ( tamanho < 2 || dados[0] != PACOTE_SNAPSHOT ) {
+        return false;
+    }
+    if ( base != NULL ) {
+        anterior = visao( base );
+    }
+    lido.lixos = snapshot->lixos;
+    lido.capacidadeLixos = REDE_MAX_LIXOS;
+    if ( !SnapshotLer( dados + 1, tamanho - 1, base != NULL ? &anterior : NULL, &lido ) ) {
+        return false;
+    }
+    snapshot->jogo = lido;
+    snapshot->jogo.lixos = NULL;
+    return true;
+}
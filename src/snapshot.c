@@ -0,0 +1,341 @@
+/**
+ * @file snapshot.c
+ * @brief Codec empacotado em bits do estado do jogo. Os bits são gravados
+ * do menos para o mais significativo de cada byte.
+ * @copyright Copyright (c) 2025
+ */
+#include <stddef.h>
+#include <stdint.h>
+
+#include "snapshot.h"
+
+/*
+ * Formato (versão 1):
+ *    8 bits versão, 32 tick, 1 tem base, [32 tick da base], 32 última entrada
+ *    2 estado, 12 tempo em décimos de segundo
+ *    3 jogadores; cada um: x, y, pontuação e flags (ver abaixo)
+ *    3 lixeiras; cada uma: 1 mudou, [16 x, 16 y, 16 largura, 16 altura, 3 tipo]
+ *    32 lixos; cada um: 1 mudou, [1 ativo, [tipo, x, y]]
+ *
+ * Com a base, posições e pontuação vão como diferença (ver escreverDelta)
+ * e as flags dos jogadores em XOR com as da base; sem a base, posições têm
+ * 16 bits e o tipo do lixo 3 bits.
+ */
+
+typedef struct EscritorBits {
+    uint8_t *dados;
+    int capacidade;
+    int bytes;
+    uint64_t acumulador;
+    int bits;
+    bool erro;
+} EscritorBits;
+
+typedef struct LeitorBits {
+    const uint8_t *dados;
+    int tamanho;
+    int pos;
+    uint64_t acumulador;
+    int bits;
+    bool erro;
+} LeitorBits;
+
+static void escreverBits( EscritorBits *e, uint32_t valor, int n ) {
+    if ( n < 32 ) {
+        valor &= ( 1u << n ) - 1;
+    }
+    e->acumulador |= (uint64_t)valor << e->bits;
+    e->bits += n;
+    while ( e->bits >= 8 ) {
+        if ( e->bytes == e->capacidade ) {
+            e->erro = true;
+            e->bits = 0;
+            return;
+        }
+        e->dados[e->bytes++] = (uint8_t)e->acumulador;
+        e->acumulador >>= 8;
+        e->bits -= 8;
+    }
+}
+
+static int terminarEscrita( EscritorBits *e ) {
+    if ( e->bits > 0 ) {
+        escreverBits( e, 0, 8 - e->bits );
+    }
+    return e->erro ? -1 : e->bytes;
+}
+
+static uint32_t lerBits( LeitorBits *l, int n ) {
+    while ( l->bits < n ) {
+        if ( l->pos >= l->tamanho ) {
+            l->erro = true;
+            return 0;
+        }
+        l->acumulador |= (uint64_t)l->dados[l->pos++] << l->bits;
+        l->bits += 8;
+    }
+    uint32_t valor = n < 32 ? (uint32_t)l->acumulador & ( ( 1u << n ) - 1 ) : (uint32_t)l->acumulador;
+    l->acumulador >>= n;
+    l->bits -= n;
+    return valor;
+}
+
+/*
+ * Diferença com sinal em zigzag, com prefixo de tamanho:
+ *    0           -> zero
+ *    10 + 4 bits -> |d| até 7 (lixo à deriva, mergulhador parado)
+ *    110 + 8     -> até 127 (mergulhador nadando)
+ *    111 + 32    -> qualquer outra
+ */
+static void escreverDelta( EscritorBits *e, int32_t d ) {
+    uint32_t z = ( (uint32_t)d << 1 ) ^ (uint32_t)( d >> 31 );
+    if ( z == 0 ) {
+        escreverBits( e, 0, 1 );
+    } else if ( z < 16 ) {
+        escreverBits( e, 1, 2 );
+        escreverBits( e, z, 4 );
+    } else if ( z < 256 ) {
+        escreverBits( e, 3, 3 );
+        escreverBits( e, z, 8 );
+    } else {
+        escreverBits( e, 7, 3 );
+        escreverBits( e, z, 32 );
+    }
+}
+
+static int32_t lerDelta( LeitorBits *l ) {
+    uint32_t z;
+    if ( lerBits( l, 1 ) == 0 ) {
+        return 0;
+    } else if ( lerBits( l, 1 ) == 0 ) {
+        z = lerBits( l, 4 );
+    } else if ( lerBits( l, 1 ) == 0 ) {
+        z = lerBits( l, 8 );
+    } else {
+        z = lerBits( l, 32 );
+    }
+    return (int32_t)( z >> 1 ) ^ -(int32_t)( z & 1 );
+}
+
+static int32_t quantizar( float v ) {
+    float q = v * SNAPSHOT_QUANTIZACAO + 0.5f;
+    return q < 0 ? 0 : q > 65535.0f ? 65535 : (int32_t)q;
+}
+
+static float desquantizar( int32_t q ) {
+    return q / SNAPSHOT_QUANTIZACAO;
+}
+
+static uint32_t flagsJogador( const SnapshotJogador *j ) {
+    return (uint32_t)( j->tipoLixo & 7 ) | (uint32_t)( j->quadro & 3 ) << 3 |
+           (uint32_t)j->virado << 5 | (uint32_t)j->movendo << 6;
+}
+
+static bool lixeiraIgual( const SnapshotLixeira *a, const SnapshotLixeira *b ) {
+    return a->tipo == b->tipo && quantizar( a->x ) == quantizar( b->x ) && quantizar( a->y ) == quantizar( b->y ) &&
+           quantizar( a->largura ) == quantizar( b->largura ) && quantizar( a->altura ) == quantizar( b->altura );
+}
+
+static bool lixoIgual( const SnapshotLixo *a, const SnapshotLixo *b ) {
+    if ( a->ativo != b->ativo ) {
+        return false;
+    }
+    return !a->ativo || ( a->tipo == b->tipo && quantizar( a->x ) == quantizar( b->x ) && quantizar( a->y ) == quantizar( b->y ) );
+}
+
+int SnapshotEscrever( uint8_t *dados, int capacidade, const Snapshot *snapshot, const Snapshot *base ) {
+
+    EscritorBits e = { dados, capacidade, 0, 0, 0, false };
+    const SnapshotLixo inativo = { 0, 0, 0, false };
+
+    if ( snapshot->estado < 0 || snapshot->estado >= SNAPSHOT_NUM_ESTADOS ) {
+        return -1;
+    }
+    escreverBits( &e, SNAPSHOT_VERSAO, 8 );
+    escreverBits( &e, snapshot->tick, 32 );
+    escreverBits( &e, base != NULL, 1 );
+    if ( base != NULL ) {
+        escreverBits( &e, base->tick, 32 );
+    }
+    escreverBits( &e, snapshot->ultimaEntrada, 32 );
+    escreverBits( &e, (uint32_t)snapshot->estado, 2 );
+    float decimos = snapshot->tempoRestante * 10.0f + 0.5f;
+    escreverBits( &e, decimos < 0 ? 0 : decimos > 4095.0f ? 4095 : (uint32_t)decimos, 12 );
+
+    escreverBits( &e, (uint32_t)snapshot->numJogadores, 3 );
+    for ( int j = 0; j < snapshot->numJogadores; j++ ) {
+        const SnapshotJogador *jogador = &snapshot->jogadores[j];
+        if ( base != NULL && j < base->numJogadores ) {
+            const SnapshotJogador *anterior = &base->jogadores[j];
+            escreverDelta( &e, quantizar( jogador->x ) - quantizar( anterior->x ) );
+            escreverDelta( &e, quantizar( jogador->y ) - quantizar( anterior->y ) );
+            escreverDelta( &e, jogador->pontuacao - anterior->pontuacao );
+            uint32_t xor = flagsJogador( jogador ) ^ flagsJogador( anterior );
+            escreverBits( &e, xor != 0, 1 );
+            if ( xor != 0 ) {
+                escreverBits( &e, xor, 7 );
+            }
+        } else {
+            escreverBits( &e, (uint32_t)quantizar( jogador->x ), 16 );
+            escreverBits( &e, (uint32_t)quantizar( jogador->y ), 16 );
+            escreverDelta( &e, jogador->pontuacao );
+            escreverBits( &e, flagsJogador( jogador ), 7 );
+        }
+    }
+
+    escreverBits( &e, (uint32_t)snapshot->numLixeiras, 3 );
+    for ( int i = 0; i < snapshot->numLixeiras; i++ ) {
+        const SnapshotLixeira *lixeira = &snapshot->lixeiras[i];
+        bool mudou = base == NULL || i >= base->numLixeiras || !lixeiraIgual( lixeira, &base->lixeiras[i] );
+        escreverBits( &e, mudou, 1 );
+        if ( mudou ) {
+            escreverBits( &e, (uint32_t)quantizar( lixeira->x ), 16 );
+            escreverBits( &e, (uint32_t)quantizar( lixeira->y ), 16 );
+            escreverBits( &e, (uint32_t)quantizar( lixeira->largura ), 16 );
+            escreverBits( &e, (uint32_t)quantizar( lixeira->altura ), 16 );
+            escreverBits( &e, (uint32_t)lixeira->tipo, 3 );
+        }
+    }
+
+    escreverBits( &e, (uint32_t)snapshot->numLixos, 32 );
+    for ( int i = 0; i < snapshot->numLixos && !e.erro; i++ ) {
+        const SnapshotLixo *lixo = &snapshot->lixos[i];
+        const SnapshotLixo *anterior = base != NULL && i < base->numLixos ? &base->lixos[i] : &inativo;
+        if ( lixoIgual( lixo, anterior ) ) {
+            escreverBits( &e, 0, 1 );
+            continue;
+        }
+        escreverBits( &e, lixo->ativo ? 3 : 1, 2 ); // mudou + ativo
+        if ( !lixo->ativo ) {
+            continue;
+        }
+        if ( anterior->ativo ) {
+            // continua no mapa: quase sempre só andou um pouco
+            escreverBits( &e, lixo->tipo != anterior->tipo, 1 );
+            if ( lixo->tipo != anterior->tipo ) {
+                escreverBits( &e, (uint32_t)lixo->tipo, 3 );
+            }
+            escreverDelta( &e, quantizar( lixo->x ) - quantizar( anterior->x ) );
+            escreverDelta( &e, quantizar( lixo->y ) - quantizar( anterior->y ) );
+        } else {
+            escreverBits( &e, (uint32_t)lixo->tipo, 3 );
+            escreverBits( &e, (uint32_t)quantizar( lixo->x ), 16 );
+            escreverBits( &e, (uint32_t)quantizar( lixo->y ), 16 );
+        }
+    }
+
+    return terminarEscrita( &e );
+
+}
+
+uint32_t SnapshotTickBase( const uint8_t *dados, int tamanho ) {
+    LeitorBits l = { dados, tamanho, 0, 0, 0, false };
+    lerBits( &l, 8 );
+    lerBits( &l, 32 );
+    uint32_t tick = lerBits( &l, 1 ) ? lerBits( &l, 32 ) : 0;
+    return l.erro ? 0 : tick;
+}
+
+bool SnapshotLer( const uint8_t *dados, int tamanho, const Snapshot *base, Snapshot *snapshot ) {
+
+    LeitorBits l = { dados, tamanho, 0, 0, 0, false };
+    const SnapshotLixo inativo = { 0, 0, 0, false };
+
+    if ( lerBits( &l, 8 ) != SNAPSHOT_VERSAO ) {
+        return false;
+    }
+    snapshot->tick = lerBits( &l, 32 );
+    if ( lerBits( &l, 1 ) ) {
+        if ( base == NULL || lerBits( &l, 32 ) != base->tick ) {
+            return false;
+        }
+    } else {
+        base = NULL;
+    }
+    snapshot->ultimaEntrada = lerBits( &l, 32 );
+    snapshot->estado = (int)lerBits( &l, 2 );
+    snapshot->tempoRestante = lerBits( &l, 12 ) / 10.0f;
+
+    snapshot->numJogadores = (int)lerBits( &l, 3 );
+    if ( snapshot->numJogadores > SNAPSHOT_MAX_JOGADORES ) {
+        return false;
+    }
+    for ( int j = 0; j < snapshot->numJogadores; j++ ) {
+        SnapshotJogador *jogador = &snapshot->jogadores[j];
+        uint32_t flags;
+        if ( base != NULL && j < base->numJogadores ) {
+            const SnapshotJogador *anterior = &base->jogadores[j];
+            jogador->x = desquantizar( quantizar( anterior->x ) + lerDelta( &l ) );
+            jogador->y = desquantizar( quantizar( anterior->y ) + lerDelta( &l ) );
+            jogador->pontuacao = anterior->pontuacao + lerDelta( &l );
+            flags = flagsJogador( anterior );
+            if ( lerBits( &l, 1 ) ) {
+                flags ^= lerBits( &l, 7 );
+            }
+        } else {
+            jogador->x = desquantizar( (int32_t)lerBits( &l, 16 ) );
+            jogador->y = desquantizar( (int32_t)lerBits( &l, 16 ) );
+            jogador->pontuacao = lerDelta( &l );
+            flags = lerBits( &l, 7 );
+        }
+        jogador->tipoLixo = (int)( flags & 7 );
+        if ( jogador->tipoLixo > SNAPSHOT_SEM_LIXO ) {
+            return false;
+        }
+        jogador->quadro = (int)( ( flags >> 3 ) & 3 );
+        jogador->virado = ( flags >> 5 ) & 1;
+        jogador->movendo = ( flags >> 6 ) & 1;
+    }
+
+    snapshot->numLixeiras = (int)lerBits( &l, 3 );
+    for ( int i = 0; i < snapshot->numLixeiras; i++ ) {
+        SnapshotLixeira *lixeira = &snapshot->lixeiras[i];
+        if ( !lerBits( &l, 1 ) ) {
+            if ( base == NULL || i >= base->numLixeiras ) {
+                return false;
+            }
+            *lixeira = base->lixeiras[i];
+            continue;
+        }
+        lixeira->x = desquantizar( (int32_t)lerBits( &l, 16 ) );
+        lixeira->y = desquantizar( (int32_t)lerBits( &l, 16 ) );
+        lixeira->largura = desquantizar( (int32_t)lerBits( &l, 16 ) );
+        lixeira->altura = desquantizar( (int32_t)lerBits( &l, 16 ) );
+        lixeira->tipo = (int)lerBits( &l, 3 );
+        if ( lixeira->tipo > SNAPSHOT_MAX_TIPO ) {
+            return false;
+        }
+    }
+
+    uint32_t numLixos = lerBits( &l, 32 );
+    if ( l.erro || numLixos > (uint32_t)snapshot->capacidadeLixos ) {
+        return false;
+    }
+    snapshot->numLixos = (int)numLixos;
+    for ( int i = 0; i < snapshot->numLixos && !l.erro; i++ ) {
+        SnapshotLixo *lixo = &snapshot->lixos[i];
+        const SnapshotLixo *anterior = base != NULL && i < base->numLixos ? &base->lixos[i] : &inativo;
+        if ( !lerBits( &l, 1 ) ) {
+            *lixo = *anterior;
+            continue;
+        }
+        lixo->ativo = lerBits( &l, 1 );
+        if ( !lixo->ativo ) {
+            *lixo = inativo;
+        } else if ( anterior->ativo ) {
+            lixo->tipo = lerBits( &l, 1 ) ? (int)lerBits( &l, 3 ) : anterior->tipo;
+            lixo->x = desquantizar( quantizar( anterior->x ) + lerDelta( &l ) );
+            lixo->y = desquantizar( quantizar( anterior->y ) + lerDelta( &l ) );
+        } else {
+            lixo->tipo = (int)lerBits( &l, 3 );
+            lixo->x = desquantizar( (int32_t)lerBits( &l, 16 ) );
+            lixo->y = desquantizar( (int32_t)lerBits( &l, 16 ) );
+        }
+        if ( lixo->tipo > SNAPSHOT_MAX_TIPO ) {
+            return false;
+        }
+    }
+
+    return !l.erro;
+
+}
@@ -0,0 +1,448 @@
+/**
+ * @file streaming.c
+ * @brief Leitura do mapa em chunks, thread de decodificação e cache LRU de
+ * texturas do fundo do oceano.
+ * @copyright Copyright (c) 2025
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+
+#include "raylib/raylib.h"
+
+#include "streaming.h"
+#include "memoria.h"
+
+// cor usada enquanto o chunk ainda não foi carregado
+#define COR_OCEANO (Color){ 18, 74, 112, 255 }
+
+/**
+ * @brief Lê o arquivo de mapa (formato texto descrito em
+ * resources/mapa/oceano.txt). Retorna false se algo estiver faltando.
+ */
+static bool lerMapa( Streaming *stream, const char *arquivoMapa ) {
+
+    FILE *arquivo = fopen( arquivoMapa, "r" );
+    if ( arquivo == NULL ) {
+        TraceLog( LOG_WARNING, "STREAMING: mapa %s nao encontrado", arquivoMapa );
+        return false;
+    }
+
+    char linha[512];
+    int versao = 0;
+    int lidos = 0;
+    int total = 0;
+    bool valido = true;
+
+    while ( fgets( linha, sizeof(linha), arquivo ) != NULL ) {
+
+        char *texto = linha;
+        while ( *texto == ' ' || *texto == '\t' ) {
+            texto++;
+        }
+        if ( *texto == '#' || *texto == '\n' || *texto == '\r' || *texto == '\0' ) {
+            continue;
+        }
+
+        if ( sscanf( texto, "OGMAPA %d", &versao ) == 1 ) {
+            continue;
+        }
+        if ( sscanf( texto, "chunk %d", &stream->tamanhoChunk ) == 1 ) {
+            continue;
+        }
+        if ( sscanf( texto, "tamanho %d %d", &stream->colunas, &stream->linhas ) == 2 ) {
+            // um segundo tamanho mudaria a grade no meio das variacoes
+            if ( stream->variacoes != NULL || stream->colunas <= 0 || stream->linhas <= 0 ) {
+                valido = false;
+                break;
+            }
+            total = stream->colunas * stream->linhas;
+            stream->variacoes = (unsigned char*)MemoriaZerada( MEMORIA_STREAMING, total, 1 );
+            continue;
+        }
+        if ( strncmp( texto, "imagem ", 7 ) == 0 ) {
+            if ( stream->quantidadeImagens < STREAMING_MAX_IMAGENS ) {
+                char *destino = stream->imagens[stream->quantidadeImagens++];
+                sscanf( texto + 7, "%255s", destino );
+            }
+            continue;
+        }
+
+        // linha de variações dos chunks
+        char *fim;
+        long valor = strtol( texto, &fim, 10 );
+        while ( fim != texto && lidos < total ) {
+            // a janela 3 passaria do fim da imagem de origem
+            if ( valor < 0 || valor > 63 || ( ( valor >> 2 ) & 3 ) == 3 ) {
+                valido = false;
+                break;
+            }
+            stream->variacoes[lidos++] = (unsigned char)valor;
+            texto = fim;
+            valor = strtol( texto, &fim, 10 );
+        }
+
+    }
+
+    fclose( arquivo );
+
+    if ( !valido || versao != 1 || stream->tamanhoChunk <= 0 || total <= 0 ||
+         stream->quantidadeImagens == 0 || lidos != total ) {
+        TraceLog( LOG_WARNING, "STREAMING: mapa %s invalido", arquivoMapa );
+        return false;
+    }
+
+    return true;
+
+}
+
+/**
+ * @brief Monta a imagem de um chunk a partir da imagem de origem. Roda na
+ * thread de fundo, então só usa funções de imagem (CPU) da raylib.
+ */
+static Image decodificarChunk( Streaming *stream, Image *origens, int chunk ) {
+
+    unsigned char variacao = stream->variacoes[chunk];
+    int indiceImagem = ( variacao >> 4 ) & 3;
+    if ( indiceImagem >= stream->quantidadeImagens ) {
+        indiceImagem = 0;
+    }
+
+    Image *origem = &origens[indiceImagem];
+    if ( origem->data == NULL ) {
+        *origem = LoadImage( stream->imagens[indiceImagem] );
+        if ( origem->data == NULL ) {
+            return GenImageColor( stream->tamanhoChunk, stream->tamanhoChunk, COR_OCEANO );
+        }
+    }
+
+    // janela quadrada deslizando sobre a imagem de origem
+    int lado = origem->width < origem->height ? origem->width : origem->height;
+    int folga = ( origem->width > origem->height ? origem->width : origem->height ) - lado;
+    int deslocamento = folga * ( ( variacao >> 2 ) & 3 ) / 2;
+    Rectangle janela = { 0, 0, lado, lado };
+    if ( origem->width > origem->height ) {
+        janela.x = deslocamento;
+    } else {
+        janela.y = deslocamento;
+    }
+
+    Image imagem = ImageFromImage( *origem, janela );
+    ImageResize( &imagem, stream->tamanhoChunk, stream->tamanhoChunk );
+    if ( variacao & 1 ) {
+        ImageFlipHorizontal( &imagem );
+    }
+    if ( variacao & 2 ) {
+        ImageFlipVertical( &imagem );
+    }
+
+    return imagem;
+
+}
+
+static void trabalhar( void *dados ) {
+
+    Streaming *stream = (Streaming*)dados;
+    Image origens[STREAMING_MAX_IMAGENS] = { 0 };
+
+    MutexTravar( stream->mutex );
+
+    while ( true ) {
+
+        while ( !stream->encerrar && stream->quantidadePedidos == 0 ) {
+            CondEsperar( stream->temTrabalho, stream->mutex );
+        }
+        if ( stream->encerrar ) {
+            break;
+        }
+
+        // o primeiro pedido é o mais urgente
+        int chunk = stream->pedidos[0];
+        stream->quantidadePedidos--;
+        memmove( stream->pedidos, stream->pedidos + 1, sizeof(int) * stream->quantidadePedidos );
+
+        MutexDestravar( stream->mutex );
+        Image imagem = decodificarChunk( stream, origens, chunk );
+        MutexTravar( stream->mutex );
+
+        while ( !stream->encerrar && stream->quantidadeProntos == STREAMING_MAX_PRONTOS ) {
+            CondEsperar( stream->temEspaco, stream->mutex );
+        }
+        if ( stream->encerrar ) {
+            UnloadImage( imagem );
+            break;
+        }
+        stream->prontos[stream->quantidadeProntos++] = (ChunkDecodificado){ chunk, imagem };
+
+    }
+
+    MutexDestravar( stream->mutex );
+
+    for ( int i = 0; i < STREAMING_MAX_IMAGENS; i++ ) {
+        if ( origens[i].data != NULL ) {
+            UnloadImage( origens[i] );
+        }
+    }
+
+}
+
+void StreamingCarregar( Streaming *stream, const char *arquivoMapa, int largura, int altura ) {
+
+    memset( stream, 0, sizeof(Streaming) );
+
+    if ( !lerMapa( stream, arquivoMapa ) ) {
+        MemoriaLiberar( stream->variacoes );
+        stream->variacoes = NULL;
+        return;
+    }
+
+    if ( stream->colunas * stream->tamanhoChunk != largura ||
+         stream->linhas * stream->tamanhoChunk != altura ) {
+        TraceLog( LOG_WARNING, "STREAMING: mapa %s nao cobre %dx%d", arquivoMapa, largura, altura );
+        MemoriaLiberar( stream->variacoes );
+        stream->variacoes = NULL;
+        return;
+    }
+
+    int total = stream->colunas * stream->linhas;
+    stream->slotCache = (int*)MemoriaAlocar( MEMORIA_STREAMING, sizeof(int) * total );
+    for ( int i = 0; i < total; i++ ) {
+        stream->slotCache[i] = CHUNK_AUSENTE;
+    }
+
+    stream->mutex = MutexCriar();
+    stream->temTrabalho = CondCriar();
+    stream->temEspaco = CondCriar();
+    stream->thread = ThreadCriar( trabalhar, stream );
+    stream->valido = stream->thread != NULL;
+
+}
+
+void StreamingDescarregar( Streaming *stream ) {
+
+    if ( stream->thread != NULL ) {
+        MutexTravar( stream->mutex );
+        stream->encerrar = true;
+        CondSinalizarTodos( stream->temTrabalho );
+        CondSinalizarTodos( stream->temEspaco );
+        MutexDestravar( stream->mutex );
+        ThreadAguardar( stream->thread );
+    }
+
+    for ( int i = 0; i < stream->quantidadeProntos; i++ ) {
+        UnloadImage( stream->prontos[i].imagem );
+    }
+    for ( int i = 0; i < stream->quantidadeCache; i++ ) {
+        UnloadTexture( stream->cache[i].textura );
+    }
+
+    if ( stream->mutex != NULL ) {
+        CondDestruir( stream->temTrabalho );
+        CondDestruir( stream->temEspaco );
+        MutexDestruir( stream->mutex );
+    }
+
+    MemoriaLiberar( stream->variacoes );
+    MemoriaLiberar( stream->slotCache );
+    memset( stream, 0, sizeof(Streaming) );
+
+}
+
+/**
+ * @brief Coloca a imagem no cache, despejando o chunk usado há mais tempo.
+ * Chunks pedidos neste quadro nunca são despejados.
+ */
+static void residir( Streaming *stream, int chunk, Image imagem ) {
+
+    int slot = -1;
+
+    if ( stream->quantidadeCache < STREAMING_MAX_CACHE ) {
+        slot = stream->quantidadeCache++;
+    } else {
+        for ( int i = 0; i < stream->quantidadeCache; i++ ) {
+            if ( stream->cache[i].ultimoUso != stream->quadro &&
+                 ( slot == -1 || stream->cache[i].ultimoUso < stream->cache[slot].ultimoUso ) ) {
+                slot = i;
+            }
+        }
+        if ( slot == -1 ) {
+            stream->slotCache[chunk] = CHUNK_AUSENTE;
+            return;
+        }
+        UnloadTexture( stream->cache[slot].textura );
+        stream->slotCache[stream->cache[slot].chunk] = CHUNK_AUSENTE;
+    }
+
+    Texture2D textura = LoadTextureFromImage( imagem );
+    SetTextureFilter( textura, TEXTURE_FILTER_BILINEAR );
+
+    stream->cache[slot] = (ChunkResidente){ chunk, textura, stream->quadro };
+    stream->slotCache[chunk] = slot;
+
+}
+
+/**
+ * @brief Acrescenta em desejados os chunks da área que ainda não estão lá.
+ */
+static int desejarArea( Streaming *stream, Rectangle area, int *desejados, int quantidade ) {
+
+    int cx0 = (int)floorf( area.x / stream->tamanhoChunk );
+    int cy0 = (int)floorf( area.y / stream->tamanhoChunk );
+    int cx1 = (int)floorf( ( area.x + area.width ) / stream->tamanhoChunk );
+    int cy1 = (int)floorf( ( area.y + area.height ) / stream->tamanhoChunk );
+
+    if ( cx0 < 0 ) cx0 = 0;
+    if ( cy0 < 0 ) cy0 = 0;
+    if ( cx1 >= stream->colunas ) cx1 = stream->colunas - 1;
+    if ( cy1 >= stream->linhas ) cy1 = stream->linhas - 1;
+
+    for ( int cy = cy0; cy <= cy1; cy++ ) {
+        for ( int cx = cx0; cx <= cx1; cx++ ) {
+
+            int chunk = cy * stream->colunas + cx;
+            bool repetido = false;
+            for ( int i = 0; i < quantidade && !repetido; i++ ) {
+                repetido = desejados[i] == chunk;
+            }
+
+            if ( !repetido && quantidade < STREAMING_MAX_CACHE ) {
+                desejados[quantidade++] = chunk;
+            }
+
+        }
+    }
+
+    return quantidade;
+
+}
+
+void StreamingAtualizar( Streaming *stream, Rectangle visivel, Vector2 velocidade ) {
+
+    if ( !stream->valido ) {
+        return;
+    }
+
+    stream->quadro++;
+
+    // prioridade: área visível, anel de um chunk ao redor e caminho à frente
+    int desejados[STREAMING_MAX_CACHE];
+    int quantidade = 0;
+    float margem = (float)stream->tamanhoChunk;
+    Rectangle anel = { visivel.x - margem, visivel.y - margem, visivel.width + 2 * margem, visivel.height + 2 * margem };
+    Rectangle frente = visivel;
+    frente.x += velocidade.x * STREAMING_PREFETCH_SEGUNDOS;
+    frente.y += velocidade.y * STREAMING_PREFETCH_SEGUNDOS;
+
+    quantidade = desejarArea( stream, visivel, desejados, quantidade );
+    quantidade = desejarArea( stream, frente, desejados, quantidade );
+    quantidade = desejarArea( stream, anel, desejados, quantidade );
+
+    for ( int i = 0; i < quantidade; i++ ) {
+        int slot = stream->slotCache[desejados[i]];
+        if ( slot >= 0 ) {
+            stream->cache[slot].ultimoUso = stream->quadro;
+        }
+    }
+
+    // pega alguns chunks prontos; o resto fica para os próximos quadros
+    ChunkDecodificado recebidos[STREAMING_UPLOADS_POR_QUADRO];
+    int quantidadeRecebidos = 0;
+
+    MutexTravar( stream->mutex );
+
+    while ( quantidadeRecebidos < STREAMING_UPLOADS_POR_QUADRO && stream->quantidadeProntos > 0 ) {
+        recebidos[quantidadeRecebidos++] = stream->prontos[0];
+        stream->quantidadeProntos--;
+        memmove( stream->prontos, stream->prontos + 1, sizeof(ChunkDecodificado) * stream->quantidadeProntos );
+    }
+    if ( quantidadeRecebidos > 0 ) {
+        CondSinalizar( stream->temEspaco );
+    }
+
+    // refaz a fila de pedidos; o que saiu da fila volta a ser ausente
+    for ( int i = 0; i < stream->quantidadePedidos; i++ ) {
+        stream->slotCache[stream->pedidos[i]] = CHUNK_AUSENTE;
+    }
+    stream->quantidadePedidos = 0;
+    for ( int i = 0; i < quantidade && stream->quantidadePedidos < STREAMING_MAX_PEDIDOS; i++ ) {
+        if ( stream->slotCache[desejados[i]] == CHUNK_AUSENTE ) {
+            stream->pedidos[stream->quantidadePedidos++] = desejados[i];
+            stream->slotCache[desejados[i]] = CHUNK_PEDIDO;
+        }
+    }
+    if ( stream->quantidadePedidos > 0 ) {
+        CondSinalizar( stream->temTrabalho );
+    }
+
+    MutexDestravar( stream->mutex );
+
+    for ( int i = 0; i < quantidadeRecebidos; i++ ) {
+        residir( stream, recebidos[i].chunk, recebidos[i].imagem );
+        UnloadImage( recebidos[i].imagem );
+    }
+
+}
+
+bool StreamingAguardar( Streaming *stream, Rectangle visivel, double limiteSegundos ) {
+
+    if ( !stream->valido ) {
+        return true;
+    }
+
+    double limite = PlataformaTempo() + limiteSegundos;
+    while ( true ) {
+
+        StreamingAtualizar( stream, visivel, (Vector2){ 0, 0 } );
+
+        int desejados[STREAMING_MAX_CACHE];
+        int quantidade = desejarArea( stream, visivel, desejados, 0 );
+        int residentes = 0;
+        for ( int i = 0; i < quantidade; i++ ) {
+            residentes += stream->slotCache[desejados[i]] >= 0;
+        }
+        if ( residentes == quantidade ) {
+            return true;
+        }
+        if ( PlataformaTempo() > limite ) {
+            return false;
+        }
+        PlataformaDormir( 0.001 );
+
+    }
+
+}
+
+void StreamingDesenhar( Streaming *stream, Rectangle visivel ) {
+
+    int cx0 = (int)( visivel.x / stream->tamanhoChunk );
+    int cy0 = (int)( visivel.y / stream->tamanhoChunk );
+    int cx1 = (int)( ( visivel.x + visivel.width ) / stream->tamanhoChunk );
+    int cy1 = (int)( ( visivel.y + visivel.height ) / stream->tamanhoChunk );
+
+    if ( cx0 < 0 ) cx0 = 0;
+    if ( cy0 < 0 ) cy0 = 0;
+    if ( cx1 >= stream->colunas ) cx1 = stream->colunas - 1;
+    if ( cy1 >= stream->linhas ) cy1 = stream->linhas - 1;
+
+    for ( int cy = cy0; cy <= cy1; cy++ ) {
+        for ( int cx = cx0; cx <= cx1; cx++ ) {
+
+            Rectangle dest = {
+                (float)cx * stream->tamanhoChunk, (float)cy * stream->tamanhoChunk,
+                (float)stream->tamanhoChunk, (float)stream->tamanhoChunk
+            };
+
+            int slot = stream->slotCache[cy * stream->colunas + cx];
+            if ( slot >= 0 ) {
+                Texture2D textura = stream->cache[slot].textura;
+                Rectangle source = { 0, 0, (float)textura.width, (float)textura.height };
+                DrawTexturePro( textura, source, dest, (Vector2){ 0, 0 }, 0, WHITE );
+            } else {
+                DrawRectangleRec( dest, COR_OCEANO );
+            }
+
+        }
+    }
+
+}
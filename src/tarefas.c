@@ -0,0 +1,160 @@
+/**
+ * @file tarefas.c
+ * @brief Pool de threads com distribuição dinâmica de blocos.
+ * @copyright Copyright (c) 2025
+ */
+#include <stdbool.h>
+#include <stdlib.h>
+
+#include "plataforma.h"
+#include "tarefas.h"
+#include "memoria.h"
+
+struct PoolTarefas {
+
+    PlataformaThread **threads;
+    int quantidadeThreads;
+
+    PlataformaMutex *mutex;
+    PlataformaCond *temTrabalho;
+    PlataformaCond *terminou;
+
+    // laço atual (protegido pelo mutex)
+    FuncaoIntervalo funcao;
+    void *contexto;
+    int total;
+    int bloco;
+    int proximo;
+    int concluidos;
+    unsigned int geracao;
+    bool encerrar;
+
+};
+
+/**
+ * @brief Pega blocos até acabar o laço. Deve ser chamada com o mutex
+ * travado e retorna com ele travado.
+ */
+static void executarBlocos( PoolTarefas *pool ) {
+
+    while ( pool->proximo < pool->total ) {
+
+        int inicio = pool->proximo;
+        int fim = inicio + pool->bloco < pool->total ? inicio + pool->bloco : pool->total;
+        pool->proximo = fim;
+
+        MutexDestravar( pool->mutex );
+        pool->funcao( pool->contexto, inicio, fim );
+        MutexTravar( pool->mutex );
+
+        pool->concluidos += fim - inicio;
+        if ( pool->concluidos == pool->total ) {
+            CondSinalizarTodos( pool->terminou );
+        }
+
+    }
+
+}
+
+static void trabalhar( void *dados ) {
+
+    PoolTarefas *pool = (PoolTarefas*)dados;
+    unsigned int geracaoVista = 0;
+
+    MutexTravar( pool->mutex );
+    while ( true ) {
+        while ( !pool->encerrar && pool->geracao == geracaoVista ) {
+            CondEsperar( pool->temTrabalho, pool->mutex );
+        }
+        if ( pool->encerrar ) {
+            break;
+        }
+        geracaoVista = pool->geracao;
+        executarBlocos( pool );
+    }
+    MutexDestravar( pool->mutex );
+
+}
+
+PoolTarefas *PoolTarefasCriar( int trabalhadores ) {
+
+    PoolTarefas *pool = (PoolTarefas*)MemoriaZerada( MEMORIA_TAREFAS, 1, sizeof(PoolTarefas) );
+    pool->mutex = MutexCriar();
+    pool->temTrabalho = CondCriar();
+    pool->terminou = CondCriar();
+
+    if ( trabalhadores > 0 ) {
+        pool->threads = (PlataformaThread**)MemoriaAlocar( MEMORIA_TAREFAS, sizeof(PlataformaThread*) * trabalhadores );
+    }
+    for ( int i = 0; i < trabalhadores; i++ ) {
+        PlataformaThread *thread = ThreadCriar( trabalhar, pool );
+        if ( thread != NULL ) {
+            pool->threads[pool->quantidadeThreads++] = thread;
+        }
+    }
+
+    return pool;
+
+}
+
+void PoolTarefasDestruir( PoolTarefas *pool ) {
+
+    if ( pool == NULL ) {
+        return;
+    }
+
+    MutexTravar( pool->mutex );
+    pool->encerrar = true;
+    CondSinalizarTodos( pool->temTrabalho );
+    MutexDestravar( pool->mutex );
+
+    for ( int i = 0; i < pool->quantidadeThreads; i++ ) {
+        ThreadAguardar( pool->threads[i] );
+    }
+
+    CondDestruir( pool->temTrabalho );
+    CondDestruir( pool->terminou );
+    MutexDestruir( pool->mutex );
+    MemoriaLiberar( pool->threads );
+    MemoriaLiberar( pool );
+
+}
+
+int PoolTarefasThreads( const PoolTarefas *pool ) {
+    return pool == NULL ? 1 : pool->quantidadeThreads + 1;
+}
+
+void ParaleloPara( PoolTarefas *pool, int total, int bloco, FuncaoIntervalo funcao, void *contexto ) {
+
+    if ( total <= 0 ) {
+        return;
+    }
+    if ( bloco <= 0 ) {
+        bloco = total;
+    }
+
+    // sem threads auxiliares ou com um bloco só, não vale acordar ninguém
+    if ( pool == NULL || pool->quantidadeThreads == 0 || total <= bloco ) {
+        funcao( contexto, 0, total );
+        return;
+    }
+
+    MutexTravar( pool->mutex );
+
+    pool->funcao = funcao;
+    pool->contexto = contexto;
+    pool->total = total;
+    pool->bloco = bloco;
+    pool->proximo = 0;
+    pool->concluidos = 0;
+    pool->geracao++;
+    CondSinalizarTodos( pool->temTrabalho );
+
+    executarBlocos( pool );
+    while ( pool->concluidos < pool->total ) {
+        CondEsperar( pool->terminou, pool->mutex );
+    }
+
+    MutexDestravar( pool->mutex );
+
+}
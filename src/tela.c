@@ -0,0 +1,125 @@
+/**
+ * @file tela.c
+ * @brief Tela virtual: viewport, RenderTexture e conversão de coordenadas.
+ * @copyright Copyright (c) 2025
+ */
+#include <math.h>
+
+#include "tela.h"
+#include "raylib/rlgl.h"
+
+static Rectangle calcularDestino( const TelaVirtual *tela ) {
+
+    float larguraJanela = (float)GetScreenWidth();
+    float alturaJanela = (float)GetScreenHeight();
+    float fator = fminf( larguraJanela / tela->largura, alturaJanela / tela->altura );
+    if ( fator >= 1.0f ) {
+        fator = floorf( fator );
+    }
+
+    float largura = tela->largura * fator;
+    float altura = tela->altura * fator;
+    return (Rectangle){
+        floorf( ( larguraJanela - largura ) / 2 ), floorf( ( alturaJanela - altura ) / 2 ), largura, altura
+    };
+
+}
+
+static void projetar( float largura, float altura ) {
+    rlMatrixMode( RL_PROJECTION );
+    rlLoadIdentity();
+    rlOrtho( 0, largura, altura, 0, 0.0, 1.0 );
+    rlMatrixMode( RL_MODELVIEW );
+    rlLoadIdentity();
+}
+
+void TelaVirtualCriar( TelaVirtual *tela, int largura, int altura ) {
+    *tela = (TelaVirtual){ 0 };
+    tela->largura = largura;
+    tela->altura = altura;
+}
+
+void TelaVirtualDefinirEscala( TelaVirtual *tela, float escala ) {
+
+    if ( tela->alvo.id != 0 ) {
+        UnloadRenderTexture( tela->alvo );
+        tela->alvo = (RenderTexture2D){ 0 };
+    }
+    tela->escala = escala > 0 ? escala : 0;
+    if ( tela->escala > 0 ) {
+        tela->alvo = LoadRenderTexture( (int)( tela->largura * escala ), (int)( tela->altura * escala ) );
+        tela->filtro = TEXTURE_FILTER_POINT;
+        SetTextureFilter( tela->alvo.texture, tela->filtro );
+    }
+
+}
+
+void TelaVirtualDestruir( TelaVirtual *tela ) {
+    TelaVirtualDefinirEscala( tela, 0 );
+}
+
+void TelaVirtualComecar( TelaVirtual *tela ) {
+
+    tela->destino = calcularDestino( tela );
+    ClearBackground( BLACK ); // faixas
+
+    if ( tela->alvo.id != 0 ) {
+        // múltiplo inteiro exato fica nítido; o resto é interpolado
+        int filtro = fmodf( tela->destino.width, (float)tela->alvo.texture.width ) == 0
+                     ? TEXTURE_FILTER_POINT : TEXTURE_FILTER_BILINEAR;
+        if ( filtro != tela->filtro ) {
+            tela->filtro = filtro;
+            SetTextureFilter( tela->alvo.texture, filtro );
+        }
+        BeginTextureMode( tela->alvo );
+        projetar( (float)tela->largura, (float)tela->altura );
+        return;
+    }
+
+    // direto na janela: o viewport e a tesoura (para o ClearBackground)
+    // ficam no destino; o OpenGL conta y de baixo para cima
+    float rx = (float)GetRenderWidth() / GetScreenWidth();
+    float ry = (float)GetRenderHeight() / GetScreenHeight();
+    int x = (int)( tela->destino.x * rx );
+    int y = (int)( ( GetScreenHeight() - tela->destino.y - tela->destino.height ) * ry );
+    int largura = (int)( tela->destino.width * rx );
+    int altura = (int)( tela->destino.height * ry );
+    rlDrawRenderBatchActive();
+    rlViewport( x, y, largura, altura );
+    rlEnableScissorTest();
+    rlScissor( x, y, largura, altura );
+    projetar( (float)tela->largura, (float)tela->altura );
+
+}
+
+void TelaVirtualTerminar( TelaVirtual *tela ) {
+
+    if ( tela->alvo.id != 0 ) {
+        EndTextureMode();
+        // copia sem mistura: o alfa do alvo não é o da tela
+        Rectangle origem = { 0, 0, (float)tela->alvo.texture.width, -(float)tela->alvo.texture.height };
+        rlDisableColorBlend();
+        DrawTexturePro( tela->alvo.texture, origem, tela->destino, (Vector2){ 0, 0 }, 0, WHITE );
+        rlDrawRenderBatchActive();
+        rlEnableColorBlend();
+        return;
+    }
+
+    rlDrawRenderBatchActive();
+    rlDisableScissorTest();
+    rlViewport( 0, 0, GetRenderWidth(), GetRenderHeight() );
+    projetar( (float)GetScreenWidth(), (float)GetScreenHeight() );
+
+}
+
+Vector2 TelaVirtualPonto( const TelaVirtual *tela, Vector2 janela ) {
+
+    if ( tela->destino.width <= 0 || tela->destino.height <= 0 ) {
+        return janela;
+    }
+    return (Vector2){
+        ( janela.x - tela->destino.x ) * tela->largura / tela->destino.width,
+        ( janela.y - tela->destino.y ) * tela->altura / tela->destino.height
+    };
+
+}
@@ -0,0 +1,436 @@
+/**
+ * @file eventos_analise.c
+ * @brief Estatísticas agregadas de muitos logs de eventos: partidas,
+ * distribuição da pontuação final, tempo até a vitória, coletas, matriz de
+ * confusão entre tipo de lixo e lixeira, e tempo de quadro.
+ *
+ * Os arquivos são mapeados na memória. Primeiro os cabeçalhos dos lotes são
+ * percorridos (um salto por lote) para dividir cada arquivo em trechos de
+ * tamanho parecido; depois o pool de threads descomprime os trechos em
+ * paralelo, cada um com o seu resultado parcial, e os resultados são
+ * somados em ordem. A duração de uma partida que começa em um trecho e
+ * termina no seguinte é ligada nessa soma.
+ *
+ * uso: eventos_analise [--threads N] arquivo.bin [...]
+ * @copyright Copyright (c) 2025
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "eventos.h"
+#include "plataforma.h"
+#include "tarefas.h"
+
+// na ordem de TipoDoLixo e dos estados de main.c
+#define NUM_TIPOS_LIXO 4
+#define ESTADO_RODANDO 1
+#define ESTADO_VITORIA 2
+#define ESTADO_DERROTA 3
+static const char *NOME_LIXO[NUM_TIPOS_LIXO] = { "plastico", "vidro", "metal", "papel" };
+
+#define PONTOS_MINIMO -1000
+#define PONTOS_FAIXA 50
+#define NUM_FAIXAS_PONTOS 100 // de -1000 a 4000
+#define NUM_SEGUNDOS 600      // tempo até a vitória, de segundo em segundo
+#define NUM_FAIXAS_QUADRO 500 // tempo de quadro, de 0,1 em 0,1 ms
+#define TRECHOS_POR_THREAD 8
+#define TRECHO_MINIMO ( 1 << 20 ) // bytes
+
+typedef enum Inicio {
+    INICIO_DESCONHECIDO, // o trecho ainda não viu abertura nem início de partida
+    INICIO_NENHUM,
+    INICIO_ABERTO
+} Inicio;
+
+typedef struct Resultado {
+
+    long long eventos;
+    long long lotesCorrompidos;
+    long long partidas;
+    long long vitorias;
+    long long derrotas;
+    long long coletas[NUM_TIPOS_LIXO];
+    long long descartes[NUM_TIPOS_LIXO][NUM_TIPOS_LIXO]; // [lixo][lixeira]
+    long long pontos[NUM_FAIXAS_PONTOS];
+    double somaPontos;
+    long long duracao[NUM_SEGUNDOS];
+    double somaDuracao;
+    long long vitoriasMedidas;
+    long long quadros;
+    long long quadroMs[NUM_FAIXAS_QUADRO];
+
+    // para ligar partidas que cruzam trechos
+    Inicio inicio;     // ao fim do trecho
+    uint64_t tempoInicio;
+    bool fimPendente;  // vitória antes de qualquer início no trecho
+    uint64_t tempoFimPendente;
+
+} Resultado;
+
+typedef struct Arquivo {
+    const char *nome;
+    const uint8_t *dados;
+    size_t tamanho;
+    size_t *lotes; // posição de cada lote
+    int numLotes;
+    bool corrompido;
+} Arquivo;
+
+typedef struct Trecho {
+    const Arquivo *arquivo;
+    int primeiroLote;
+    int fimLote;
+    Resultado *resultado;
+} Trecho;
+
+static void indexarArquivos( void *contexto, int inicio, int fim ) {
+
+    Arquivo *arquivos = (Arquivo*)contexto;
+    for ( int a = inicio; a < fim; a++ ) {
+        Arquivo *arquivo = &arquivos[a];
+        size_t pos = 0;
+        int capacidade = 1024;
+        arquivo->lotes = (size_t*)malloc( sizeof(size_t) * capacidade );
+        if ( !LogEventosLerCabecalho( arquivo->dados, arquivo->tamanho, &pos ) ) {
+            arquivo->corrompido = true;
+            continue;
+        }
+        while ( pos < arquivo->tamanho ) {
+            size_t lote = pos;
+            if ( !LogEventosPularLote( arquivo->dados, arquivo->tamanho, &pos ) ) {
+                arquivo->corrompido = true;
+                break;
+            }
+            if ( arquivo->numLotes == capacidade ) {
+                capacidade *= 2;
+                arquivo->lotes = (size_t*)realloc( arquivo->lotes, sizeof(size_t) * capacidade );
+            }
+            arquivo->lotes[arquivo->numLotes++] = lote;
+        }
+    }
+
+}
+
+static void fimDePartida( Resultado *r, const Evento *e ) {
+
+    int faixa = ( e->valor - PONTOS_MINIMO ) / PONTOS_FAIXA;
+    faixa = faixa < 0 ? 0 : faixa >= NUM_FAIXAS_PONTOS ? NUM_FAIXAS_PONTOS - 1 : faixa;
+    r->pontos[faixa]++;
+    r->somaPontos += e->valor;
+    if ( e->b == ESTADO_VITORIA ) {
+        r->vitorias++;
+    } else {
+        r->derrotas++;
+    }
+
+    if ( e->b == ESTADO_VITORIA && r->inicio == INICIO_ABERTO ) {
+        double segundos = ( e->tempo - r->tempoInicio ) / 1e6;
+        int s = (int)segundos;
+        r->duracao[s < NUM_SEGUNDOS ? s : NUM_SEGUNDOS - 1]++;
+        r->somaDuracao += segundos;
+        r->vitoriasMedidas++;
+    } else if ( e->b == ESTADO_VITORIA && r->inicio == INICIO_DESCONHECIDO ) {
+        r->fimPendente = true;
+        r->tempoFimPendente = e->tempo;
+    }
+    r->inicio = INICIO_NENHUM;
+
+}
+
+static void analisarTrechos( void *contexto, int inicio, int fim ) {
+
+    Trecho *trechos = (Trecho*)contexto;
+    Evento eventos[EVENTOS_LOTE];
+
+    for ( int t = inicio; t < fim; t++ ) {
+
+        const Arquivo *arquivo = trechos[t].arquivo;
+        Resultado *r = trechos[t].resultado;
+        memset( r, 0, sizeof(Resultado) );
+
+        for ( int l = trechos[t].primeiroLote; l < trechos[t].fimLote; l++ ) {
+            size_t pos = arquivo->lotes[l];
+            int n = LogEventosLerLote( arquivo->dados, arquivo->tamanho, &pos, eventos );
+            if ( n < 0 ) {
+                r->lotesCorrompidos++;
+                continue;
+            }
+            r->eventos += n;
+            for ( int i = 0; i < n; i++ ) {
+                const Evento *e = &eventos[i];
+                switch ( e->tipo ) {
+                    case EVENTO_ABERTURA:
+                        r->inicio = INICIO_NENHUM;
+                        break;
+                    case EVENTO_QUADRO: {
+                        int faixa = e->valor / 100;
+                        r->quadroMs[faixa < 0 ? 0 : faixa < NUM_FAIXAS_QUADRO ? faixa : NUM_FAIXAS_QUADRO - 1]++;
+                        r->quadros++;
+                        break;
+                    }
+                    case EVENTO_ESTADO:
+                        if ( e->b == ESTADO_RODANDO ) {
+                            r->partidas++;
+                            r->inicio = INICIO_ABERTO;
+                            r->tempoInicio = e->tempo;
+                        } else if ( e->a == ESTADO_RODANDO && ( e->b == ESTADO_VITORIA || e->b == ESTADO_DERROTA ) ) {
+                            fimDePartida( r, e );
+                        }
+                        break;
+                    case EVENTO_COLETA:
+                        if ( e->a < NUM_TIPOS_LIXO ) {
+                            r->coletas[e->a]++;
+                        }
+                        break;
+                    case EVENTO_DESCARTE:
+                        if ( e->a < NUM_TIPOS_LIXO && e->b < NUM_TIPOS_LIXO ) {
+                            r->descartes[e->a][e->b]++;
+                        }
+                        break;
+                    default:
+                        break;
+                }
+            }
+        }
+
+    }
+
+}
+
+// soma parte em total; anterior é o estado da partida no fim do trecho
+// anterior do mesmo arquivo
+static void somar( Resultado *total, const Resultado *parte, Inicio *anterior, uint64_t *tempoAnterior ) {
+
+    total->eventos += parte->eventos;
+    total->lotesCorrompidos += parte->lotesCorrompidos;
+    total->partidas += parte->partidas;
+    total->vitorias += parte->vitorias;
+    total->derrotas += parte->derrotas;
+    total->somaPontos += parte->somaPontos;
+    total->somaDuracao += parte->somaDuracao;
+    total->vitoriasMedidas += parte->vitoriasMedidas;
+    total->quadros += parte->quadros;
+    for ( int i = 0; i < NUM_TIPOS_LIXO; i++ ) {
+        total->coletas[i] += parte->coletas[i];
+        for ( int j = 0; j < NUM_TIPOS_LIXO; j++ ) {
+            total->descartes[i][j] += parte->descartes[i][j];
+        }
+    }
+    for ( int i = 0; i < NUM_FAIXAS_PONTOS; i++ ) {
+        total->pontos[i] += parte->pontos[i];
+    }
+    for ( int i = 0; i < NUM_SEGUNDOS; i++ ) {
+        total->duracao[i] += parte->duracao[i];
+    }
+    for ( int i = 0; i < NUM_FAIXAS_QUADRO; i++ ) {
+        total->quadroMs[i] += parte->quadroMs[i];
+    }
+
+    // vitória no começo deste trecho de uma partida iniciada antes dele
+    if ( parte->fimPendente && *anterior == INICIO_ABERTO ) {
+        double segundos = ( parte->tempoFimPendente - *tempoAnterior ) / 1e6;
+        int s = (int)segundos;
+        total->duracao[s < NUM_SEGUNDOS ? s : NUM_SEGUNDOS - 1]++;
+        total->somaDuracao += segundos;
+        total->vitoriasMedidas++;
+    }
+    if ( parte->fimPendente || parte->inicio != INICIO_DESCONHECIDO ) {
+        *anterior = parte->inicio == INICIO_DESCONHECIDO ? INICIO_NENHUM : parte->inicio;
+        *tempoAnterior = parte->tempoInicio;
+    }
+
+}
+
+// início da faixa do histograma onde fica a fração p das amostras
+static double percentil( const long long *histograma, int faixas, double largura, double minimo, double p ) {
+    long long total = 0;
+    for ( int i = 0; i < faixas; i++ ) {
+        total += histograma[i];
+    }
+    long long alvo = (long long)( p * total );
+    long long acumulado = 0;
+    for ( int i = 0; i < faixas; i++ ) {
+        acumulado += histograma[i];
+        if ( acumulado > alvo ) {
+            return minimo + i * largura;
+        }
+    }
+    return minimo + ( faixas - 1 ) * largura;
+}
+
+static void relatorio( const Resultado *r ) {
+
+    printf( "\npartidas: %lld (vitorias %lld, derrotas %lld, sem fim %lld)\n",
+            r->partidas, r->vitorias, r->derrotas, r->partidas - r->vitorias - r->derrotas );
+
+    long long terminadas = r->vitorias + r->derrotas;
+    if ( terminadas > 0 ) {
+        printf( "\npontuacao final da equipe: media %.0f, p10 %.0f, p50 %.0f, p90 %.0f\n",
+                r->somaPontos / terminadas,
+                percentil( r->pontos, NUM_FAIXAS_PONTOS, PONTOS_FAIXA, PONTOS_MINIMO, 0.1 ),
+                percentil( r->pontos, NUM_FAIXAS_PONTOS, PONTOS_FAIXA, PONTOS_MINIMO, 0.5 ),
+                percentil( r->pontos, NUM_FAIXAS_PONTOS, PONTOS_FAIXA, PONTOS_MINIMO, 0.9 ) );
+        // faixas de 250 pontos
+        for ( int i = 0; i < NUM_FAIXAS_PONTOS; i += 5 ) {
+            long long n = 0;
+            for ( int k = i; k < i + 5; k++ ) {
+                n += r->pontos[k];
+            }
+            if ( n > 0 ) {
+                printf( "  %5d a %5d: %8lld (%5.1f%%)\n", PONTOS_MINIMO + i * PONTOS_FAIXA,
+                        PONTOS_MINIMO + ( i + 5 ) * PONTOS_FAIXA - 1, n, 100.0 * n / terminadas );
+            }
+        }
+    }
+
+    if ( r->vitoriasMedidas > 0 ) {
+        printf( "\ntempo ate a vitoria (s, %lld vitorias): media %.1f, p10 %.0f, p50 %.0f, p90 %.0f\n",
+                r->vitoriasMedidas, r->somaDuracao / r->vitoriasMedidas,
+                percentil( r->duracao, NUM_SEGUNDOS, 1, 0, 0.1 ),
+                percentil( r->duracao, NUM_SEGUNDOS, 1, 0, 0.5 ),
+                percentil( r->duracao, NUM_SEGUNDOS, 1, 0, 0.9 ) );
+    }
+
+    printf( "\ncoletas:" );
+    for ( int i = 0; i < NUM_TIPOS_LIXO; i++ ) {
+        printf( " %s %lld%s", NOME_LIXO[i], r->coletas[i], i + 1 < NUM_TIPOS_LIXO ? "," : "\n" );
+    }
+
+    printf( "\ndescartes (linha: lixo, coluna: lixeira)\n%10s", "" );
+    for ( int j = 0; j < NUM_TIPOS_LIXO; j++ ) {
+        printf( " %10s", NOME_LIXO[j] );
+    }
+    printf( " %8s\n", "erro" );
+    for ( int i = 0; i < NUM_TIPOS_LIXO; i++ ) {
+        long long total = 0;
+        printf( "%10s", NOME_LIXO[i] );
+        for ( int j = 0; j < NUM_TIPOS_LIXO; j++ ) {
+            printf( " %10lld", r->descartes[i][j] );
+            total += r->descartes[i][j];
+        }
+        printf( " %7.1f%%\n", total > 0 ? 100.0 * ( total - r->descartes[i][i] ) / total : 0.0 );
+    }
+
+    // o erro mais comum de cada material
+    for ( int i = 0; i < NUM_TIPOS_LIXO; i++ ) {
+        long long total = 0;
+        int pior = -1;
+        for ( int j = 0; j < NUM_TIPOS_LIXO; j++ ) {
+            total += r->descartes[i][j];
+            if ( j != i && r->descartes[i][j] > 0 && ( pior < 0 || r->descartes[i][j] > r->descartes[i][pior] ) ) {
+                pior = j;
+            }
+        }
+        if ( pior >= 0 ) {
+            printf( "  %s na lixeira de %s: %lld (%.1f%% do %s)\n", NOME_LIXO[i], NOME_LIXO[pior],
+                    r->descartes[i][pior], 100.0 * r->descartes[i][pior] / total, NOME_LIXO[i] );
+        }
+    }
+
+    if ( r->quadros > 0 ) {
+        printf( "\nquadros: %lld, p50 %.1f ms, p99 %.1f ms\n", r->quadros,
+                percentil( r->quadroMs, NUM_FAIXAS_QUADRO, 0.1, 0, 0.5 ),
+                percentil( r->quadroMs, NUM_FAIXAS_QUADRO, 0.1, 0, 0.99 ) );
+    }
+
+}
+
+int main( int argc, char **argv ) {
+
+    int threads = PlataformaNucleos();
+    int primeiro = 1;
+    if ( argc > 2 && strcmp( argv[1], "--threads" ) == 0 ) {
+        threads = atoi( argv[2] );
+        threads = threads < 1 ? 1 : threads;
+        primeiro = 3;
+    }
+    if ( primeiro >= argc ) {
+        fprintf( stderr, "uso: %s [--threads N] arquivo.bin [...]\n", argv[0] );
+        return 1;
+    }
+
+    double t0 = PlataformaTempo();
+    PoolTarefas *pool = PoolTarefasCriar( threads - 1 );
+
+    int numArquivos = 0;
+    size_t bytes = 0;
+    Arquivo *arquivos = (Arquivo*)calloc( argc - primeiro, sizeof(Arquivo) );
+    for ( int a = primeiro; a < argc; a++ ) {
+        Arquivo *arquivo = &arquivos[numArquivos];
+        arquivo->nome = argv[a];
+        arquivo->dados = PlataformaMapearArquivo( argv[a], &arquivo->tamanho );
+        if ( arquivo->dados == NULL ) {
+            fprintf( stderr, "%s: nao foi possivel abrir\n", argv[a] );
+            continue;
+        }
+        bytes += arquivo->tamanho;
+        numArquivos++;
+    }
+    ParaleloPara( pool, numArquivos, 1, indexarArquivos, arquivos );
+
+    // trechos de tamanho parecido, sem cruzar arquivos
+    size_t alvo = bytes / ( (size_t)threads * TRECHOS_POR_THREAD );
+    alvo = alvo < TRECHO_MINIMO ? TRECHO_MINIMO : alvo;
+    int numTrechos = 0;
+    int capacidadeTrechos = 64;
+    long long numLotes = 0;
+    Trecho *trechos = (Trecho*)malloc( sizeof(Trecho) * capacidadeTrechos );
+    for ( int a = 0; a < numArquivos; a++ ) {
+        const Arquivo *arquivo = &arquivos[a];
+        if ( arquivo->corrompido ) {
+            fprintf( stderr, "%s: log truncado ou corrompido, usando os %d lotes inteiros\n", arquivo->nome, arquivo->numLotes );
+        }
+        numLotes += arquivo->numLotes;
+        int l = 0;
+        while ( l < arquivo->numLotes ) {
+            int fim = l + 1;
+            while ( fim < arquivo->numLotes && arquivo->lotes[fim] - arquivo->lotes[l] < alvo ) {
+                fim++;
+            }
+            if ( numTrechos == capacidadeTrechos ) {
+                capacidadeTrechos *= 2;
+                trechos = (Trecho*)realloc( trechos, sizeof(Trecho) * capacidadeTrechos );
+            }
+            trechos[numTrechos++] = (Trecho){ arquivo, l, fim, NULL };
+            l = fim;
+        }
+    }
+
+    Resultado *parciais = (Resultado*)malloc( sizeof(Resultado) * ( numTrechos > 0 ? numTrechos : 1 ) );
+    for ( int t = 0; t < numTrechos; t++ ) {
+        trechos[t].resultado = &parciais[t];
+    }
+    ParaleloPara( pool, numTrechos, 1, analisarTrechos, trechos );
+
+    Resultado *total = (Resultado*)calloc( 1, sizeof(Resultado) );
+    Inicio anterior = INICIO_NENHUM;
+    uint64_t tempoAnterior = 0;
+    for ( int t = 0; t < numTrechos; t++ ) {
+        if ( t > 0 && trechos[t].arquivo != trechos[t - 1].arquivo ) {
+            anterior = INICIO_NENHUM;
+        }
+        somar( total, &parciais[t], &anterior, &tempoAnterior );
+    }
+    double segundos = PlataformaTempo() - t0;
+
+    printf( "arquivos: %d, %.1f MiB, %lld lotes, %lld eventos", numArquivos, bytes / 1048576.0, numLotes, total->eventos );
+    if ( total->lotesCorrompidos > 0 ) {
+        printf( " (%lld lotes corrompidos ignorados)", total->lotesCorrompidos );
+    }
+    printf( "\nanalise: %.3f s, %.0f MiB/s, %d threads, %d trechos\n", segundos,
+            bytes / 1048576.0 / ( segundos > 0 ? segundos : 1e-9 ), PoolTarefasThreads( pool ), numTrechos );
+    relatorio( total );
+
+    for ( int a = 0; a < numArquivos; a++ ) {
+        PlataformaDesmapearArquivo( arquivos[a].dados, arquivos[a].tamanho );
+        free( arquivos[a].lotes );
+    }
+    free( arquivos );
+    free( trechos );
+    free( parciais );
+    free( total );
+    PoolTarefasDestruir( pool );
+    return 0;
+
+}
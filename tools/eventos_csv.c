@@ -0,0 +1,124 @@
+/**
+ * @file eventos_csv.c
+ * @brief Converte logs de eventos (eventos.bin) em CSV, uma linha por
+ * evento, para análise em planilha. Os quadros ficam de fora, a não ser com
+ * --quadros.
+ *
+ * uso: eventos_csv [--quadros] arquivo.bin [...] > eventos.csv
+ * @copyright Copyright (c) 2025
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include "eventos.h"
+
+// na ordem de TipoDoLixo e dos estados de main.c
+static const char *NOME_LIXO[] = { "plastico", "vidro", "metal", "papel", "nenhum" };
+static const char *NOME_ESTADO[] = { "menu", "jogando", "vitoria", "derrota" };
+static const char *NOME_EVENTO[NUM_TIPOS_EVENTO] = { "abertura", "quadro", "estado", "coleta", "descarte" };
+
+#define NOME( tabela, i ) ( (i) < sizeof(tabela) / sizeof(tabela[0]) ? tabela[i] : "?" )
+
+static uint8_t *lerArquivo( const char *caminho, size_t *tamanho ) {
+
+    FILE *entrada = fopen( caminho, "rb" );
+    if ( entrada == NULL ) {
+        return NULL;
+    }
+    fseek( entrada, 0, SEEK_END );
+    long fim = ftell( entrada );
+    fseek( entrada, 0, SEEK_SET );
+
+    uint8_t *dados = (uint8_t*)malloc( fim > 0 ? (size_t)fim : 1 );
+    *tamanho = fread( dados, 1, (size_t)( fim > 0 ? fim : 0 ), entrada );
+    fclose( entrada );
+    return dados;
+
+}
+
+int main( int argc, char **argv ) {
+
+    bool quadros = false;
+    int primeiro = 1;
+    if ( argc > 1 && strcmp( argv[1], "--quadros" ) == 0 ) {
+        quadros = true;
+        primeiro = 2;
+    }
+    if ( primeiro >= argc ) {
+        fprintf( stderr, "uso: %s [--quadros] arquivo.bin [...] > eventos.csv\n", argv[0] );
+        return 1;
+    }
+
+    Evento *eventos = (Evento*)malloc( sizeof(Evento) * EVENTOS_LOTE );
+    int execucao = 0;
+    int erros = 0;
+
+    printf( "arquivo,execucao,data,partida,tempo_s,evento,jogador,lixo,lixeira,certo,estado,pontos,quadro_ms\n" );
+
+    for ( int a = primeiro; a < argc; a++ ) {
+
+        size_t tamanho = 0;
+        size_t pos = 0;
+        uint8_t *dados = lerArquivo( argv[a], &tamanho );
+        if ( dados == NULL || !LogEventosLerCabecalho( dados, tamanho, &pos ) ) {
+            fprintf( stderr, "%s: nao e um log de eventos\n", argv[a] );
+            free( dados );
+            erros++;
+            continue;
+        }
+
+        char data[32] = "";
+        int partida = 0;
+        int n;
+        while ( ( n = LogEventosLerLote( dados, tamanho, &pos, eventos ) ) > 0 ) {
+            for ( int i = 0; i < n; i++ ) {
+
+                const Evento *e = &eventos[i];
+                if ( e->tipo == EVENTO_ABERTURA ) {
+                    time_t segundos = (time_t)(uint32_t)e->valor;
+                    strftime( data, sizeof(data), "%Y-%m-%d %H:%M:%S", localtime( &segundos ) );
+                    execucao++;
+                    partida = 0;
+                } else if ( e->tipo == EVENTO_ESTADO && e->b == 1 ) {
+                    partida++;
+                } else if ( e->tipo == EVENTO_QUADRO && !quadros ) {
+                    continue;
+                }
+
+                printf( "%s,%d,%s,%d,%.3f,%s,", argv[a], execucao, data, partida, e->tempo / 1e6, NOME( NOME_EVENTO, e->tipo ) );
+                switch ( e->tipo ) {
+                    case EVENTO_COLETA:
+                        printf( "%d,%s,,,,,\n", e->jogador + 1, NOME( NOME_LIXO, e->a ) );
+                        break;
+                    case EVENTO_DESCARTE:
+                        printf( "%d,%s,%s,%d,,%d,\n", e->jogador + 1, NOME( NOME_LIXO, e->a ), NOME( NOME_LIXO, e->b ),
+                                e->a == e->b, e->valor );
+                        break;
+                    case EVENTO_ESTADO:
+                        printf( ",,,,%s,%d,\n", NOME( NOME_ESTADO, e->b ), e->valor );
+                        break;
+                    case EVENTO_QUADRO:
+                        printf( ",,,,,,%.3f\n", e->valor / 1000.0 );
+                        break;
+                    default:
+                        printf( ",,,,,,\n" );
+                        break;
+                }
+
+            }
+        }
+        if ( n < 0 ) {
+            // o jogo caiu no meio de um lote: o que veio antes vale
+            fprintf( stderr, "%s: lote corrompido em %lu, resto ignorado\n", argv[a], (unsigned long)pos );
+            erros++;
+        }
+        free( dados );
+
+    }
+
+    free( eventos );
+    return erros > 0 ? 1 : 0;
+
+}